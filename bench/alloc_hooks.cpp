@@ -0,0 +1,50 @@
+#include "benchmark.hpp"
+#include <cstdlib>
+#include <new>
+
+// Substitui os operadores globais de alocação para que o harness consiga contar alocações/op.
+// Os contadores são relaxed: só precisamos de totais consistentes entre start() e stop().
+
+std::atomic<uint64_t> bench::AllocationCounters::allocations{0};
+std::atomic<uint64_t> bench::AllocationCounters::bytes{0};
+
+namespace
+{
+
+void* countedAllocate(std::size_t size)
+{
+    bench::AllocationCounters::allocations.fetch_add(1, std::memory_order_relaxed);
+    bench::AllocationCounters::bytes.fetch_add(size, std::memory_order_relaxed);
+
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* countedAlignedAllocate(std::size_t size, std::align_val_t alignment)
+{
+    bench::AllocationCounters::allocations.fetch_add(1, std::memory_order_relaxed);
+    bench::AllocationCounters::bytes.fetch_add(size, std::memory_order_relaxed);
+
+    std::size_t align = static_cast<std::size_t>(alignment);
+    std::size_t rounded = (size + align - 1) / align * align;
+    void* ptr = std::aligned_alloc(align, rounded == 0 ? align : rounded);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return countedAlignedAllocate(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return countedAlignedAllocate(size, alignment); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
@@ -0,0 +1,61 @@
+#include "benchmark.hpp"
+#include "bench_fixtures.hpp"
+#include "messaging/commands/amend_order_command.hpp"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+constexpr uint64_t kBatchSize = 4096;
+constexpr int kPriceLevels = 100;
+
+// Fluxo típico de market maker: cada ordem semeada recebe um amend. 'reprice' move a ordem um tick para
+// fora (perde prioridade, splice para outro nível); caso contrário reduz a quantidade de 10 para 5 no mesmo preço.
+void benchAmend(bench::State& state, bool reprice)
+{
+    bench::EngineFixture fixture;
+    OrderBook& book = fixture.book();
+    std::mt19937_64 rng(11);
+    std::vector<std::unique_ptr<AmendOrderCommand>> amends;
+    amends.reserve(kBatchSize);
+
+    uint64_t done = 0;
+    while (done < state.iterations())
+    {
+        uint64_t batch = std::min<uint64_t>(kBatchSize, state.iterations() - done);
+
+        state.pauseTiming();
+        bench::seedAsks(book, done, batch, kPriceLevels);
+        amends.clear();
+        for (uint64_t i = 0; i < batch; ++i)
+        {
+            double price = 101.0 + static_cast<double>(i % kPriceLevels) * 0.01;
+            amends.push_back(std::make_unique<AmendOrderCommand>(
+                1, 1000000000 + done + i, done + i, "GOOG", OrderSide::Sell,
+                reprice ? 10 : 5, reprice ? price + 0.01 : price, std::chrono::system_clock::now()));
+        }
+        std::shuffle(amends.begin(), amends.end(), rng);
+        state.resumeTiming();
+
+        for (std::unique_ptr<AmendOrderCommand>& amend : amends)
+        {
+            amend->execute(fixture.engine);
+        }
+
+        state.pauseTiming();
+        // Limpa o livro para o próximo lote (as ordens agora respondem pelo ClOrdID do amend)
+        for (uint64_t i = 0; i < batch; ++i) book.removeOrder(1, 1000000000 + done + i);
+        fixture.drainEvents();
+        state.resumeTiming();
+
+        done += batch;
+    }
+}
+
+} // namespace
+
+BENCHMARK("engine/amend_qty_down", [](bench::State& state) { benchAmend(state, false); });
+BENCHMARK("engine/amend_reprice", [](bench::State& state) { benchAmend(state, true); });
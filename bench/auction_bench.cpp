@@ -0,0 +1,100 @@
+#include "benchmark.hpp"
+#include "bench_fixtures.hpp"
+#include "domain/order_book.hpp"
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+constexpr int kAuctionLevels = 200;
+
+// Metade das ordens compra em 100.00..101.99 e metade vende em 99.00..100.98: a faixa cruzada cobre quase
+// todos os níveis e o uncross consome a maior parte das ordens dos dois lados
+std::shared_ptr<Order> makeAuctionOrder(uint64_t i)
+{
+    const bool buy = (i & 1) == 0;
+    const double offset = static_cast<double>((i / 2) % kAuctionLevels) * 0.01;
+    return bench::makeLimitOrder(i + 1, buy ? OrderSide::Buy : OrderSide::Sell, buy ? 100.0 + offset : 99.0 + offset, 10);
+}
+
+void seedAuctionBook(OrderBook& book, uint64_t count)
+{
+    book.setTradingPhase(TradingPhase::Auction);
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        book.addOrder(makeAuctionOrder(i));
+    }
+}
+
+// Preço indicativo: intercalação dos níveis cruzados e as somas de prefixo sobre a grade
+void benchEquilibriumPrice(bench::State& state, uint64_t count)
+{
+    state.pauseTiming();
+    std::unique_ptr<OrderBook> book = std::make_unique<OrderBook>("GOOG");
+    seedAuctionBook(*book, count);
+    state.resumeTiming();
+
+    uint64_t volume = 0;
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        volume += book->computeAuctionPrice().volume;
+    }
+    bench::doNotOptimize(volume);
+
+    // As 100k ordens são destruídas fora da medição
+    state.pauseTiming();
+    book.reset();
+    state.resumeTiming();
+}
+
+// Descruzamento completo no livro: cálculo do preço, casamento das duas frentes e saída dos níveis consumidos
+void benchBookUncross(bench::State& state, uint64_t count)
+{
+    std::vector<AuctionFill> fills;
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        state.pauseTiming();
+        std::unique_ptr<OrderBook> book = std::make_unique<OrderBook>("GOOG");
+        seedAuctionBook(*book, count);
+        fills.clear();
+        state.resumeTiming();
+
+        bench::doNotOptimize(book->uncross(fills).volume);
+
+        state.pauseTiming();
+        fills.clear();
+        book.reset();
+        state.resumeTiming();
+    }
+}
+
+// Leilão inteiro pela engine: o uncross mais um TradeExecutedEvent por execução e o market data do livro
+void benchEngineUncross(bench::State& state, uint64_t count)
+{
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        state.pauseTiming();
+        std::unique_ptr<bench::EngineFixture> fixture = std::make_unique<bench::EngineFixture>();
+        fixture->engine.startAuction("GOOG");
+        for (uint64_t k = 0; k < count; ++k)
+        {
+            fixture->engine.processNewOrderCommand(makeAuctionOrder(k));
+        }
+        fixture->drainEvents();
+        state.resumeTiming();
+
+        fixture->engine.uncrossAuction("GOOG");
+
+        state.pauseTiming();
+        fixture->drainEvents();
+        fixture.reset();
+        state.resumeTiming();
+    }
+}
+
+} // namespace
+
+BENCHMARK("auction/equilibrium_price/100000", [](bench::State& state) { benchEquilibriumPrice(state, 100000); });
+BENCHMARK("auction/book_uncross/100000", [](bench::State& state) { benchBookUncross(state, 100000); });
+BENCHMARK("auction/engine_uncross/100000", [](bench::State& state) { benchEngineUncross(state, 100000); });
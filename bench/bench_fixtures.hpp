@@ -0,0 +1,71 @@
+#ifndef BENCH_FIXTURES_HPP
+#define BENCH_FIXTURES_HPP
+
+#include "domain/engine.hpp"
+#include "domain/event_bus_dispatcher.hpp"
+#include "domain/order.hpp"
+#include "domain/order_book.hpp"
+#include "utils/market_data_channel.hpp"
+#include "utils/thread_safe_queue.hpp"
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace bench
+{
+
+inline std::shared_ptr<Order> makeLimitOrder(uint64_t client_order_id, OrderSide side, double price, uint32_t quantity,
+                                             const std::string& symbol = "GOOG")
+{
+    return std::make_shared<Order>(
+        Order::getNextOrderId(), 1, client_order_id, symbol, price, quantity,
+        side, OrderType::Limit, OrderTimeInForce::GoodTillCancelled, OrderCapacity::Agency,
+        std::chrono::system_clock::now());
+}
+
+// Semeia 'count' ordens de venda de 10 fora do spread (a partir de 101.00), espalhadas por 'levels' níveis
+inline void seedAsks(OrderBook& book, uint64_t first_client_order_id, uint64_t count, int levels = 100)
+{
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        double price = 101.0 + static_cast<double>(i % levels) * 0.01;
+        book.addOrder(makeLimitOrder(first_client_order_id + i, OrderSide::Sell, price, 10));
+    }
+}
+
+// Monta o pipeline mínimo que a Engine precisa (filas + event bus) sem subir threads consumidoras.
+// Os eventos acumulados devem ser descartados com drainEvents() fora da região medida.
+struct EngineFixture
+{
+    ThreadSafeQueue<std::unique_ptr<Command>> command_queue;
+    ThreadSafeQueue<Event> event_queue;
+    MarketDataChannel market_data_channel;
+    ThreadSafeQueue<Event> bbo_queue;
+    EventBusDispatcher event_bus{event_queue, market_data_channel, bbo_queue};
+    Engine engine{command_queue, event_bus};
+
+    EngineFixture()
+    {
+        engine.initialize();
+        engine.setVerbose(false);
+    }
+
+    OrderBook& book(const std::string& symbol = "GOOG") { return *engine.getOrderBooks().at(symbol); }
+
+    void drainEvents()
+    {
+        Event event;
+        while (!event_queue.empty())
+        {
+            event_queue.wait_and_pop(event);
+        }
+        while (!bbo_queue.empty())
+        {
+            bbo_queue.wait_and_pop(event);
+        }
+    }
+};
+
+} // namespace bench
+
+#endif // BENCH_FIXTURES_HPP
@@ -0,0 +1,226 @@
+#include "benchmark.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <streambuf>
+
+namespace bench
+{
+
+State::State(uint64_t iterations)
+    : iterations_(iterations)
+{
+}
+
+void State::start()
+{
+    running_ = true;
+    allocations_at_start_ = AllocationCounters::allocations.load(std::memory_order_relaxed);
+    bytes_at_start_ = AllocationCounters::bytes.load(std::memory_order_relaxed);
+    started_at_ = std::chrono::steady_clock::now();
+}
+
+void State::stop()
+{
+    if (!running_) return;
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    elapsed_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(now - started_at_).count();
+    allocations_ += AllocationCounters::allocations.load(std::memory_order_relaxed) - allocations_at_start_;
+    bytes_ += AllocationCounters::bytes.load(std::memory_order_relaxed) - bytes_at_start_;
+    running_ = false;
+}
+
+void State::pauseTiming() { stop(); }
+void State::resumeTiming() { start(); }
+
+namespace
+{
+
+struct RegisteredBenchmark
+{
+    std::string name;
+    BenchmarkFunction function;
+};
+
+std::vector<RegisteredBenchmark>& registry()
+{
+    static std::vector<RegisteredBenchmark> benchmarks;
+    return benchmarks;
+}
+
+// Descarta tudo que o código do domínio escreve em std::cout/std::cerr durante as medições
+class NullBuffer : public std::streambuf
+{
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+struct Options
+{
+    std::string filter;
+    std::string output_path = "build/bench/results.json";
+    double min_time_seconds = 0.2;
+    bool list_only = false;
+};
+
+Options parseOptions(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--filter=", 0) == 0) options.filter = arg.substr(9);
+        else if (arg.rfind("--out=", 0) == 0) options.output_path = arg.substr(6);
+        else if (arg.rfind("--min-time=", 0) == 0) options.min_time_seconds = std::stod(arg.substr(11));
+        else if (arg == "--list") options.list_only = true;
+        else std::cerr << "Ignoring unknown option: " << arg << '\n';
+    }
+    return options;
+}
+
+BenchmarkResult runBenchmark(const RegisteredBenchmark& benchmark, double min_time_seconds)
+{
+    const uint64_t min_time_ns = static_cast<uint64_t>(min_time_seconds * 1e9);
+    uint64_t iterations = 1;
+
+    while (true)
+    {
+        State state(iterations);
+        state.start();
+        benchmark.function(state);
+        state.stop();
+
+        uint64_t elapsed = std::max<uint64_t>(state.getElapsedNanoseconds(), 1);
+        if (elapsed >= min_time_ns || iterations >= (1ULL << 32))
+        {
+            uint64_t ops = iterations * state.getOpsPerIteration();
+            BenchmarkResult result;
+            result.name = benchmark.name;
+            result.iterations = iterations;
+            result.ops = ops;
+            result.ns_per_op = static_cast<double>(elapsed) / ops;
+            result.ops_per_sec = ops * 1e9 / elapsed;
+            result.allocs_per_op = static_cast<double>(state.getAllocations()) / ops;
+            result.bytes_per_op = static_cast<double>(state.getAllocatedBytes()) / ops;
+            return result;
+        }
+
+        // Estima quantas iterações são necessárias para atingir o tempo mínimo, com folga de 40%
+        double scale = (min_time_ns * 1.4) / elapsed;
+        uint64_t next = static_cast<uint64_t>(iterations * std::min(scale, 100.0));
+        iterations = std::max(next, iterations + 1);
+    }
+}
+
+void writeJson(const std::string& path, const std::vector<BenchmarkResult>& results)
+{
+    std::filesystem::path file_path(path);
+    if (!file_path.parent_path().empty())
+    {
+        std::filesystem::create_directories(file_path.parent_path());
+    }
+
+    std::ofstream out(path, std::ios::out | std::ios::trunc);
+    if (!out.is_open())
+    {
+        std::cerr << "Failed to open benchmark output file: " << path << '\n';
+        return;
+    }
+
+    out << "{\n";
+    out << "  \"context\": {\n";
+    out << "    \"compiler\": \"" << __VERSION__ << "\",\n";
+#ifdef BENCH_BUILD_FLAGS
+    out << "    \"build_flags\": \"" << BENCH_BUILD_FLAGS << "\",\n";
+#endif
+    out << "    \"timestamp\": " << std::chrono::duration_cast<std::chrono::seconds>(
+                                        std::chrono::system_clock::now().time_since_epoch()).count() << "\n";
+    out << "  },\n";
+    out << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchmarkResult& r = results[i];
+        out << "    { \"name\": \"" << r.name << "\""
+            << ", \"iterations\": " << r.iterations
+            << ", \"ops\": " << r.ops
+            << std::fixed << std::setprecision(3)
+            << ", \"ns_per_op\": " << r.ns_per_op
+            << ", \"ops_per_sec\": " << r.ops_per_sec
+            << ", \"allocs_per_op\": " << r.allocs_per_op
+            << ", \"bytes_per_op\": " << r.bytes_per_op << " }";
+        if (i + 1 < results.size()) out << ",";
+        out << "\n";
+        out.unsetf(std::ios::fixed);
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+} // namespace
+
+bool registerBenchmark(const std::string& name, BenchmarkFunction function)
+{
+    registry().push_back({name, std::move(function)});
+    return true;
+}
+
+} // namespace bench
+
+int main(int argc, char** argv)
+{
+    bench::Options options = bench::parseOptions(argc, argv);
+
+    std::vector<bench::RegisteredBenchmark> selected;
+    for (const bench::RegisteredBenchmark& benchmark : bench::registry())
+    {
+        if (options.filter.empty() || benchmark.name.find(options.filter) != std::string::npos)
+        {
+            selected.push_back(benchmark);
+        }
+    }
+    std::sort(selected.begin(), selected.end(), [](const auto& a, const auto& b) { return a.name < b.name; });
+
+    if (options.list_only)
+    {
+        for (const bench::RegisteredBenchmark& benchmark : selected) std::cout << benchmark.name << '\n';
+        return 0;
+    }
+
+    // O relatório sai pelo buffer original do stdout; o resto do sistema escreve no NullBuffer
+    bench::NullBuffer null_buffer;
+    std::ostream report(std::cout.rdbuf());
+    std::streambuf* original_cout = std::cout.rdbuf(&null_buffer);
+    std::streambuf* original_cerr = std::cerr.rdbuf(&null_buffer);
+
+    report << std::left << std::setw(44) << "Benchmark"
+           << std::right << std::setw(14) << "ns/op"
+           << std::setw(16) << "ops/sec"
+           << std::setw(12) << "allocs/op"
+           << std::setw(12) << "bytes/op" << '\n';
+    report << std::string(98, '-') << '\n';
+
+    std::vector<bench::BenchmarkResult> results;
+    for (const bench::RegisteredBenchmark& benchmark : selected)
+    {
+        bench::BenchmarkResult result = bench::runBenchmark(benchmark, options.min_time_seconds);
+        report << std::left << std::setw(44) << result.name
+               << std::right << std::fixed << std::setprecision(1)
+               << std::setw(14) << result.ns_per_op
+               << std::setw(16) << std::setprecision(0) << result.ops_per_sec
+               << std::setw(12) << std::setprecision(2) << result.allocs_per_op
+               << std::setw(12) << std::setprecision(1) << result.bytes_per_op << std::endl;
+        results.push_back(result);
+    }
+
+    std::cout.rdbuf(original_cout);
+    std::cerr.rdbuf(original_cerr);
+
+    bench::writeJson(options.output_path, results);
+    report << "\nResults written to " << options.output_path << '\n';
+    return 0;
+}
@@ -0,0 +1,89 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Harness minimalista de micro-benchmarks, sem dependências externas.
+// Cada benchmark recebe um State e executa state.iterations() operações; o runner
+// calibra o número de iterações até atingir o tempo mínimo e reporta ns/op, ops/s e alocações/op.
+
+namespace bench
+{
+
+// Contadores globais de alocação, alimentados pelos operator new/delete de alloc_hooks.cpp
+struct AllocationCounters
+{
+    static std::atomic<uint64_t> allocations;
+    static std::atomic<uint64_t> bytes;
+};
+
+class State
+{
+public:
+    explicit State(uint64_t iterations);
+
+    uint64_t iterations() const { return iterations_; }
+
+    // Permite excluir setup/teardown da medição (tempo e alocações)
+    void pauseTiming();
+    void resumeTiming();
+
+    // Quantas operações lógicas cada iteração representa (ex: um sweep que consome N ordens)
+    void setOpsPerIteration(uint64_t ops) { ops_per_iteration_ = ops; }
+
+    void start();
+    void stop();
+
+    uint64_t getElapsedNanoseconds() const { return elapsed_ns_; }
+    uint64_t getAllocations() const { return allocations_; }
+    uint64_t getAllocatedBytes() const { return bytes_; }
+    uint64_t getOpsPerIteration() const { return ops_per_iteration_; }
+
+private:
+    uint64_t iterations_;
+    uint64_t ops_per_iteration_ = 1;
+    bool running_ = false;
+    std::chrono::steady_clock::time_point started_at_;
+    uint64_t allocations_at_start_ = 0;
+    uint64_t bytes_at_start_ = 0;
+    uint64_t elapsed_ns_ = 0;
+    uint64_t allocations_ = 0;
+    uint64_t bytes_ = 0;
+};
+
+using BenchmarkFunction = std::function<void(State&)>;
+
+struct BenchmarkResult
+{
+    std::string name;
+    uint64_t iterations;
+    uint64_t ops;
+    double ns_per_op;
+    double ops_per_sec;
+    double allocs_per_op;
+    double bytes_per_op;
+};
+
+// Registro estático: cada arquivo de benchmark registra seus casos na inicialização
+bool registerBenchmark(const std::string& name, BenchmarkFunction function);
+
+// Impede que o compilador elimine um valor calculado pelo benchmark
+template<typename T>
+inline void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace bench
+
+#define BENCH_CONCAT_IMPL(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_IMPL(a, b)
+#define BENCHMARK(name, function) \
+    static const bool BENCH_CONCAT(bench_registered_, __LINE__) = ::bench::registerBenchmark(name, function)
+
+#endif // BENCHMARK_HPP
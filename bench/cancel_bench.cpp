@@ -0,0 +1,111 @@
+#include "benchmark.hpp"
+#include "bench_fixtures.hpp"
+#include "messaging/commands/cancel_order_command.hpp"
+#include "messaging/commands/new_order_command.hpp"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+constexpr uint64_t kBatchSize = 4096;
+constexpr int kPriceLevels = 100;
+using bench::seedAsks;
+
+std::unique_ptr<CancelOrderCommand> makeCancel(uint64_t cancel_id, uint64_t orig_client_order_id)
+{
+    return std::make_unique<CancelOrderCommand>(1, cancel_id, orig_client_order_id, "GOOG", OrderSide::Sell,
+                                                std::chrono::system_clock::now());
+}
+
+// Cancelamentos em ordem aleatória num livro com 4096 ordens por lote, passando pelo Command completo
+void benchCancelCommand(bench::State& state)
+{
+    bench::EngineFixture fixture;
+    OrderBook& book = fixture.book();
+    std::mt19937_64 rng(42);
+    std::vector<std::unique_ptr<CancelOrderCommand>> cancels;
+    cancels.reserve(kBatchSize);
+
+    uint64_t done = 0;
+    while (done < state.iterations())
+    {
+        uint64_t batch = std::min<uint64_t>(kBatchSize, state.iterations() - done);
+
+        state.pauseTiming();
+        seedAsks(book, done, batch);
+        cancels.clear();
+        for (uint64_t i = 0; i < batch; ++i) cancels.push_back(makeCancel(1000000000 + done + i, done + i));
+        std::shuffle(cancels.begin(), cancels.end(), rng);
+        state.resumeTiming();
+
+        for (std::unique_ptr<CancelOrderCommand>& cancel : cancels)
+        {
+            cancel->execute(fixture.engine);
+        }
+
+        state.pauseTiming();
+        fixture.drainEvents();
+        state.resumeTiming();
+
+        done += batch;
+    }
+}
+
+// Fluxo com 90% de cancels: cada iteração executa 1 nova ordem passiva e 9 cancels de ordens já no livro
+void benchCancelHeavyFlow(bench::State& state)
+{
+    bench::EngineFixture fixture;
+    OrderBook& book = fixture.book();
+    std::mt19937_64 rng(7);
+    std::vector<std::unique_ptr<Command>> commands;
+    commands.reserve(kBatchSize * 10);
+    state.setOpsPerIteration(10);
+
+    uint64_t next_id = 0;
+    uint64_t done = 0;
+    while (done < state.iterations())
+    {
+        uint64_t batch = std::min<uint64_t>(kBatchSize, state.iterations() - done);
+
+        state.pauseTiming();
+        uint64_t seeded_from = next_id;
+        seedAsks(book, seeded_from, batch * 9);
+        next_id += batch * 9;
+
+        std::vector<uint64_t> targets(batch * 9);
+        for (uint64_t i = 0; i < targets.size(); ++i) targets[i] = seeded_from + i;
+        std::shuffle(targets.begin(), targets.end(), rng);
+
+        commands.clear();
+        for (uint64_t i = 0; i < batch; ++i)
+        {
+            commands.push_back(std::make_unique<NewOrderCommand>(
+                next_id++, 1, "GOOG", OrderSide::Buy, OrderType::Limit, 10, 99.0 + static_cast<double>(i % kPriceLevels) * 0.01,
+                OrderTimeInForce::GoodTillCancelled, OrderCapacity::Agency, std::chrono::system_clock::now()));
+            for (uint64_t c = 0; c < 9; ++c)
+            {
+                commands.push_back(makeCancel(2000000000 + i * 9 + c, targets[i * 9 + c]));
+            }
+        }
+        state.resumeTiming();
+
+        for (std::unique_ptr<Command>& command : commands)
+        {
+            command->execute(fixture.engine);
+        }
+
+        state.pauseTiming();
+        fixture.drainEvents();
+        state.resumeTiming();
+
+        done += batch;
+    }
+}
+
+} // namespace
+
+BENCHMARK("engine/cancel_command", benchCancelCommand);
+BENCHMARK("engine/cancel_heavy_flow", benchCancelHeavyFlow);
@@ -0,0 +1,85 @@
+#include "benchmark.hpp"
+#include "bench_fixtures.hpp"
+#include "domain/order_book.hpp"
+#include <atomic>
+#include <thread>
+
+namespace
+{
+
+// Livro com 100 níveis de venda e 100 de compra; a visão publicada leva os 5 melhores de cada lado
+void seedBook(OrderBook& book)
+{
+    bench::seedAsks(book, 1, 1000);
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        double price = 100.0 - static_cast<double>(i % 100) * 0.01;
+        book.addOrder(bench::makeLimitOrder(10000 + i, OrderSide::Buy, price, 10));
+    }
+}
+
+// Custo que a engine paga por atualização do livro: montar o top-5 e publicá-lo no seqlock
+void benchPublish(bench::State& state)
+{
+    state.pauseTiming();
+    OrderBook book("GOOG");
+    seedBook(book);
+    state.resumeTiming();
+
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        book.publishDepthView(5);
+    }
+    bench::doNotOptimize(book.readDepthView().version);
+}
+
+// Leitura sem escritor concorrente: o caso comum de um dashboard ou do risco consultando a profundidade
+void benchRead(bench::State& state)
+{
+    state.pauseTiming();
+    OrderBook book("GOOG");
+    seedBook(book);
+    book.publishDepthView(5);
+    state.resumeTiming();
+
+    uint64_t quantity = 0;
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        BookDepthView view = book.readDepthView();
+        quantity += view.bids[0].quantity;
+    }
+    bench::doNotOptimize(quantity);
+}
+
+// Leitura com uma thread publicando sem parar, como a engine sob carga: mede as repetições do leitor
+// quando ele cruza com uma escrita. O escritor nunca espera pelo leitor.
+void benchReadWhilePublishing(bench::State& state)
+{
+    state.pauseTiming();
+    OrderBook book("GOOG");
+    seedBook(book);
+    book.publishDepthView(5);
+    std::atomic<bool> stop{false};
+    std::thread writer([&book, &stop]() {
+        while (!stop.load(std::memory_order_relaxed)) book.publishDepthView(5);
+    });
+    state.resumeTiming();
+
+    uint64_t versions = 0;
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        versions += book.readDepthView().version;
+    }
+
+    state.pauseTiming();
+    stop.store(true, std::memory_order_relaxed);
+    writer.join();
+    state.resumeTiming();
+    bench::doNotOptimize(versions);
+}
+
+} // namespace
+
+BENCHMARK("depth_view/publish", benchPublish);
+BENCHMARK("depth_view/read", benchRead);
+BENCHMARK("depth_view/read_while_publishing", benchReadWhilePublishing);
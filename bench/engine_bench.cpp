@@ -0,0 +1,70 @@
+#include "benchmark.hpp"
+#include "bench_fixtures.hpp"
+#include <memory>
+
+namespace
+{
+
+// Um agressor de compra varre 'depth' níveis de venda, uma ordem de 10 por nível.
+// Cada iteração mede um sweep completo; o setup do livro e o descarte dos eventos ficam fora da medição.
+void benchSweep(bench::State& state, int depth)
+{
+    bench::EngineFixture fixture;
+    OrderBook& book = fixture.book();
+
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        state.pauseTiming();
+        for (int level = 0; level < depth; ++level)
+        {
+            book.addOrder(bench::makeLimitOrder(i * depth + level, OrderSide::Sell, 100.0 + level * 0.01, 10));
+        }
+        std::shared_ptr<Order> aggressor = bench::makeLimitOrder(i, OrderSide::Buy, 100.0 + depth * 0.01, 10 * depth);
+        state.resumeTiming();
+
+        fixture.engine.tryMatchOrderWithTopOfBook(aggressor, book);
+
+        state.pauseTiming();
+        fixture.drainEvents();
+        state.resumeTiming();
+    }
+}
+
+// Comando completo (aceite + sweep + cancel do resto + snapshot) de uma ordem a mercado que consome
+// 'depth' níveis com 'orders_per_level' ordens cada, além de 10 lotes a mais que não encontram liquidez
+void benchMarketSweep(bench::State& state, int depth, int orders_per_level)
+{
+    bench::EngineFixture fixture;
+    OrderBook& book = fixture.book();
+    uint64_t next_id = 1;
+
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        state.pauseTiming();
+        for (int level = 0; level < depth; ++level)
+        {
+            for (int k = 0; k < orders_per_level; ++k)
+            {
+                book.addOrder(bench::makeLimitOrder(next_id++, OrderSide::Sell, 100.0 + level * 0.01, 10));
+            }
+        }
+        std::shared_ptr<Order> aggressor = std::make_shared<Order>(
+            Order::getNextOrderId(), 2, next_id++, "GOOG", 0.0, 10 * depth * orders_per_level + 10,
+            OrderSide::Buy, OrderType::Market, OrderTimeInForce::ImmediateOrCancel, OrderCapacity::Agency,
+            std::chrono::system_clock::now());
+        state.resumeTiming();
+
+        fixture.engine.processNewOrderCommand(aggressor);
+
+        state.pauseTiming();
+        fixture.drainEvents();
+        state.resumeTiming();
+    }
+}
+
+} // namespace
+
+BENCHMARK("engine/sweep/depth_1", [](bench::State& state) { benchSweep(state, 1); });
+BENCHMARK("engine/sweep/depth_10", [](bench::State& state) { benchSweep(state, 10); });
+BENCHMARK("engine/sweep/depth_100", [](bench::State& state) { benchSweep(state, 100); });
+BENCHMARK("engine/market_sweep/depth_10x4", [](bench::State& state) { benchMarketSweep(state, 10, 4); });
@@ -0,0 +1,74 @@
+#include "benchmark.hpp"
+#include "bench_fixtures.hpp"
+#include "domain/auditor.hpp"
+#include "domain/market_data_gateway.hpp"
+#include "domain/trade.hpp"
+#include "messaging/events/book_snapshot_event.hpp"
+#include "messaging/events/order_accepted_event.hpp"
+#include "messaging/events/trade_executed_event.hpp"
+#include <memory>
+
+namespace
+{
+
+void benchFormatOrderAccepted(bench::State& state)
+{
+    state.pauseTiming();
+    ThreadSafeQueue<Event> queue;
+    Auditor auditor(queue, "build/bench/auditor_log.log");
+    std::shared_ptr<Order> order = bench::makeLimitOrder(1, OrderSide::Buy, 100.0, 10);
+    const Event event = OrderAcceptedEvent(*order, SymbolTable::intern("GOOG"), std::chrono::system_clock::now());
+    state.resumeTiming();
+
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        std::string line = auditor.formatEventLog(event);
+        bench::doNotOptimize(line);
+    }
+}
+
+void benchFormatTradeExecuted(bench::State& state)
+{
+    state.pauseTiming();
+    ThreadSafeQueue<Event> queue;
+    Auditor auditor(queue, "build/bench/auditor_log.log");
+    std::shared_ptr<Order> buy = bench::makeLimitOrder(1, OrderSide::Buy, 100.0, 10);
+    std::shared_ptr<Order> sell = bench::makeLimitOrder(2, OrderSide::Sell, 100.0, 10);
+    Trade trade(1, buy->getOrderId(), sell->getOrderId(), "GOOG", 100.0, 10, std::chrono::system_clock::now());
+    const Event event = TradeExecutedEvent(trade, SymbolTable::intern("GOOG"), *buy, *sell);
+    state.resumeTiming();
+
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        std::string line = auditor.formatEventLog(event);
+        bench::doNotOptimize(line);
+    }
+}
+
+// Cria a "foto" de 5 níveis e a serializa em JSON, como acontece a cada mudança no livro
+void benchSnapshotToJson(bench::State& state)
+{
+    state.pauseTiming();
+    MarketDataChannel channel;
+    MarketDataGateway gateway(channel, "build/bench/market_data.log");
+    OrderBook book("GOOG");
+    for (uint64_t i = 0; i < 20; ++i)
+    {
+        book.addOrder(bench::makeLimitOrder(i, OrderSide::Buy, 100.0 - i * 0.01, 10));
+        book.addOrder(bench::makeLimitOrder(100 + i, OrderSide::Sell, 100.5 + i * 0.01, 10));
+    }
+    state.resumeTiming();
+
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        const Event snapshot = BookSnapshotEvent(book, std::chrono::system_clock::now());
+        std::string json = gateway.formatSnapshotToJSON(snapshot);
+        bench::doNotOptimize(json);
+    }
+}
+
+} // namespace
+
+BENCHMARK("events/format_order_accepted", benchFormatOrderAccepted);
+BENCHMARK("events/format_trade_executed", benchFormatTradeExecuted);
+BENCHMARK("events/snapshot_to_json", benchSnapshotToJson);
@@ -0,0 +1,63 @@
+#include "benchmark.hpp"
+#include "bench_fixtures.hpp"
+#include "domain/execution_report_gateway.hpp"
+#include "domain/trade.hpp"
+#include "messaging/events/order_accepted_event.hpp"
+#include "messaging/events/trade_executed_event.hpp"
+#include <vector>
+
+namespace
+{
+
+// Um trade vira dois 35=8 (agressor e passivo), extraídos do evento e escritos num buffer fixo
+void benchRenderFill(bench::State& state)
+{
+    state.pauseTiming();
+    ThreadSafeQueue<Event> queue;
+    ExecutionReportGateway gateway(queue);
+    std::shared_ptr<Order> buy = bench::makeLimitOrder(1, OrderSide::Buy, 100.0, 10);
+    std::shared_ptr<Order> sell = bench::makeLimitOrder(2, OrderSide::Sell, 100.0, 10);
+    Trade trade(1, buy->getOrderId(), sell->getOrderId(), "GOOG", 100.0, 10, std::chrono::system_clock::now());
+    const Event event = TradeExecutedEvent(trade, SymbolTable::intern("GOOG"), *buy, *sell);
+    std::vector<ExecutionReport> reports;
+    char buffer[512];
+    state.resumeTiming();
+
+    size_t bytes = 0;
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        reports.clear();
+        ExecutionReportGateway::collectReports(event, reports);
+        for (const ExecutionReport& report : reports)
+        {
+            bytes += gateway.renderReport(report, i + 1, i + 1, buffer, sizeof(buffer)).size();
+        }
+    }
+    bench::doNotOptimize(bytes);
+}
+
+void benchRenderAck(bench::State& state)
+{
+    state.pauseTiming();
+    ThreadSafeQueue<Event> queue;
+    ExecutionReportGateway gateway(queue);
+    std::shared_ptr<Order> order = bench::makeLimitOrder(1, OrderSide::Buy, 100.25, 10);
+    const Event event = OrderAcceptedEvent(*order, SymbolTable::intern("GOOG"), std::chrono::system_clock::now());
+    std::vector<ExecutionReport> reports;
+    char buffer[512];
+    state.resumeTiming();
+
+    size_t bytes = 0;
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        reports.clear();
+        ExecutionReportGateway::collectReports(event, reports);
+        bytes += gateway.renderReport(reports.front(), i + 1, i + 1, buffer, sizeof(buffer)).size();
+    }
+    bench::doNotOptimize(bytes);
+}
+
+} // namespace
+
+BENCHMARK("exec_reports/render_ack", benchRenderAck);
+BENCHMARK("exec_reports/render_fill", benchRenderFill);
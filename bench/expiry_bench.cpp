@@ -0,0 +1,69 @@
+#include "benchmark.hpp"
+#include "bench_fixtures.hpp"
+#include "domain/execution_report_gateway.hpp"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// Fechamento de sessão com 'count' ordens Day descansando em 100 níveis de venda: mede o lote inteiro
+// (disparo da wheel, remoção das ordens, os OrdersExpiredEvents e um snapshot) e reporta o custo por ordem.
+// Com consume_reports, a medição inclui o lado do consumidor: retirar os eventos da fila em lotes, como as
+// threads do Auditor e dos reports, e extrair um execution report (ExecType=Expired) por ordem.
+void benchSessionClose(bench::State& state, uint64_t count, bool consume_reports)
+{
+    bench::EngineFixture fixture;
+    const std::chrono::system_clock::time_point close = std::chrono::system_clock::now() + std::chrono::hours(1);
+    fixture.engine.setSessionClose(close);
+    state.setOpsPerIteration(count);
+
+    std::chrono::system_clock::time_point now = close;
+    uint64_t next_id = 1;
+    std::vector<Event> batch;
+    std::vector<ExecutionReport> reports;
+    uint64_t expired_reports = 0;
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        state.pauseTiming();
+        fixture.engine.setSessionClose(now);
+        for (uint64_t k = 0; k < count; ++k)
+        {
+            std::shared_ptr<Order> order = std::make_shared<Order>(
+                Order::getNextOrderId(), 1, next_id++, "GOOG", 101.0 + static_cast<double>(k % 100) * 0.01, 10,
+                OrderSide::Sell, OrderType::Limit, OrderTimeInForce::Day, OrderCapacity::Agency,
+                std::chrono::system_clock::now());
+            fixture.engine.processNewOrderCommand(order);
+        }
+        fixture.drainEvents();
+        state.resumeTiming();
+
+        fixture.engine.advanceTimers(now);
+        if (consume_reports)
+        {
+            while (!fixture.event_queue.empty())
+            {
+                batch.clear();
+                fixture.event_queue.drain_into(batch, 256);
+                for (const Event& event : batch)
+                {
+                    reports.clear();
+                    ExecutionReportGateway::collectReports(event, reports);
+                    expired_reports += reports.size();
+                }
+            }
+        }
+
+        state.pauseTiming();
+        fixture.drainEvents();
+        now += std::chrono::hours(24);
+        state.resumeTiming();
+    }
+    bench::doNotOptimize(expired_reports);
+}
+
+} // namespace
+
+BENCHMARK("engine/session_close_expiry/10000", [](bench::State& state) { benchSessionClose(state, 10000, false); });
+BENCHMARK("engine/session_close_expiry_reports/10000", [](bench::State& state) { benchSessionClose(state, 10000, true); });
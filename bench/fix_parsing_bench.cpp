@@ -0,0 +1,52 @@
+#include "benchmark.hpp"
+#include "domain/inbound_gateway.hpp"
+#include "messaging/commands/command.hpp"
+#include "utils/fix_generator.hpp"
+#include "utils/thread_safe_queue.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+std::vector<std::string> makeMessages(size_t count)
+{
+    std::vector<std::string> messages;
+    messages.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        messages.push_back(FixGenerator::generateFIXMessageForThread().first);
+    }
+    return messages;
+}
+
+void benchParseNewOrder(bench::State& state)
+{
+    state.pauseTiming();
+    ThreadSafeQueue<std::unique_ptr<Command>> queue;
+    InboundGateway gateway(queue, "build/bench/write_ahead_log.log");
+    std::vector<std::string> messages = makeMessages(1024);
+    std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+    state.resumeTiming();
+
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        std::unique_ptr<Command> command = gateway.parseAndCreateCommand(messages[i % messages.size()], "1", now);
+        bench::doNotOptimize(command);
+    }
+}
+
+void benchGenerateNewOrder(bench::State& state)
+{
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        auto message = FixGenerator::generateFIXMessageForThread();
+        bench::doNotOptimize(message.first);
+    }
+}
+
+} // namespace
+
+BENCHMARK("fix/parse_new_order", benchParseNewOrder);
+BENCHMARK("fix/generate_new_order", benchGenerateNewOrder);
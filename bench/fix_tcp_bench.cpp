@@ -0,0 +1,138 @@
+#include "benchmark.hpp"
+#include "domain/fix_tcp_acceptor.hpp"
+#include "domain/inbound_gateway.hpp"
+#include "messaging/commands/command.hpp"
+#include "utils/thread_safe_queue.hpp"
+#include <arpa/inet.h>
+#include <cstdio>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+
+// Fluxo de uma sessão: new orders limitadas com MsgSeqNum a partir de 1, já concatenadas como chegariam pelo socket
+std::string makeSessionStream(uint64_t count)
+{
+    std::string stream;
+    stream.reserve(count * 128);
+    char body[160];
+    for (uint64_t seq = 1; seq <= count; ++seq)
+    {
+        int length = std::snprintf(body, sizeof(body), "8=FIX.4.2|49=CLIENT|56=SERVER|34=%llu|35=D|11=%llu|55=GOOG|54=%d|38=10|44=%.2f|40=2|59=1|47=A|",
+                                   static_cast<unsigned long long>(seq), static_cast<unsigned long long>(seq), seq % 2 ? 1 : 2,
+                                   seq % 2 ? 9.50 : 10.50);
+        unsigned int sum = 0;
+        for (int i = 0; i < length; ++i) sum += static_cast<unsigned char>(body[i]);
+        char trailer[16];
+        std::snprintf(trailer, sizeof(trailer), "10=%03u|", sum % 256);
+        stream.append(body, static_cast<size_t>(length));
+        stream.append(trailer);
+    }
+    return stream;
+}
+
+int connectLoopback(uint16_t port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+// Cada operação é uma mensagem que sai do socket do cliente e chega como comando na fila da engine:
+// framing, checagem de sequência/checksum, parse e push, tudo nas threads de I/O do acceptor
+void benchTcpLoopback(bench::State& state, int sessions, int io_threads)
+{
+    state.pauseTiming();
+    ThreadSafeQueue<std::unique_ptr<Command>> queue;
+    InboundGateway gateway(queue, "build/bench/write_ahead_log.log");
+    FixAcceptorOptions options;
+    options.io_threads = io_threads;
+    FixTcpAcceptor acceptor(gateway, options);
+    acceptor.start();
+
+    const uint64_t total = state.iterations();
+    std::vector<std::string> streams;
+    std::vector<int> sockets;
+    for (int s = 0; s < sessions; ++s)
+    {
+        streams.push_back(makeSessionStream(total / sessions + (static_cast<uint64_t>(s) < total % sessions ? 1 : 0)));
+        sockets.push_back(connectLoopback(acceptor.getPort()));
+    }
+    state.resumeTiming();
+
+    std::vector<std::thread> clients;
+    for (int s = 0; s < sessions; ++s)
+    {
+        clients.emplace_back([&streams, &sockets, s]() {
+            // Escreve em pedaços de ~4 KB, como um cliente com várias ordens por syscall
+            const std::string& stream = streams[s];
+            size_t sent = 0;
+            while (sent < stream.size())
+            {
+                ssize_t written = send(sockets[s], stream.data() + sent, std::min<size_t>(4096, stream.size() - sent), 0);
+                if (written <= 0) break;
+                sent += static_cast<size_t>(written);
+            }
+        });
+    }
+
+    std::unique_ptr<Command> command;
+    for (uint64_t i = 0; i < total; ++i)
+    {
+        queue.wait_and_pop(command);
+    }
+    bench::doNotOptimize(command);
+
+    state.pauseTiming();
+    for (std::thread& client : clients)
+    {
+        client.join();
+    }
+    for (int fd : sockets)
+    {
+        close(fd);
+    }
+    acceptor.stop();
+    state.resumeTiming();
+}
+
+void benchFrameMessage(bench::State& state)
+{
+    state.pauseTiming();
+    std::string stream = makeSessionStream(1024);
+    state.resumeTiming();
+
+    size_t offset = 0;
+    size_t frames = 0;
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        size_t skipped = 0;
+        size_t length = FixTcpAcceptor::frameMessage(std::string_view(stream).substr(offset), skipped);
+        offset = length == 0 ? 0 : offset + skipped + length;
+        if (offset >= stream.size()) offset = 0;
+        frames += length;
+    }
+    bench::doNotOptimize(frames);
+}
+
+} // namespace
+
+BENCHMARK("fix/frame_message", benchFrameMessage);
+BENCHMARK("fix/tcp_loopback/1_session", [](bench::State& state) { benchTcpLoopback(state, 1, 1); });
+BENCHMARK("fix/tcp_loopback/4_sessions_2_io_threads", [](bench::State& state) { benchTcpLoopback(state, 4, 2); });
@@ -0,0 +1,76 @@
+#include "benchmark.hpp"
+#include "utils/id_generator.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+void benchGeneratorNext(bench::State& state)
+{
+    IdBlockAllocator allocator;
+    IdGenerator generator(allocator, 3);
+    uint64_t id = 0;
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        id = generator.next();
+        bench::doNotOptimize(id);
+    }
+}
+
+// 'threads' geradores, um shard cada, emitindo ao mesmo tempo: só a reserva de blocos é compartilhada
+void benchGeneratorThreads(bench::State& state, int threads)
+{
+    IdBlockAllocator allocator;
+    const uint64_t per_thread = state.iterations() / threads + 1;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&allocator, per_thread, t]() {
+            IdGenerator generator(allocator, static_cast<uint32_t>(t));
+            uint64_t id = 0;
+            for (uint64_t i = 0; i < per_thread; ++i)
+            {
+                id = generator.next();
+                bench::doNotOptimize(id);
+            }
+        });
+    }
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+// Referência: o mesmo padrão com um único contador atômico compartilhado entre as threads
+void benchSharedAtomicThreads(bench::State& state, int threads)
+{
+    std::atomic<uint64_t> counter{1};
+    const uint64_t per_thread = state.iterations() / threads + 1;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&counter, per_thread]() {
+            uint64_t id = 0;
+            for (uint64_t i = 0; i < per_thread; ++i)
+            {
+                id = counter.fetch_add(1, std::memory_order_relaxed);
+                bench::doNotOptimize(id);
+            }
+        });
+    }
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+} // namespace
+
+BENCHMARK("ids/generator_next", benchGeneratorNext);
+BENCHMARK("ids/generator_4_threads", [](bench::State& state) { benchGeneratorThreads(state, 4); });
+BENCHMARK("ids/shared_atomic_4_threads", [](bench::State& state) { benchSharedAtomicThreads(state, 4); });
@@ -0,0 +1,92 @@
+#include "benchmark.hpp"
+#include "bench_fixtures.hpp"
+#include "client/market_data_subscriber.hpp"
+#include "domain/multicast_market_data_publisher.hpp"
+#include "messaging/events/book_snapshot_event.hpp"
+
+namespace
+{
+
+// Portas próprias para não receber o feed de uma engine rodando no mesmo host
+MulticastFeedOptions benchFeedOptions()
+{
+    MulticastFeedOptions options;
+    options.port = 31101;
+    options.snapshot_port = 31102;
+    return options;
+}
+
+// Dois estados do livro que diferem no melhor bid: publicar um depois do outro gera duas atualizações de nível
+struct AlternatingSnapshots
+{
+    std::unique_ptr<BookSnapshotEvent> first;
+    std::unique_ptr<BookSnapshotEvent> second;
+
+    AlternatingSnapshots()
+    {
+        OrderBook book("GOOG");
+        for (uint64_t i = 0; i < 5; ++i)
+        {
+            book.addOrder(bench::makeLimitOrder(i, OrderSide::Buy, 99.99 - i * 0.01, 10));
+            book.addOrder(bench::makeLimitOrder(100 + i, OrderSide::Sell, 100.01 + i * 0.01, 10));
+        }
+        first = std::make_unique<BookSnapshotEvent>(book, std::chrono::system_clock::now());
+        book.addOrder(bench::makeLimitOrder(200, OrderSide::Buy, 100.00, 10));
+        second = std::make_unique<BookSnapshotEvent>(book, std::chrono::system_clock::now());
+    }
+
+    const BookSnapshotEvent& at(uint64_t i) const { return i % 2 ? *second : *first; }
+};
+
+// Custo do lado da engine de market data: diff contra o último top-N e um datagrama a cada 8 snapshots
+void benchPublishDiff(bench::State& state)
+{
+    state.pauseTiming();
+    AlternatingSnapshots snapshots;
+    MulticastMarketDataPublisher publisher(benchFeedOptions());
+    publisher.open();
+    state.resumeTiming();
+
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        publisher.publish(snapshots.at(i));
+        if ((i & 7) == 7) publisher.flush();
+    }
+    publisher.flush();
+    bench::doNotOptimize(publisher);
+}
+
+// Ida completa de uma mudança no livro: diff, datagrama pelo loopback e aplicação no livro do assinante
+void benchMulticastLoopback(bench::State& state)
+{
+    state.pauseTiming();
+    AlternatingSnapshots snapshots;
+    MulticastMarketDataPublisher publisher(benchFeedOptions());
+    MarketDataSubscriber subscriber(benchFeedOptions());
+    bool ready = publisher.open() && subscriber.open();
+    if (ready)
+    {
+        // O assinante começa fora de sincronia e entra pelo canal de snapshot
+        publisher.publish(snapshots.at(0));
+        publisher.publishSnapshots();
+        for (int attempt = 0; attempt < 100 && !subscriber.isSynchronized(); ++attempt) subscriber.poll(10);
+        ready = subscriber.isSynchronized();
+    }
+    state.resumeTiming();
+
+    for (uint64_t i = 1; ready && i <= state.iterations(); ++i)
+    {
+        publisher.publish(snapshots.at(i));
+        publisher.flush();
+        while (subscriber.getExpectedSequence() <= publisher.getLastSequence())
+        {
+            if (subscriber.poll(100) <= 0) break;
+        }
+    }
+    bench::doNotOptimize(subscriber);
+}
+
+} // namespace
+
+BENCHMARK("md/publish_diff", benchPublishDiff);
+BENCHMARK("md/multicast_loopback", benchMulticastLoopback);
@@ -0,0 +1,159 @@
+#include "benchmark.hpp"
+#include "bench_fixtures.hpp"
+#include "domain/order_book.hpp"
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+constexpr uint64_t kBatchSize = 4096;
+constexpr int kPriceLevels = 50;
+
+double levelPrice(uint64_t i, double base)
+{
+    return base + static_cast<double>(i % kPriceLevels) * 0.01;
+}
+
+// Arena compartilhada pelas variantes '/arena': os nós liberados por um lote voltam às free lists e são
+// reaproveitados pelo próximo, então depois do primeiro lote nenhuma alocação toca o heap
+MemoryArena& benchArena()
+{
+    static MemoryArena arena(ArenaOptions{64 * 1024 * 1024, true, -1, true});
+    return arena;
+}
+
+// Insere ordens em kPriceLevels níveis; o livro é recriado a cada lote para não crescer indefinidamente
+void benchAddOrder(bench::State& state, MemoryArena* arena)
+{
+    std::vector<std::shared_ptr<Order>> orders;
+    orders.reserve(kBatchSize);
+
+    uint64_t done = 0;
+    while (done < state.iterations())
+    {
+        uint64_t batch = std::min<uint64_t>(kBatchSize, state.iterations() - done);
+
+        state.pauseTiming();
+        auto book = std::make_unique<OrderBook>("GOOG", arena);
+        orders.clear();
+        for (uint64_t i = 0; i < batch; ++i)
+        {
+            orders.push_back(bench::makeLimitOrder(done + i, OrderSide::Buy, levelPrice(i, 100.0), 10));
+        }
+        state.resumeTiming();
+
+        for (uint64_t i = 0; i < batch; ++i)
+        {
+            book->addOrder(orders[i]);
+        }
+
+        state.pauseTiming();
+        book.reset();
+        state.resumeTiming();
+
+        done += batch;
+    }
+}
+
+void benchRemoveOrder(bench::State& state, MemoryArena* arena)
+{
+    std::vector<uint64_t> client_order_ids;
+    client_order_ids.reserve(kBatchSize);
+
+    uint64_t done = 0;
+    while (done < state.iterations())
+    {
+        uint64_t batch = std::min<uint64_t>(kBatchSize, state.iterations() - done);
+
+        state.pauseTiming();
+        auto book = std::make_unique<OrderBook>("GOOG", arena);
+        client_order_ids.clear();
+        for (uint64_t i = 0; i < batch; ++i)
+        {
+            client_order_ids.push_back(done + i);
+            book->addOrder(bench::makeLimitOrder(done + i, OrderSide::Sell, levelPrice(i, 101.0), 10));
+        }
+        state.resumeTiming();
+
+        for (uint64_t client_order_id : client_order_ids)
+        {
+            bench::doNotOptimize(book->removeOrder(1, client_order_id));
+        }
+
+        state.pauseTiming();
+        book.reset();
+        state.resumeTiming();
+
+        done += batch;
+    }
+}
+
+void benchGetTopBid(bench::State& state)
+{
+    state.pauseTiming();
+    OrderBook book("GOOG");
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        book.addOrder(bench::makeLimitOrder(i, OrderSide::Buy, levelPrice(i, 100.0), 10));
+    }
+    state.resumeTiming();
+
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        std::shared_ptr<Order> top = book.getTopBid();
+        bench::doNotOptimize(top);
+    }
+}
+
+// Leitura do BBO cacheado: não toca na árvore nem no shared_ptr da ordem
+void benchTopOfBook(bench::State& state)
+{
+    state.pauseTiming();
+    OrderBook book("GOOG");
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        book.addOrder(bench::makeLimitOrder(i, OrderSide::Buy, levelPrice(i, 100.0), 10));
+    }
+    state.resumeTiming();
+
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        TopOfBook top = book.getTopOfBook();
+        bench::doNotOptimize(top);
+    }
+}
+
+// Preço abrindo e fechando um nível no topo a cada volta (entra uma ordem num preço novo e sai logo depois).
+// Com a free list o nó do nível é reaproveitado; com capacidade 0 cada volta aloca e libera um nível.
+void benchLevelChurnAtTouch(bench::State& state, size_t pool_capacity)
+{
+    state.pauseTiming();
+    OrderBook book("GOOG");
+    book.setLevelPoolCapacity(pool_capacity);
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        book.addOrder(bench::makeLimitOrder(i, OrderSide::Buy, levelPrice(i, 99.0), 10));
+    }
+    std::shared_ptr<Order> inside[2] = {bench::makeLimitOrder(5000, OrderSide::Buy, 100.01, 10),
+                                        bench::makeLimitOrder(5001, OrderSide::Buy, 100.02, 10)};
+    state.resumeTiming();
+
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        const std::shared_ptr<Order>& order = inside[i & 1];
+        book.addOrder(order);
+        bench::doNotOptimize(book.removeOrder(1, order->getClientOrderId()));
+    }
+}
+
+} // namespace
+
+BENCHMARK("order_book/add_order", [](bench::State& state) { benchAddOrder(state, nullptr); });
+BENCHMARK("order_book/add_order/arena", [](bench::State& state) { benchAddOrder(state, &benchArena()); });
+BENCHMARK("order_book/remove_order", [](bench::State& state) { benchRemoveOrder(state, nullptr); });
+BENCHMARK("order_book/remove_order/arena", [](bench::State& state) { benchRemoveOrder(state, &benchArena()); });
+BENCHMARK("order_book/level_churn_at_touch", [](bench::State& state) { benchLevelChurnAtTouch(state, OrderBook::kDefaultLevelPoolCapacity); });
+BENCHMARK("order_book/level_churn_at_touch/no_pool", [](bench::State& state) { benchLevelChurnAtTouch(state, 0); });
+BENCHMARK("order_book/get_top_bid", benchGetTopBid);
+BENCHMARK("order_book/top_of_book", benchTopOfBook);
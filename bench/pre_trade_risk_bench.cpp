@@ -0,0 +1,62 @@
+#include "benchmark.hpp"
+#include "domain/pre_trade_risk.hpp"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+RiskLimits benchLimits()
+{
+    RiskLimits limits;
+    limits.max_order_quantity = 10000;
+    limits.max_order_notional = 1e9;
+    limits.max_open_orders = 1000;
+    limits.max_messages_per_second = 1u << 30;
+    limits.price_band_bps = 500;
+    return limits;
+}
+
+// Todas as checagens ligadas; a vaga de ordem aberta é devolvida a cada iteração, como a engine faria
+void checkLoop(PreTradeRisk& risk, uint64_t client_id, uint64_t iterations)
+{
+    std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        RiskRejectReason reason = risk.checkNewOrder(client_id, "GOOG", OrderSide::Buy, OrderType::Limit, 100, 10.0 + (i & 7) * 0.01, 0.0, now);
+        bench::doNotOptimize(reason);
+        risk.releaseOpenOrder(client_id);
+    }
+}
+
+void benchCheckNewOrder(bench::State& state)
+{
+    PreTradeRisk risk(benchLimits());
+    risk.addSymbol("GOOG");
+    risk.updateReferencePrice("GOOG", 10.0);
+    checkLoop(risk, 1, state.iterations());
+}
+
+// Clientes diferentes em threads diferentes: cada um atualiza só a sua linha de cache
+void benchCheckNewOrderThreads(bench::State& state, int threads)
+{
+    PreTradeRisk risk(benchLimits());
+    risk.addSymbol("GOOG");
+    risk.updateReferencePrice("GOOG", 10.0);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&risk, &state, t, threads]() { checkLoop(risk, static_cast<uint64_t>(t), state.iterations() / threads); });
+    }
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+} // namespace
+
+BENCHMARK("risk/check_new_order", benchCheckNewOrder);
+BENCHMARK("risk/check_new_order_4_clients", [](bench::State& state) { benchCheckNewOrderThreads(state, 4); });
@@ -0,0 +1,130 @@
+#include "benchmark.hpp"
+#include "utils/thread_safe_queue.hpp"
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+void benchPushPopSingleThread(bench::State& state)
+{
+    ThreadSafeQueue<uint64_t> queue;
+    uint64_t value = 0;
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        queue.push(i);
+        queue.wait_and_pop(value);
+    }
+    bench::doNotOptimize(value);
+}
+
+// 'producers' threads disputam a fila com um único consumidor, como o gateway e a engine.
+// Cada operação é um item que atravessa a fila (push + pop).
+void benchContended(bench::State& state, int producers)
+{
+    ThreadSafeQueue<std::unique_ptr<uint64_t>> queue;
+    const uint64_t total = state.iterations();
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        uint64_t count = total / producers + (static_cast<uint64_t>(p) < total % producers ? 1 : 0);
+        threads.emplace_back([&queue, count]() {
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                queue.push(std::make_unique<uint64_t>(i));
+            }
+        });
+    }
+
+    std::unique_ptr<uint64_t> item;
+    for (uint64_t i = 0; i < total; ++i)
+    {
+        queue.wait_and_pop(item);
+    }
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+    bench::doNotOptimize(item);
+}
+
+// Ida e volta entre duas threads (engine -> consumidor -> engine) com os dois lados usando a mesma estratégia
+// de espera. Mede o custo de acordar o consumidor, que é o que as estratégias de spin eliminam. busy_spin fica de
+// fora: sem um núcleo dedicado para cada lado, cada troca custaria uma fatia de tempo do escalonador. Com um
+// único núcleo disponível spin_park também perde, porque o spin só atrasa a thread que produziria o item.
+void benchPingPong(bench::State& state, WaitStrategy::Kind kind)
+{
+    WaitStrategy strategy;
+    strategy.kind = kind;
+    ThreadSafeQueue<uint64_t> ping;
+    ThreadSafeQueue<uint64_t> pong;
+    ping.setWaitStrategy(strategy);
+    pong.setWaitStrategy(strategy);
+
+    std::thread echo([&ping, &pong]() {
+        uint64_t value = 0;
+        while (ping.wait_and_pop(value))
+        {
+            pong.push(value);
+        }
+    });
+
+    uint64_t value = 0;
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        ping.push(i);
+        pong.wait_and_pop(value);
+    }
+    ping.shutdown();
+    echo.join();
+    bench::doNotOptimize(value);
+}
+
+// Mesmo cenário de benchContended, mas o consumidor retira tudo o que estiver acumulado (até 64 itens) com
+// uma única aquisição do mutex, como a engine e o auditor fazem.
+void benchContendedDrain(bench::State& state, int producers)
+{
+    ThreadSafeQueue<std::unique_ptr<uint64_t>> queue;
+    const uint64_t total = state.iterations();
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        uint64_t count = total / producers + (static_cast<uint64_t>(p) < total % producers ? 1 : 0);
+        threads.emplace_back([&queue, count]() {
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                queue.push(std::make_unique<uint64_t>(i));
+            }
+        });
+    }
+
+    std::vector<std::unique_ptr<uint64_t>> batch;
+    uint64_t received = 0;
+    while (received < total)
+    {
+        queue.drain_into(batch, 64);
+        received += batch.size();
+        batch.clear();
+    }
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+    bench::doNotOptimize(received);
+}
+
+} // namespace
+
+BENCHMARK("queue/push_pop_single_thread", benchPushPopSingleThread);
+BENCHMARK("queue/contended_1_producer", [](bench::State& state) { benchContended(state, 1); });
+BENCHMARK("queue/contended_4_producers", [](bench::State& state) { benchContended(state, 4); });
+BENCHMARK("queue/drain_into_1_producer", [](bench::State& state) { benchContendedDrain(state, 1); });
+BENCHMARK("queue/drain_into_4_producers", [](bench::State& state) { benchContendedDrain(state, 4); });
+BENCHMARK("queue/ping_pong/blocking", [](bench::State& state) { benchPingPong(state, WaitStrategy::Kind::Blocking); });
+BENCHMARK("queue/ping_pong/yield", [](bench::State& state) { benchPingPong(state, WaitStrategy::Kind::Yield); });
+BENCHMARK("queue/ping_pong/spin_park", [](bench::State& state) { benchPingPong(state, WaitStrategy::Kind::SpinThenPark); });
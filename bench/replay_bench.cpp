@@ -0,0 +1,109 @@
+#include "benchmark.hpp"
+#include "domain/replay_driver.hpp"
+#include "messaging/command_log.hpp"
+#include "messaging/commands/cancel_order_command.hpp"
+#include "messaging/commands/new_order_command.hpp"
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t kBatchSize = 64;
+
+// Fluxo sintético no formato do gerador de carga: limitadas em torno de 100.00 nos dois lados (boa parte cruza)
+// e 20% de cancelamentos de ordens enviadas antes. Semente fixa: o mesmo fluxo em toda execução.
+std::vector<std::unique_ptr<Command>> makeBatch(std::mt19937_64& rng, uint64_t& next_client_order_id)
+{
+    std::vector<std::unique_ptr<Command>> batch;
+    const std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+    for (size_t i = 0; i < kBatchSize; ++i)
+    {
+        const OrderSide side = (rng() & 1) ? OrderSide::Buy : OrderSide::Sell;
+        if (next_client_order_id > 100 && rng() % 5 == 0)
+        {
+            const uint64_t target = 1 + rng() % (next_client_order_id - 1);
+            batch.push_back(std::make_unique<CancelOrderCommand>(1, next_client_order_id++, target, "GOOG", side, now));
+            continue;
+        }
+        const double price = 99.90 + static_cast<double>(rng() % 21) * 0.01;
+        batch.push_back(std::make_unique<NewOrderCommand>(next_client_order_id++, 1, "GOOG", side, OrderType::Limit,
+                                                          static_cast<uint32_t>(1 + rng() % 10) * 10, price,
+                                                          OrderTimeInForce::GoodTillCancelled, OrderCapacity::Agency, now));
+    }
+    return batch;
+}
+
+std::string writeLog(uint64_t commands)
+{
+    const std::string path = "/tmp/orderbook_replay_bench_" + std::to_string(commands) + ".cmdlog";
+    CommandRecorder recorder;
+    recorder.open(path, {"GOOG", "AMZN", "AAPL", "MSFT"}, command_log::SessionSchedule{});
+
+    std::mt19937_64 rng(42);
+    uint64_t next_client_order_id = 1;
+    for (uint64_t sent = 0; sent < commands; sent += kBatchSize)
+    {
+        recorder.recordBatch(makeBatch(rng, next_client_order_id), std::chrono::system_clock::time_point{});
+    }
+    recorder.close();
+    return path;
+}
+
+// Custo da gravação no caminho da engine: copiar um lote de 64 comandos para o buffer do arquivo
+void benchRecordBatch(bench::State& state)
+{
+    state.pauseTiming();
+    CommandRecorder recorder;
+    recorder.open("/dev/null", {"GOOG"}, command_log::SessionSchedule{});
+    std::mt19937_64 rng(42);
+    uint64_t next_client_order_id = 1;
+    std::vector<std::unique_ptr<Command>> batch = makeBatch(rng, next_client_order_id);
+    state.setOpsPerIteration(batch.size());
+    state.resumeTiming();
+
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        recorder.recordBatch(batch, std::chrono::system_clock::time_point{});
+    }
+
+    state.pauseTiming();
+    recorder.close();
+    state.resumeTiming();
+}
+
+// Reexecução do registro inteiro numa engine nova: leitura dos lotes, processBatch e o resumo da saída.
+// Por operação = por comando reexecutado.
+void benchReplay(bench::State& state, uint64_t commands)
+{
+    state.pauseTiming();
+    const std::string path = writeLog(commands);
+    state.setOpsPerIteration(commands);
+    state.resumeTiming();
+
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        state.pauseTiming();
+        std::unique_ptr<ReplayDriver> driver = std::make_unique<ReplayDriver>();
+        driver->open(path);
+        state.resumeTiming();
+
+        bench::doNotOptimize(driver->run().checksum);
+
+        state.pauseTiming();
+        driver.reset();
+        state.resumeTiming();
+    }
+
+    state.pauseTiming();
+    std::remove(path.c_str());
+    state.resumeTiming();
+}
+
+} // namespace
+
+BENCHMARK("replay/record_batch", benchRecordBatch);
+BENCHMARK("replay/engine/20000", [](bench::State& state) { benchReplay(state, 20000); });
@@ -0,0 +1,128 @@
+#include "benchmark.hpp"
+#include "client/shm_order_client.hpp"
+#include "domain/fix_tcp_acceptor.hpp"
+#include "domain/inbound_gateway.hpp"
+#include "domain/shm_ingress_gateway.hpp"
+#include "messaging/commands/command.hpp"
+#include "utils/thread_safe_queue.hpp"
+#include <arpa/inet.h>
+#include <cstdio>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace
+{
+
+constexpr uint64_t kBenchClientId = 4242;
+
+WaitStrategy yieldStrategy()
+{
+    WaitStrategy strategy;
+    strategy.kind = WaitStrategy::Kind::Yield;
+    return strategy;
+}
+
+// Ida de uma ordem pelo transporte até virar comando na fila da engine, uma de cada vez: o cliente só envia a
+// próxima depois que a anterior foi retirada da fila. Poller e fila usam yield para a medida não depender de
+// acordar threads num host com poucos núcleos.
+void benchShmRoundTrip(bench::State& state)
+{
+    state.pauseTiming();
+    ThreadSafeQueue<std::unique_ptr<Command>> queue;
+    queue.setWaitStrategy(yieldStrategy());
+    InboundGateway gateway(queue, "build/bench/write_ahead_log.log");
+    ShmIngressGateway ingress(gateway);
+    ingress.setWaitStrategy(yieldStrategy());
+    ingress.addClient(kBenchClientId, 1024);
+    ShmOrderClient client;
+    client.connect(kBenchClientId);
+    std::thread poller([&ingress]() { ingress.run(); });
+    state.resumeTiming();
+
+    std::unique_ptr<Command> command;
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        client.sendNewOrder(i + 1, "GOOG", i % 2 ? OrderSide::Buy : OrderSide::Sell, OrderType::Limit, 10, i % 2 ? 9.50 : 10.50);
+        queue.wait_and_pop(command);
+    }
+    bench::doNotOptimize(command);
+
+    state.pauseTiming();
+    ingress.stop();
+    poller.join();
+    state.resumeTiming();
+}
+
+// Mesmo percurso pelo acceptor TCP, para comparação: socket de loopback, framing e parse do texto FIX
+void benchTcpRoundTrip(bench::State& state)
+{
+    state.pauseTiming();
+    ThreadSafeQueue<std::unique_ptr<Command>> queue;
+    queue.setWaitStrategy(yieldStrategy());
+    InboundGateway gateway(queue, "build/bench/write_ahead_log.log");
+    FixTcpAcceptor acceptor(gateway, FixAcceptorOptions{});
+    acceptor.start();
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(acceptor.getPort());
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    state.resumeTiming();
+
+    char body[160];
+    char message[192];
+    std::unique_ptr<Command> command;
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        int length = std::snprintf(body, sizeof(body), "8=FIX.4.2|34=%llu|35=D|11=%llu|55=GOOG|54=%d|38=10|44=%.2f|40=2|59=1|47=A|",
+                                   static_cast<unsigned long long>(i + 1), static_cast<unsigned long long>(i + 1), i % 2 ? 1 : 2, i % 2 ? 9.50 : 10.50);
+        unsigned int sum = 0;
+        for (int c = 0; c < length; ++c) sum += static_cast<unsigned char>(body[c]);
+        int total = std::snprintf(message, sizeof(message), "%s10=%03u|", body, sum % 256);
+        if (send(fd, message, static_cast<size_t>(total), 0) != total) break;
+        queue.wait_and_pop(command);
+    }
+    bench::doNotOptimize(command);
+
+    state.pauseTiming();
+    close(fd);
+    acceptor.stop();
+    state.resumeTiming();
+}
+
+// Só o ring: produtor e consumidor na mesma thread, sem o gateway
+void benchRingPushPop(bench::State& state)
+{
+    state.pauseTiming();
+    ShmSpscRing<ShmOrderMessage> ring;
+    ring.create("/orderbook-bench-ring", 1024, 1);
+    ShmOrderMessage message{};
+    state.resumeTiming();
+
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        message.sequence = static_cast<uint32_t>(i);
+        ring.tryPush(message);
+        if (ring.peek(1) == 1)
+        {
+            sum += ring.at(0).sequence;
+            ring.release(1);
+        }
+    }
+    bench::doNotOptimize(sum);
+}
+
+} // namespace
+
+BENCHMARK("ingress/shm_ring_push_pop", benchRingPushPop);
+BENCHMARK("ingress/round_trip/shm", benchShmRoundTrip);
+BENCHMARK("ingress/round_trip/tcp", benchTcpRoundTrip);
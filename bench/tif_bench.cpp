@@ -0,0 +1,63 @@
+#include "benchmark.hpp"
+#include "bench_fixtures.hpp"
+#include <memory>
+
+namespace
+{
+
+// FOK de compra que cruza 50 dos 100 níveis de venda semeados (10 por nível) mas pede um lote a mais do que
+// eles somam: é morto no pré-check. Como a ordem morta não muta o livro, o mesmo livro serve todas as iterações.
+void benchFokKill(bench::State& state, size_t prefix_levels)
+{
+    bench::EngineFixture fixture;
+    fixture.engine.setDepthPrefixLevels(prefix_levels);
+    OrderBook& book = fixture.book();
+    bench::seedAsks(book, 1, 100, 100);
+
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        std::shared_ptr<Order> order = std::make_shared<Order>(
+            Order::getNextOrderId(), 2, i, "GOOG", 101.495, 501,
+            OrderSide::Buy, OrderType::Limit, OrderTimeInForce::FillOrKill, OrderCapacity::Agency,
+            std::chrono::system_clock::now());
+        fixture.engine.processNewOrderCommand(order);
+
+        if ((i & 1023) == 1023)
+        {
+            state.pauseTiming();
+            fixture.drainEvents();
+            state.resumeTiming();
+        }
+    }
+    fixture.drainEvents();
+}
+
+// IOC que executa um lote do melhor nível e descarta o resto sem tocar no livro
+void benchIocPartial(bench::State& state)
+{
+    bench::EngineFixture fixture;
+    OrderBook& book = fixture.book();
+
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        state.pauseTiming();
+        book.addOrder(bench::makeLimitOrder(i, OrderSide::Sell, 100.0, 10));
+        std::shared_ptr<Order> order = std::make_shared<Order>(
+            Order::getNextOrderId(), 2, i, "GOOG", 100.0, 50,
+            OrderSide::Buy, OrderType::Limit, OrderTimeInForce::ImmediateOrCancel, OrderCapacity::Agency,
+            std::chrono::system_clock::now());
+        state.resumeTiming();
+
+        fixture.engine.processNewOrderCommand(order);
+
+        state.pauseTiming();
+        fixture.drainEvents();
+        state.resumeTiming();
+    }
+}
+
+} // namespace
+
+BENCHMARK("engine/fok_kill/walk_50_levels", [](bench::State& state) { benchFokKill(state, 0); });
+BENCHMARK("engine/fok_kill/prefix_64_levels", [](bench::State& state) { benchFokKill(state, 64); });
+BENCHMARK("engine/ioc_partial", [](bench::State& state) { benchIocPartial(state); });
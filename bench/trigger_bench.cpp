@@ -0,0 +1,83 @@
+#include "benchmark.hpp"
+#include "bench_fixtures.hpp"
+#include "domain/trigger_book.hpp"
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+std::shared_ptr<Order> makeTrailingSell(uint64_t client_order_id, double offset)
+{
+    std::shared_ptr<Order> order = std::make_shared<Order>(
+        Order::getNextOrderId(), 1, client_order_id, "GOOG", 0.0, 10,
+        OrderSide::Sell, OrderType::TrailingStop, OrderTimeInForce::Day, OrderCapacity::Agency,
+        std::chrono::system_clock::now());
+    order->setTrailingOffset(offset);
+    return order;
+}
+
+// Mercado subindo um tick por trade com 'count' trailing stops de venda vivos (4 distâncias distintas):
+// nenhum dispara, então o custo medido é só o de arrastar os stops para o novo máximo
+void benchTrailingUpdate(bench::State& state, uint64_t count)
+{
+    TriggerBook trigger_book;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        trigger_book.addOrder(makeTrailingSell(i, 1.0 + static_cast<double>(i % 4)), 100.0 - static_cast<double>(i % 50) * 0.01);
+    }
+
+    std::vector<std::shared_ptr<Order>> triggered;
+    double price = 100.0;
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        price += 0.01;
+        trigger_book.collectTriggered(price, price, price, triggered);
+    }
+    bench::doNotOptimize(triggered);
+}
+
+// Cascata completa: uma venda a mercado dispara 'stops' stops de venda em sequência, cada um derrubando o
+// preço até o próximo. Mede o comando inteiro (sweep, disparos em rodadas e snapshot).
+void benchStopCascade(bench::State& state, int stops)
+{
+    bench::EngineFixture fixture;
+    OrderBook& book = fixture.book();
+    uint64_t next_id = 1;
+
+    for (uint64_t i = 0; i < state.iterations(); ++i)
+    {
+        state.pauseTiming();
+        for (int level = 0; level <= stops; ++level)
+        {
+            book.addOrder(bench::makeLimitOrder(next_id++, OrderSide::Buy, 100.0 - level * 0.01, 10));
+        }
+        for (int k = 0; k < stops; ++k)
+        {
+            std::shared_ptr<Order> stop = std::make_shared<Order>(
+                Order::getNextOrderId(), 1, next_id++, "GOOG", 0.0, 10,
+                OrderSide::Sell, OrderType::Stop, OrderTimeInForce::Day, OrderCapacity::Agency,
+                std::chrono::system_clock::now());
+            stop->setStopPrice(100.0 - k * 0.01 - 0.005);
+            fixture.engine.processNewOrderCommand(stop);
+        }
+        std::shared_ptr<Order> aggressor = std::make_shared<Order>(
+            Order::getNextOrderId(), 2, next_id++, "GOOG", 0.0, 10,
+            OrderSide::Sell, OrderType::Market, OrderTimeInForce::ImmediateOrCancel, OrderCapacity::Agency,
+            std::chrono::system_clock::now());
+        fixture.drainEvents();
+        state.resumeTiming();
+
+        fixture.engine.processNewOrderCommand(aggressor);
+
+        state.pauseTiming();
+        fixture.drainEvents();
+        state.resumeTiming();
+    }
+}
+
+} // namespace
+
+BENCHMARK("trigger_book/trailing_update/100", [](bench::State& state) { benchTrailingUpdate(state, 100); });
+BENCHMARK("trigger_book/trailing_update/10000", [](bench::State& state) { benchTrailingUpdate(state, 10000); });
+BENCHMARK("engine/stop_cascade/10", [](bench::State& state) { benchStopCascade(state, 10); });
@@ -0,0 +1,98 @@
+#ifndef MARKET_DATA_SUBSCRIBER_HPP
+#define MARKET_DATA_SUBSCRIBER_HPP
+
+#include "messaging/market_data_feed.hpp"
+#include "utils/latency_histogram.hpp"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Assinante de referência do feed multicast (ver MulticastMarketDataPublisher). Mantém o top-N de cada símbolo
+// aplicando os FeedLevelUpdates em ordem de sequência. Começa fora de sincronia e também sai dela ao detectar um
+// salto: a partir daí guarda os pacotes incrementais que chegam, espera um ciclo completo do canal de snapshot,
+// instala os livros do snapshot e reaplica os incrementais guardados com sequência posterior à dele.
+//
+// Para cada pacote incremental registra a latência publicação -> recebimento (system_clock do recebimento menos
+// o send timestamp do pacote), que só tem sentido com os relógios dos dois hosts sincronizados ou no mesmo host.
+// Não é thread-safe: poll() e as consultas devem vir da mesma thread.
+class MarketDataSubscriber
+{
+public:
+    struct Book
+    {
+        std::map<double, uint64_t, std::greater<double>> bids;
+        std::map<double, uint64_t> asks;
+    };
+
+    explicit MarketDataSubscriber(const MulticastFeedOptions& options);
+    ~MarketDataSubscriber();
+
+    MarketDataSubscriber(const MarketDataSubscriber&) = delete;
+    MarketDataSubscriber& operator=(const MarketDataSubscriber&) = delete;
+
+    // Entra nos grupos dos dois canais. Retorna false (com o erro no stderr) se não conseguir.
+    bool open();
+    void close();
+
+    // Espera até timeout_ms por datagramas e processa todos os que já chegaram nos dois canais.
+    // Retorna quantos datagramas foram lidos, ou -1 em erro.
+    int poll(int timeout_ms);
+
+    bool isSynchronized() const { return synchronized_; }
+    // Livro do símbolo, ou nullptr se ele nunca apareceu no feed
+    const Book* getBook(const std::string& symbol) const;
+    uint64_t getExpectedSequence() const { return expected_sequence_; }
+    const LatencyHistogram& getLatency() const { return latency_; }
+
+    uint64_t packetsReceived() const { return packets_received_; }
+    uint64_t updatesApplied() const { return updates_applied_; }
+    uint64_t gapsDetected() const { return gaps_detected_; }
+    uint64_t recoveries() const { return recoveries_; }
+    uint64_t duplicatePackets() const { return duplicate_packets_; }
+    uint64_t malformedPackets() const { return malformed_packets_; }
+
+private:
+    // Incrementais guardados durante a recuperação; acima disso os mais antigos são descartados (o snapshot
+    // seguinte os cobre)
+    static constexpr size_t kMaxBufferedPackets = 16384;
+
+    void onIncremental(const char* data, size_t length);
+    void onSnapshot(const char* data, size_t length);
+    // Aplica um pacote incremental já validado. Retorna false se ele abrir um salto de sequência.
+    bool applyIncremental(const char* data);
+    void replayBuffered();
+    void applyUpdate(const market_data_feed::FeedLevelUpdate& update);
+    static bool validPacket(const char* data, size_t length, uint8_t kind, size_t record_size);
+    static int openSocket(const MulticastFeedOptions& options, const std::string& group, uint16_t port);
+
+    MulticastFeedOptions options_;
+    int incremental_fd_ = -1;
+    int snapshot_fd_ = -1;
+
+    std::unordered_map<std::string, Book> books_;
+    bool synchronized_ = false;
+    uint64_t expected_sequence_ = 1;
+    std::deque<std::vector<char>> buffered_;
+
+    // Ciclo de snapshot em montagem
+    std::unordered_map<std::string, Book> pending_books_;
+    bool snapshot_in_progress_ = false;
+    uint64_t snapshot_sequence_ = 0;
+    uint16_t snapshot_next_index_ = 0;
+
+    alignas(8) char buffer_[market_data_feed::kMaxDatagramBytes];
+    LatencyHistogram latency_;
+
+    uint64_t packets_received_ = 0;
+    uint64_t updates_applied_ = 0;
+    uint64_t gaps_detected_ = 0;
+    uint64_t recoveries_ = 0;
+    uint64_t duplicate_packets_ = 0;
+    uint64_t malformed_packets_ = 0;
+};
+
+#endif // MARKET_DATA_SUBSCRIBER_HPP
@@ -0,0 +1,39 @@
+#ifndef SHM_ORDER_CLIENT_HPP
+#define SHM_ORDER_CLIENT_HPP
+
+#include "messaging/shm_order_message.hpp"
+#include "types/order_params.hpp"
+#include "utils/shm_ring.hpp"
+#include <cstdint>
+#include <string>
+
+// Biblioteca do lado do cliente co-located: abre o segmento criado pelo ShmIngressGateway para o seu id e escreve
+// ShmOrderMessages no ring. Cada envio preenche a sequência da sessão e o send timestamp; retorna false se o ring
+// estiver cheio (o gateway está atrasado), cabendo ao cliente tentar de novo ou desistir da ordem.
+// Não é thread-safe: o ring é SPSC, então cada cliente usa um ShmOrderClient numa única thread.
+class ShmOrderClient
+{
+public:
+    // Abre /orderbook-ingress-<client_id>
+    bool connect(uint64_t client_id);
+    bool connect(const std::string& segment_name);
+    void disconnect() { ring_.detach(); }
+    bool isConnected() const { return ring_.isAttached(); }
+
+    bool sendNewOrder(uint64_t client_order_id, const std::string& symbol, OrderSide side, OrderType type, uint32_t quantity, double price,
+                      OrderTimeInForce time_in_force = OrderTimeInForce::Day, double stop_price = 0.0,
+                      OrderCapacity capacity = OrderCapacity::Agency);
+    bool sendCancel(uint64_t client_order_id, uint64_t orig_client_order_id, const std::string& symbol, OrderSide side);
+    bool sendAmend(uint64_t client_order_id, uint64_t orig_client_order_id, const std::string& symbol, OrderSide side,
+                   uint32_t new_quantity, double new_price);
+
+    uint32_t getLastSequence() const { return sequence_; }
+
+private:
+    bool send(ShmOrderMessage& message, const std::string& symbol);
+
+    ShmSpscRing<ShmOrderMessage> ring_;
+    uint32_t sequence_ = 0;
+};
+
+#endif // SHM_ORDER_CLIENT_HPP
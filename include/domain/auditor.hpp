@@ -9,16 +9,28 @@
 
 class Auditor {
 public:
-    explicit Auditor(ThreadSafeQueue<std::shared_ptr<const Event>>& event_queue, const std::string& log_file_path = "src/logs/auditor_log.log");
+    explicit Auditor(ThreadSafeQueue<Event>& event_queue, const std::string& log_file_path = "src/logs/auditor_log.log");
+    // Buffer de escrita do journal (ex: um bloco de uma MemoryArena). Deve ser chamado antes de initialize() e o
+    // buffer precisa viver mais que o auditor; sem ele o arquivo usa o buffer padrão do ofstream.
+    void setJournalBuffer(char* buffer, size_t size) { journal_buffer_ = buffer; journal_buffer_size_ = size; }
+
     bool initialize();
     void run();
 
+    // Formata um evento na linha padronizada do journal (sem o '\n' final)
+    std::string formatEventLog(const Event& event) const;
+
 private:
-    ThreadSafeQueue<std::shared_ptr<const Event>>& event_queue_;
+    // Máximo de eventos retirados da fila por vez
+    static constexpr size_t kMaxBatch = 256;
+
+    ThreadSafeQueue<Event>& event_queue_;
     std::string log_file_path_;
     std::ofstream log_file_;
+    char* journal_buffer_ = nullptr;
+    size_t journal_buffer_size_ = 0;
     
-    void writeEventLog(const std::shared_ptr<const Event>& event);
+    void writeEventLog(const Event& event);
 };
 
 #endif // AUDITOR_HPP
\ No newline at end of file
@@ -0,0 +1,25 @@
+#ifndef BBO_GATEWAY_HPP
+#define BBO_GATEWAY_HPP
+
+#include "messaging/events/event.hpp"
+#include "utils/thread_safe_queue.hpp"
+#include <string>
+#include <memory>
+#include <fstream>
+
+// Consumidor do canal de BBO: roda na sua própria thread, então um consumidor de profundidade lento
+// (MarketDataGateway) não atrasa a entrega do topo do livro. Cada BboEvent vira uma linha JSON.
+class BboGateway {
+public:
+    explicit BboGateway(ThreadSafeQueue<Event>& bbo_queue, const std::string& output_file_path = "src/logs/bbo.log");
+    bool initialize();
+    void run();
+    std::string formatBboToJSON(const Event& event) const;
+
+private:
+    ThreadSafeQueue<Event>& bbo_queue_;
+    std::string output_file_path_;
+    std::ofstream output_file_;
+};
+
+#endif // BBO_GATEWAY_HPP
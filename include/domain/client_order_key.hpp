@@ -0,0 +1,29 @@
+#ifndef CLIENT_ORDER_KEY_HPP
+#define CLIENT_ORDER_KEY_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+// Identifica uma ordem do ponto de vista do cliente: cancel (35=F) e amend (35=G) chegam com o
+// OrigClOrdID (tag 41), nunca com o order_id interno. Indexar por essa chave resolve o cancel em um único probe.
+struct ClientOrderKey
+{
+    uint64_t client_id;
+    uint64_t client_order_id;
+
+    bool operator==(const ClientOrderKey& other) const
+    {
+        return client_id == other.client_id && client_order_id == other.client_order_id;
+    }
+};
+
+struct ClientOrderKeyHash
+{
+    size_t operator()(const ClientOrderKey& key) const
+    {
+        return std::hash<uint64_t>()(key.client_order_id ^ (key.client_id * 0x9E3779B97F4A7C15ULL));
+    }
+};
+
+#endif // CLIENT_ORDER_KEY_HPP
@@ -6,8 +6,15 @@
 #include "messaging/commands/command.hpp"
 #include "messaging/events/event.hpp"
 #include "domain/event_bus_dispatcher.hpp"
+#include "utils/latency_histogram.hpp"
+#include "utils/timer_wheel.hpp"
+#include "domain/pre_trade_risk.hpp"
 #include <unordered_map>
 
+class CancelOrderCommand;
+class AmendOrderCommand;
+class CommandRecorder;
+
 
 class Engine 
 {
@@ -21,19 +28,182 @@ public:
 
     bool initialize();
     void run();
+
+    // Um lote do run(): avança os timers até 'timer_now' (time_point{} = sem avanço), executa os comandos e
+    // publica os eventos e o market data do lote de uma vez. Público para a reexecução de um registro de comandos.
+    void processBatch(std::vector<std::unique_ptr<Command>>& batch, const std::chrono::system_clock::time_point& timer_now);
+
+    // Grava cada lote consumido pelo run(), com o instante usado nos timers (ver CommandRecorder). O recorder
+    // deve viver mais que a thread da engine; nullptr desliga a gravação.
+    void setCommandRecorder(CommandRecorder* recorder) { recorder_ = recorder; }
     bool initializeOrderBooks(const std::string& symbol);
     void printOrderBooks() const;
 
     bool processNewOrderCommand(std::shared_ptr<Order> new_order_ptr);
-    void publishEvent(std::shared_ptr<const Event> event);
+    bool processCancelOrderCommand(const CancelOrderCommand& command);
+    bool processAmendOrderCommand(const AmendOrderCommand& command);
+    void publishEvent(const Event& event);
+
+    // Market data do fim de um comando: o BBO (só se o topo mudou) e o snapshot de profundidade (se os níveis
+    // publicados mudaram). Dentro de um lote de run() só marca o livro; a publicação sai em flushBookUpdates().
+    void publishBookUpdate(OrderBook& orderBook, bool depth_changed);
+    void flushBookUpdates();
     
-    void tryMatchOrderWithTopOfBook(std::shared_ptr<Order> new_order_ptr, OrderBook& orderBook);
+    // Executa a ordem contra o lado oposto (sweep nível a nível) e publica um TradeExecutedEvent por fill.
+    // Retorna true se houve ao menos uma execução; o snapshot do livro fica a cargo do chamador (um por comando).
+    bool tryMatchOrderWithTopOfBook(std::shared_ptr<Order> new_order_ptr, OrderBook& orderBook);
     std::unordered_map<std::string, std::unique_ptr<OrderBook>>& getOrderBooks() { return order_books_; }
+    // Profundidade publicada do símbolo, lida sem lock de qualquer thread (risco, consultas, dashboards).
+    // Os livros são criados antes de a engine rodar, então a busca no mapa não concorre com inserções.
+    bool readDepthView(const std::string& symbol, BookDepthView& out) const;
+
+    // Desliga os logs por comando no stdout (imprimir o livro a cada ordem inviabiliza testes de carga)
+    void setVerbose(bool verbose) { verbose_ = verbose; }
+    bool isVerbose() const { return verbose_; }
+
+    // Quando configurado, a engine registra a latência (agendamento do comando -> fim do processamento)
+    // de todo comando que carrega um intended timestamp. Só deve ser lido depois que a thread da engine terminar.
+    void setLatencyHistogram(LatencyHistogram* histogram) { latency_histogram_ = histogram; }
+
+    // Quantos níveis de cada lado entram no prefixo de profundidade usado pelo pré-check de FOK (0 = desligado,
+    // o pré-check anda pelos níveis do livro). Vale para os livros existentes e para os criados depois.
+    void setDepthPrefixLevels(size_t levels);
+
+    // Quantos níveis de preço esvaziados cada lado de cada livro guarda para reaproveitar (0 = sem free list).
+    // Vale para os livros existentes e para os criados depois.
+    void setLevelPoolCapacity(size_t levels);
+
+    // Máximo de comandos que run() retira da fila de uma vez. Os eventos e o market data são emitidos por lote
+    // (um snapshot/BBO por livro alterado), então o lote limita a latência extra que o agrupamento adiciona.
+    // 1 volta ao processamento comando a comando.
+    void setMaxBatchSize(size_t max_batch_size) { max_batch_size_ = max_batch_size == 0 ? 1 : max_batch_size; }
+
+    // Arena de onde saem os nós dos livros criados a partir daqui (nullptr = heap). Deve ser definida antes de
+    // initialize() e viver mais que a engine; só a thread da engine a usa.
+    void setBookArena(MemoryArena* arena) { book_arena_ = arena; }
+
+    // Risco pré-trade dos gateways: a engine registra os símbolos dos livros criados, devolve a vaga de ordem
+    // aberta quando uma ordem termina e publica o último trade de cada símbolo. Deve ser definido antes de initialize().
+    void setPreTradeRisk(PreTradeRisk* risk) { pre_trade_risk_ = risk; }
+
+    // Shard dos ids de ordem e de trade gerados pela thread da engine (ver IdGenerator). Engines diferentes
+    // precisam de shards diferentes; deve ser definido antes de run(). Retorna false se shard >= kMaxShards.
+    bool setIdShard(uint32_t shard);
+
+    // Horário de fechamento da sessão: ordens Day que descansarem no livro (ou esperarem um stop) passam a ser
+    // agendadas para expirar nele. Sem fechamento configurado, ordens Day não expiram.
+    void setSessionClose(const std::chrono::system_clock::time_point& session_close);
+
+    // Avança a timer wheel até 'now' e expira, em lote, as ordens vencidas. Chamado pelo loop da engine;
+    // público para que testes de carga e benchmarks possam simular o fechamento.
+    void advanceTimers(const std::chrono::system_clock::time_point& now);
+    size_t pendingExpirations() const { return expiry_wheel_.size(); }
+
+    // Relógio da timer wheel (o instante da construção até o primeiro avanço). A reexecução de um registro
+    // reposiciona a wheel no relógio da engine gravada; só pode ser feito antes de haver expirações agendadas.
+    std::chrono::system_clock::time_point getTimerClock() const;
+    bool resetTimerClock(const std::chrono::system_clock::time_point& start);
+
+    // Leilão de abertura: os livros (os existentes e os criados até lá) ficam em Auction e são descruzados em 'open_time'
+    void setOpeningAuction(const std::chrono::system_clock::time_point& open_time);
+    // Leilão de fechamento: em 'auction_start' todos os livros entram em Auction e o descruzamento acontece no
+    // fechamento da sessão, antes de as ordens Day expirarem. Retorna false se setSessionClose não foi chamado.
+    bool setClosingAuction(const std::chrono::system_clock::time_point& auction_start);
+
+    // Durante o leilão as ordens limitadas só acumulam no livro (que pode ficar cruzado) e ordens a mercado, IOC e
+    // FOK são canceladas sem executar. uncrossAuction executa tudo que cruza a um preço único (OrderBook::uncross),
+    // publica os trades e devolve o livro à negociação contínua. Chamados pelos timers do loop da engine; públicos
+    // para benchmarks. Retornam false para símbolo desconhecido ou livro na fase errada.
+    bool startAuction(const std::string& symbol);
+    bool uncrossAuction(const std::string& symbol);
 
 private:
+    // Profundidade dos BookSnapshotEvents publicados; mudanças fora desses níveis não geram market data
+    static constexpr size_t kSnapshotDepth = BookSnapshotEvent::kMaxDepth;
+
+    // Espera máxima na fila de comandos enquanto houver expirações agendadas (granularidade da expiração)
+    static constexpr std::chrono::milliseconds kTimerPollInterval{10};
+
+    OrderBook* findOrderBook(const std::string& symbol);
+
+    // Há expirações ou mudanças de fase agendadas: a espera por comandos precisa ser limitada
+    bool hasPendingTimers() const { return !expiry_wheel_.empty() || closing_auction_tick_ != 0 || auction_uncross_tick_ != 0; }
+
+    // Início do leilão de fechamento e descruzamento dos livros em leilão, quando o horário de cada um chega
+    void advanceTradingPhases(uint64_t tick);
+
+    // Mata uma ordem FOK sem liquidez suficiente (publica só o cancel); retorna true se a ordem foi morta
+    bool killUnfillableOrder(const std::shared_ptr<Order>& order, OrderBook& orderBook);
+
+    // Casa uma ordem já aceita e descansa ou cancela o restante conforme o tipo e o TIF.
+    // Retorna true se os níveis publicados no snapshot mudaram.
+    bool executeOrder(std::shared_ptr<Order> order, OrderBook& orderBook);
+
+    // Põe a ordem no TriggerBook e publica o aceite; se ela for inválida, rejeita (ver rejectOrder) e retorna false
+    bool enterStopOrder(std::shared_ptr<Order> order, OrderBook& orderBook);
+
+    // Recusa uma ordem nova antes do aceite: libera a vaga de risco dela e publica o OrderRejectedEvent (35=8, 39=8).
+    // 'reason' deve ser um literal, o evento não copia o texto.
+    void rejectOrder(const Order& order, SymbolId symbol_id, const char* reason);
+
+    // Indica se o cliente já tem uma ordem viva com este ClOrdID no símbolo, no livro ou esperando disparo
+    bool isClientOrderIdLive(uint64_t client_id, uint64_t client_order_id, OrderBook& orderBook);
+
+    // Agenda a expiração de uma ordem Day/GTD que ficou viva (no livro ou no TriggerBook)
+    void scheduleExpiry(const std::shared_ptr<Order>& order);
+
+    // Timer wheel em milissegundos de relógio de parede
+    static uint64_t toTimerTick(const std::chrono::system_clock::time_point& time_point);
+
+    // Ordem terminou (executada, cancelada, expirada ou rejeitada): libera a vaga no limite de ordens abertas do cliente
+    void releaseOrder(const Order& order) { if (pre_trade_risk_) pre_trade_risk_->releaseOpenOrder(order.getClientId()); }
+
+    // Acumula a faixa de preços negociada desde a última checagem de stops
+    void recordTradePrice(double price);
+
+    // Dispara e executa os stops cruzados pelos trades pendentes, em rodadas, até a cascata parar.
+    // Retorna true se os níveis publicados no snapshot mudaram.
+    bool processTriggeredStops(OrderBook& orderBook);
+
     ThreadSafeQueue<std::unique_ptr<Command>>& command_queue_;
     EventBusDispatcher& event_bus_;
     std::unordered_map<std::string, std::unique_ptr<OrderBook>> order_books_; // Mapeia símbolos para seus respectivos OrderBooks
+    bool verbose_ = true;
+    LatencyHistogram* latency_histogram_ = nullptr;
+    size_t depth_prefix_levels_ = 0;
+    size_t level_pool_capacity_ = OrderBook::kDefaultLevelPoolCapacity;
+    uint32_t id_shard_ = 0;
+    MemoryArena* book_arena_ = nullptr;
+    PreTradeRisk* pre_trade_risk_ = nullptr;
+    CommandRecorder* recorder_ = nullptr;
+
+    // Timestamp de todos os eventos do comando em execução: o relógio é lido uma vez na entrada de cada comando,
+    // não a cada evento; um avanço dos timers usa o próprio instante. O market data do lote leva o do último.
+    std::chrono::system_clock::time_point event_time_{};
+
+    // Processamento em lote do run(): comandos retirados de uma vez e livros com market data pendente no lote
+    size_t max_batch_size_ = 64;
+    bool batching_ = false;
+    std::vector<std::unique_ptr<Command>> batch_;
+    std::vector<std::pair<OrderBook*, bool>> pending_book_updates_;
+    std::vector<Fill> fills_; // reaproveitado entre sweeps para não alocar no caminho de matching
+    std::vector<std::shared_ptr<Order>> triggered_;
+
+    // Expiração de ordens Day/GTD. A wheel guarda weak_ptr: ordens executadas ou canceladas antes do prazo
+    // não precisam ser desagendadas, só são ignoradas no disparo.
+    TimerWheel<std::weak_ptr<Order>> expiry_wheel_;
+    uint64_t session_close_tick_ = 0;
+    std::vector<std::shared_ptr<Order>> expiring_;
+
+    // Leilões agendados (0 = nenhum). Enquanto há um descruzamento agendado, livros novos nascem em Auction.
+    uint64_t closing_auction_tick_ = 0;
+    uint64_t auction_uncross_tick_ = 0;
+    std::vector<AuctionFill> auction_fills_;
+
+    // Faixa negociada ainda não verificada contra o TriggerBook
+    bool pending_trades_ = false;
+    double trade_low_ = 0.0;
+    double trade_high_ = 0.0;
 };
 
 #endif // ENGINE_HPP
\ No newline at end of file
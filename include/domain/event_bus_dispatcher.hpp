@@ -4,21 +4,36 @@
 #include "messaging/events/event.hpp"
 #include "utils/thread_safe_queue.hpp"
 #include "utils/market_data_channel.hpp"
-#include <memory>
-#include <unordered_map>
-#include <functional>
+#include <vector>
 
 class EventBusDispatcher
 {
 public:
-    EventBusDispatcher(ThreadSafeQueue<std::shared_ptr<const Event>>& event_queue, MarketDataChannel& market_data_channel);
+    // BboEvents seguem pela bbo_queue, separada do canal de snapshots de profundidade
+    EventBusDispatcher(ThreadSafeQueue<Event>& event_queue, MarketDataChannel& market_data_channel, ThreadSafeQueue<Event>& bbo_queue);
+
+    // Com uma fila de execution reports, cada evento transacional também é entregue nela (uma cópia do registro
+    // que vai para o Auditor). Deve ser chamado antes de a engine começar a publicar.
+    void setExecutionReportQueue(ThreadSafeQueue<Event>* report_queue) { report_queue_ = report_queue; }
 
     // Publish an event to the event bus
-    void publish(std::shared_ptr<const Event> event);
+    void publish(const Event& event);
+
+    // Entre beginBatch() e flushBatch() os eventos destinados às filas (transacionais e BBO) ficam retidos e são
+    // entregues de uma vez, com uma aquisição de mutex por fila. Snapshots seguem direto para o canal conflacionado.
+    void beginBatch() { batching_ = true; }
+    void flushBatch();
 
 private:
-    ThreadSafeQueue<std::shared_ptr<const Event>>& event_queue_;
+    ThreadSafeQueue<Event>& event_queue_;
     MarketDataChannel& market_data_channel_;
+    ThreadSafeQueue<Event>& bbo_queue_;
+    ThreadSafeQueue<Event>* report_queue_ = nullptr;
+
+    bool batching_ = false;
+    std::vector<Event> pending_events_;
+    std::vector<Event> pending_bbo_;
+    std::vector<Event> pending_reports_;
 };
 
 #endif // EVENT_BUS_DISPATCHER_HPP
\ No newline at end of file
@@ -0,0 +1,127 @@
+#ifndef EXECUTION_REPORT_GATEWAY_HPP
+#define EXECUTION_REPORT_GATEWAY_HPP
+
+#include "messaging/events/event.hpp"
+#include "types/order_params.hpp"
+#include "utils/thread_safe_queue.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct ExecutionReportOptions
+{
+    std::string sender_comp_id = "ENGINE";       // tag 49 de todas as mensagens de saída
+    size_t session_queue_bytes = 256 * 1024;     // fila de envio de cada sessão
+    std::string drop_copy_path;                  // com um caminho, todos os reports também vão para esse arquivo
+};
+
+// Dados de um report já extraídos do evento; vira um 35=8 (ou 35=9 para CancelRejected) no buffer da sessão
+struct ExecutionReport
+{
+    char msg_type = '8';
+    uint64_t client_id = 0;
+    uint64_t order_id = 0;
+    uint64_t client_order_id = 0;
+    uint64_t orig_client_order_id = 0; // 0 = sem tag 41
+    std::string_view symbol;
+    char exec_type = '0';
+    char ord_status = '0';
+    OrderSide side = OrderSide::Buy;
+    uint32_t order_qty = 0;
+    uint32_t last_qty = 0;             // 0 = sem LastShares/LastPx
+    uint32_t leaves_qty = 0;
+    uint32_t cum_qty = 0;
+    double price = 0.0;
+    double last_px = 0.0;
+    int cxl_rej_response_to = 0;       // 434 do 35=9
+    const char* text = nullptr;        // 58
+};
+
+// Saída de execution reports para os clientes. Consome a cópia do fluxo transacional que o EventBusDispatcher
+// entrega na sua fila (os mesmos eventos do Auditor), gera um report por cliente envolvido em cada evento e o
+// escreve direto na fila de envio preallocada da sessão do cliente, com FixMessageWriter (sem stringstream).
+//
+// Cada sessão tem a sua fila: o envio é não bloqueante e o que o socket não aceitar fica na fila para a próxima
+// volta, então um cliente lento só atrasa a si mesmo. Se a fila dele encher, a sessão é derrubada (slow consumer)
+// em vez de segurar a thread; a engine nunca espera por esta thread, que só lê da fila de eventos.
+//
+// Sessões são registradas pelo acceptor FIX (attachSession/detachSession, chamados nas threads de I/O). Clientes
+// sem sessão (o gerador de carga, os clientes de memória compartilhada) só aparecem no drop copy, se houver.
+class ExecutionReportGateway
+{
+public:
+    explicit ExecutionReportGateway(ThreadSafeQueue<Event>& report_queue,
+                                    const ExecutionReportOptions& options = ExecutionReportOptions{});
+
+    bool initialize();
+
+    // detachSession deve ser chamado antes do close(fd), para o número do descritor não ser reutilizado por
+    // outra conexão enquanto esta thread ainda escreve nele
+    void attachSession(uint64_t client_id, int fd);
+    void detachSession(uint64_t client_id);
+
+    void run();
+
+    // Extrai os reports de um evento (um por lado num trade, um por ordem numa expiração)
+    static void collectReports(const Event& event, std::vector<ExecutionReport>& out);
+    // Escreve o report como mensagem FIX completa em buffer (MsgSeqNum = sequence); retorna a mensagem ou vazio
+    // se não couber
+    std::string_view renderReport(const ExecutionReport& report, uint64_t exec_id, uint64_t sequence, char* buffer, size_t capacity);
+
+    uint64_t reportsRendered() const { return reports_rendered_.load(std::memory_order_relaxed); }
+    uint64_t bytesSent() const { return bytes_sent_.load(std::memory_order_relaxed); }
+    uint64_t unroutedReports() const { return unrouted_reports_.load(std::memory_order_relaxed); }
+    uint64_t slowConsumerDisconnects() const { return slow_consumer_disconnects_.load(std::memory_order_relaxed); }
+
+private:
+    // Eventos retirados da fila por volta
+    static constexpr size_t kMaxBatch = 256;
+    // Maior report gerado; a fila da sessão sempre reserva esse espaço antes de renderizar
+    static constexpr size_t kMaxReportBytes = 512;
+    // Com bytes parados em alguma sessão, a espera por eventos acorda nesse intervalo para tentar de novo
+    static constexpr std::chrono::microseconds kRetryInterval{200};
+
+    struct Session
+    {
+        uint64_t client_id = 0;
+        int fd = -1;
+        uint64_t next_sequence = 1;
+        std::unique_ptr<char[]> queue;
+        size_t head = 0; // primeiro byte ainda não enviado
+        size_t tail = 0; // fim dos bytes renderizados
+        bool disconnected = false;
+    };
+
+    void routeReport(const ExecutionReport& report);
+    void enqueue(Session& session, const ExecutionReport& report, uint64_t exec_id);
+    // Envia o que couber no socket; retorna true se ainda sobrou algo na fila
+    bool flush(Session& session);
+    void disconnect(Session& session, const char* reason);
+
+    ThreadSafeQueue<Event>& report_queue_;
+    ExecutionReportOptions options_;
+
+    std::mutex sessions_mutex_; // aberturas e fechamentos contra a volta de envio
+    std::unordered_map<uint64_t, std::unique_ptr<Session>> sessions_;
+    bool has_pending_ = false;
+
+    std::vector<ExecutionReport> reports_;
+    uint64_t next_exec_id_ = 1;
+    std::ofstream drop_copy_;
+    std::unique_ptr<char[]> drop_copy_buffer_;
+    uint64_t drop_copy_sequence_ = 1;
+
+    std::atomic<uint64_t> reports_rendered_{0};
+    std::atomic<uint64_t> bytes_sent_{0};
+    std::atomic<uint64_t> unrouted_reports_{0};
+    std::atomic<uint64_t> slow_consumer_disconnects_{0};
+};
+
+#endif // EXECUTION_REPORT_GATEWAY_HPP
@@ -0,0 +1,118 @@
+#ifndef FIX_TCP_ACCEPTOR_HPP
+#define FIX_TCP_ACCEPTOR_HPP
+
+#include "domain/inbound_gateway.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct FixAcceptorOptions
+{
+    std::string bind_address = "127.0.0.1";
+    uint16_t port = 0;                   // 0 = porta escolhida pelo kernel (ver getPort())
+    int io_threads = 1;
+    size_t read_buffer_bytes = 64 * 1024; // por sessão; uma mensagem maior que isso derruba a sessão
+    uint64_t first_client_id = 1000;      // ids de cliente dados às sessões, em ordem de conexão
+    std::vector<int> cpus;                // afinidade das threads de I/O
+};
+
+// Porta de entrada FIX por TCP: poucas threads de I/O atendem muitas sessões com epoll edge-triggered e sockets
+// não bloqueantes. Cada sessão tem um buffer de leitura reaproveitado; as mensagens são delimitadas por 8=/10=
+// dentro do próprio buffer e entregues ao InboundGateway como string_view, que cria o comando (passando pelo
+// risco pré-trade) na própria thread de I/O e o empurra para a fila da engine.
+//
+// Sequência da sessão (tag 34): mensagens abaixo da esperada são duplicatas e são descartadas; um salto é logado
+// e a sessão se ressincroniza no número recebido (não há caminho de saída para um ResendRequest).
+class FixTcpAcceptor
+{
+public:
+    FixTcpAcceptor(InboundGateway& gateway, const FixAcceptorOptions& options);
+    ~FixTcpAcceptor();
+
+    FixTcpAcceptor(const FixTcpAcceptor&) = delete;
+    FixTcpAcceptor& operator=(const FixTcpAcceptor&) = delete;
+
+    // Avisos de abertura e fechamento de sessão, chamados nas threads de I/O (ex: para o
+    // ExecutionReportGateway escrever no socket). O fechamento é avisado antes do close(fd). Antes de start().
+    void setSessionHooks(std::function<void(uint64_t client_id, int fd)> on_open, std::function<void(uint64_t client_id)> on_close)
+    {
+        on_session_open_ = std::move(on_open);
+        on_session_close_ = std::move(on_close);
+    }
+
+    // Abre o socket de escuta e sobe as threads de I/O
+    bool start();
+    // Para as threads de I/O e fecha todas as sessões. Mensagens já lidas foram entregues à fila.
+    void stop();
+
+    uint16_t getPort() const { return port_; }
+    uint64_t sessionsAccepted() const { return sessions_accepted_.load(std::memory_order_relaxed); }
+    uint64_t messagesReceived() const { return messages_received_.load(std::memory_order_relaxed); }
+    uint64_t commandsQueued() const { return commands_queued_.load(std::memory_order_relaxed); }
+    uint64_t sequenceGaps() const { return sequence_gaps_.load(std::memory_order_relaxed); }
+    uint64_t duplicatesDropped() const { return duplicates_dropped_.load(std::memory_order_relaxed); }
+    uint64_t framingErrors() const { return framing_errors_.load(std::memory_order_relaxed); }
+
+    // Delimita a próxima mensagem completa em data. Retorna o tamanho dela (até o delimitador depois de 10=),
+    // 0 se ainda falta chegar o resto. 'skipped' recebe os bytes antes do 8= (lixo, contado como erro de framing).
+    static size_t frameMessage(std::string_view data, size_t& skipped);
+
+private:
+    struct Session
+    {
+        int fd = -1;
+        uint64_t client_id = 0;
+        std::string client_id_text;
+        uint64_t expected_seq = 1;
+        std::unique_ptr<char[]> buffer;
+        size_t begin = 0; // primeiro byte ainda não consumido
+        size_t end = 0;   // fim dos bytes lidos
+    };
+
+    struct IoThread
+    {
+        int index = 0;
+        int epoll_fd = -1;
+        int wake_fd = -1;
+        std::thread thread;
+        std::mutex sessions_mutex; // só aberturas e fechamentos; o caminho de leitura não o toca
+        std::unordered_map<int, std::unique_ptr<Session>> sessions;
+    };
+
+    void ioLoop(IoThread& io);
+    void acceptConnections();
+    // Lê até EAGAIN; retorna false se a sessão deve ser fechada
+    bool readSession(Session& session);
+    void processBuffer(Session& session);
+    bool checkSequence(Session& session, std::string_view message);
+    void closeSession(IoThread& io, Session& session);
+
+    static bool validChecksum(std::string_view message);
+
+    InboundGateway& gateway_;
+    FixAcceptorOptions options_;
+    int listen_fd_ = -1;
+    uint16_t port_ = 0;
+    std::atomic<bool> running_{false};
+    std::vector<std::unique_ptr<IoThread>> io_threads_;
+    std::function<void(uint64_t, int)> on_session_open_;
+    std::function<void(uint64_t)> on_session_close_;
+    size_t next_io_thread_ = 0;  // só a thread 0 (dona do socket de escuta) aceita conexões
+    uint64_t next_client_id_ = 0;
+
+    std::atomic<uint64_t> sessions_accepted_{0};
+    std::atomic<uint64_t> messages_received_{0};
+    std::atomic<uint64_t> commands_queued_{0};
+    std::atomic<uint64_t> sequence_gaps_{0};
+    std::atomic<uint64_t> duplicates_dropped_{0};
+    std::atomic<uint64_t> framing_errors_{0};
+};
+
+#endif // FIX_TCP_ACCEPTOR_HPP
@@ -2,27 +2,72 @@
 #define INBOUND_GATEWAY_HPP
 
 #include "messaging/commands/command.hpp"
+#include "messaging/events/event.hpp"
 #include "utils/thread_safe_queue.hpp" 
+#include "domain/pre_trade_risk.hpp"
+#include "messaging/shm_order_message.hpp"
 #include <string>
+#include <string_view>
 #include <memory>
 #include <map>
 #include <fstream> 
+#include <mutex>
+#include <vector>
 
 class InboundGateway 
 {
 public:
     explicit InboundGateway(ThreadSafeQueue<std::unique_ptr<Command>>& queue, const std::string& wal_file_path = "src/logs/write_ahead_log.log");
 
+    // Checagens pré-trade feitas antes de criar o comando (nullptr = sem checagens). O objeto é compartilhado
+    // pelas threads de cliente e deve viver mais que o gateway.
+    void setPreTradeRisk(PreTradeRisk* risk) { pre_trade_risk_ = risk; }
+
+    // Rejeições do risco viram OrderRejectedEvent (ordens) ou CancelRejectedEvent (cancels e amends) entregues
+    // direto nestas filas, sem passar pelo EventBusDispatcher, que é da thread da engine: a do Auditor e a dos
+    // execution reports (nullptr = não entrega). As filas aceitam várias threads produtoras.
+    void setRejectQueues(ThreadSafeQueue<Event>* event_queue, ThreadSafeQueue<Event>* report_queue)
+    {
+        reject_event_queue_ = event_queue;
+        reject_report_queue_ = report_queue;
+    }
+
     bool pushToQueue(std::unique_ptr<Command> commandPtr);
-    std::unique_ptr<Command> parseAndCreateCommand(const std::string& lines, const std::string& clientId, const std::chrono::system_clock::time_point& timestamp);
+    // Empurra os comandos de uma vez (um lock na fila) e esvazia o vetor
+    void pushBatchToQueue(std::vector<std::unique_ptr<Command>>& commands) { command_queue_.push_batch(commands); }
+    // Aceita '|' ou SOH como delimitador. A mensagem é lida no lugar (ex: direto do buffer de leitura de uma sessão TCP).
+    std::unique_ptr<Command> parseAndCreateCommand(std::string_view line, const std::string& clientId, const std::chrono::system_clock::time_point& timestamp);
+    // Mensagem do transporte binário em memória compartilhada: mesmas checagens de risco do caminho FIX,
+    // sem passar por texto. O send_timestamp_ns do cliente vira o intended timestamp do comando.
+    std::unique_ptr<Command> createCommandFromBinary(const ShmOrderMessage& message, uint64_t client_id, const std::chrono::system_clock::time_point& timestamp);
     std::unique_ptr<Command> createCommandFromFields(const std::map<std::string, std::string>& fields, const std::chrono::system_clock::time_point& timestamp);
 
 private:
     ThreadSafeQueue<std::unique_ptr<Command>>& command_queue_;
     std::string wal_file_path_;
     std::ofstream wal_file_;
+    std::mutex wal_mutex_; // Várias threads de cliente escrevem no mesmo WAL
+    PreTradeRisk* pre_trade_risk_ = nullptr;
+    ThreadSafeQueue<Event>* reject_event_queue_ = nullptr;
+    ThreadSafeQueue<Event>* reject_report_queue_ = nullptr;
+
+    // Retorna false (e loga o motivo) se o risco rejeitou a mensagem
+    bool passesRisk(RiskRejectReason reason, const char* message, uint64_t client_id, uint64_t client_order_id) const;
+    // Como passesRisk, e na rejeição publica a resposta ao cliente: 35=8 Rejected para uma ordem nova,
+    // 35=9 para um cancel ou amend
+    bool passesOrderRisk(RiskRejectReason reason, uint64_t client_id, uint64_t client_order_id, const std::string& symbol, OrderSide side,
+                         uint32_t quantity, double price, const std::chrono::system_clock::time_point& timestamp);
+    bool passesCancelRisk(RiskRejectReason reason, CancelRejectedEvent::ResponseTo response_to, uint64_t client_id, uint64_t client_order_id,
+                          uint64_t orig_client_order_id, const std::string& symbol, const std::chrono::system_clock::time_point& timestamp);
+    void publishReject(const Event& event);
+
+    void writeAheadLog(std::string_view log_message);
+    std::unique_ptr<Command> createNewOrderCommand(const std::map<std::string, std::string>& fields, const std::chrono::system_clock::time_point& timestamp);
+    std::unique_ptr<Command> createAmendOrderCommand(const std::map<std::string, std::string>& fields, const std::chrono::system_clock::time_point& timestamp);
+    std::unique_ptr<Command> createCancelOrderCommand(const std::map<std::string, std::string>& fields, const std::chrono::system_clock::time_point& timestamp);
 
-    void writeAheadLog(const std::string& log_message);
+    // Converte um UTCTimestamp do FIX (YYYYMMDD-HH:MM:SS[.sss]); lança std::invalid_argument se o formato for inválido
+    static std::chrono::system_clock::time_point parseUtcTimestamp(const std::string& value);
 };
 
 #endif // INBOUND_GATEWAY_HPP
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef MARKET_DATA_GATEWAY_HPP
 #define MARKET_DATA_GATEWAY_HPP
 
+#include "domain/multicast_market_data_publisher.hpp"
 #include "utils/market_data_channel.hpp"
 #include <string>
 #include <fstream>
@@ -9,13 +10,17 @@ class MarketDataGateway {
 public:
     explicit MarketDataGateway(MarketDataChannel& channel, const std::string& output_file_path = "src/logs/market_data.log");
     bool initialize();
+    // Com um publicador, cada snapshot também sai no feed multicast (antes da linha JSON) e a thread do gateway
+    // manda os ciclos do canal de snapshot. Deve ser chamado antes de run().
+    void setMulticastPublisher(MulticastMarketDataPublisher* publisher) { publisher_ = publisher; }
     void run();
+    std::string formatSnapshotToJSON(const Event& event);
 
 private:
-    std::string formatSnapshotToJSON(const Event& event);
     MarketDataChannel& channel_;
     std::string output_file_path_;
     std::ofstream output_file_;
+    MulticastMarketDataPublisher* publisher_ = nullptr;
 };
 
 #endif // MARKET_DATA_GATEWAY_HPP
\ No newline at end of file
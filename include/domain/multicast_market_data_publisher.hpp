@@ -0,0 +1,79 @@
+#ifndef MULTICAST_MARKET_DATA_PUBLISHER_HPP
+#define MULTICAST_MARKET_DATA_PUBLISHER_HPP
+
+#include "messaging/events/book_snapshot_event.hpp"
+#include "messaging/market_data_feed.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Publica os livros por UDP multicast no formato de market_data_feed. Cada BookSnapshotEvent é comparado com o
+// último top-N publicado do símbolo e só os níveis que mudaram viram FeedLevelUpdates sequenciados, acumulados
+// no datagrama corrente até ele encher ou flush() ser chamado. Em intervalos fixos publishSnapshots() manda o
+// top-N de todos os símbolos no canal de snapshot, marcado com a última sequência incremental; um assinante que
+// perdeu pacotes se ressincroniza sozinho com esse canal, sem pedir nada à engine.
+//
+// Roda na thread do MarketDataGateway, que é a única a chamar os métodos (não é thread-safe).
+class MulticastMarketDataPublisher
+{
+public:
+    explicit MulticastMarketDataPublisher(const MulticastFeedOptions& options);
+    ~MulticastMarketDataPublisher();
+
+    MulticastMarketDataPublisher(const MulticastMarketDataPublisher&) = delete;
+    MulticastMarketDataPublisher& operator=(const MulticastMarketDataPublisher&) = delete;
+
+    // Cria os sockets dos dois canais. Retorna false (com o erro no stderr) se o multicast não puder ser configurado.
+    bool open();
+    void close();
+    bool isOpen() const { return incremental_fd_ >= 0; }
+
+    // Gera as atualizações de nível do snapshot em relação ao último estado publicado do símbolo
+    void publish(const BookSnapshotEvent& snapshot);
+    // Envia o datagrama incremental parcial, se houver
+    void flush();
+
+    // Manda o top-N de todos os símbolos no canal de snapshot e agenda o próximo ciclo
+    void publishSnapshots();
+    std::chrono::steady_clock::time_point nextSnapshotTime() const { return next_snapshot_time_; }
+
+    uint64_t getLastSequence() const { return sequence_; }
+    uint64_t updatesPublished() const { return updates_published_; }
+    uint64_t packetsSent() const { return packets_sent_; }
+    uint64_t snapshotPacketsSent() const { return snapshot_packets_sent_; }
+    uint64_t sendErrors() const { return send_errors_; }
+
+private:
+    using Levels = BookSnapshotEvent::Levels;
+
+    struct PublishedBook
+    {
+        Levels bids;
+        Levels asks;
+    };
+
+    void diffSide(const std::string& symbol, OrderSide side, const Levels& previous, const Levels& current);
+    void appendUpdate(const std::string& symbol, OrderSide side, double price, uint64_t quantity);
+    bool sendPacket(int fd, const char* data, size_t length);
+    static int openSocket(const MulticastFeedOptions& options, const std::string& group, uint16_t port);
+
+    MulticastFeedOptions options_;
+    int incremental_fd_ = -1;
+    int snapshot_fd_ = -1;
+
+    std::unordered_map<std::string, PublishedBook> books_;
+    // Datagrama incremental em montagem: header + até kUpdatesPerPacket registros
+    alignas(8) char packet_[market_data_feed::kMaxDatagramBytes];
+    size_t packet_updates_ = 0;
+    uint64_t sequence_ = 0;
+    std::chrono::steady_clock::time_point next_snapshot_time_;
+
+    uint64_t updates_published_ = 0;
+    uint64_t packets_sent_ = 0;
+    uint64_t snapshot_packets_sent_ = 0;
+    uint64_t send_errors_ = 0;
+};
+
+#endif // MULTICAST_MARKET_DATA_PUBLISHER_HPP
@@ -2,6 +2,7 @@
 #define ORDER_HPP
 
 #include "types/order_params.hpp"
+#include "utils/id_generator.hpp"
 #include <string>
 #include <chrono>
 #include <cstdint>
@@ -15,8 +16,9 @@ public:
 	      OrderTimeInForce time_in_force, OrderCapacity capacity, 
 		  const std::chrono::system_clock::time_point& received_timestamp);
 
-    static uint64_t getNextOrderId(){ return next_order_id_++; };
-	static void resetOrderIdCounter() { next_order_id_ = 1; }
+    // Gerador por thread, no shard de IdGenerator::threadShard(): sem atômicos fora da reserva de blocos
+    static uint64_t getNextOrderId();
+    static IdBlockAllocator& getIdAllocator() { return id_allocator_; }
 	uint64_t getOrderId() const { return order_id_; }
 	uint64_t getClientId() const { return client_id_; }
 	uint64_t getClientOrderId() const { return client_order_id_; }
@@ -32,6 +34,13 @@ public:
 	OrderTimeInForce getTimeInForce() const { return time_in_force_; }
 	OrderCapacity getCapacity() const { return capacity_; }
 	const std::chrono::system_clock::time_point& getReceivedTimestamp() const { return received_timestamp_; }
+	double getStopPrice() const { return stop_price_; }
+	double getTrailingOffset() const { return trailing_offset_; }
+	void setStopPrice(double stop_price) { stop_price_ = stop_price; }
+	void setTrailingOffset(double trailing_offset) { trailing_offset_ = trailing_offset; }
+	const std::chrono::system_clock::time_point& getExpireTime() const { return expire_time_; }
+	void setExpireTime(const std::chrono::system_clock::time_point& expire_time) { expire_time_ = expire_time; }
+	bool isStopOrder() const { return type_ == OrderType::Stop || type_ == OrderType::StopLimit || type_ == OrderType::TrailingStop; }
 	double getAveragePrice() const { return filled_quantity_ > 0 ? total_filled_value_ / filled_quantity_ : 0.0; }
 
 	bool isFilled() const { return status_ == OrderStatus::Filled; }
@@ -39,6 +48,16 @@ public:
 	bool isNew() const { return status_ == OrderStatus::New; }
 
 	bool applyFill(uint32_t filled_quantity, double filled_price);
+	bool cancel();
+	bool expire();
+
+	// Dispara uma ordem stop: Stop e TrailingStop viram Market e StopLimit vira Limit no próprio preço limite.
+	// Retorna false se a ordem não for do tipo stop.
+	bool trigger();
+
+	// Aplica um cancel/replace: new_quantity é a nova quantidade total (FIX tag 38), então o restante
+	// passa a ser new_quantity - filled. Retorna false se a nova quantidade não for maior que o já executado.
+	bool amend(uint64_t new_client_order_id, uint32_t new_quantity, double new_price);
 	
 private:
 	void setFilledQuantity(uint32_t filled_quantity) { filled_quantity_ = filled_quantity; }
@@ -46,7 +65,7 @@ private:
 	void setRemainingQuantity(uint32_t quantity) { remaining_quantity_ = quantity; }
 	void setOrderStatus(OrderStatus status) { status_ = status; }
 
-    static uint64_t next_order_id_; 
+    static IdBlockAllocator id_allocator_;
 	uint64_t order_id_;
 	uint64_t client_id_;
 	uint64_t client_order_id_;
@@ -62,6 +81,9 @@ private:
     OrderTimeInForce time_in_force_;
     OrderCapacity capacity_;
     std::chrono::system_clock::time_point received_timestamp_;
+    double stop_price_ = 0.0;       // FIX tag 99 (StopPx)
+    double trailing_offset_ = 0.0;  // distância do trailing stop ao melhor preço negociado desde a entrada
+    std::chrono::system_clock::time_point expire_time_{};  // FIX tag 126 (ExpireTime), só para GoodTillDate
 };
 
 #endif // ORDER_HPP
\ No newline at end of file
@@ -2,23 +2,356 @@
 #define ORDER_BOOK_HPP
 
 #include "domain/order.hpp"
+#include "domain/client_order_key.hpp"
+#include "domain/trigger_book.hpp"
 #include <map>
 #include <list>
 #include <cstdint>
 #include <memory> 
 #include <unordered_map> 
 #include <functional> 
+#include <limits>
+#include <vector>
+#include <scoped_allocator>
+#include "domain/symbol_table.hpp"
+#include "utils/memory_arena.hpp"
+#include "utils/seqlock.hpp"
 
-using OrderIterator = std::list<std::shared_ptr<Order>>::iterator;
+// Todos os containers do livro tiram seus nós da arena do livro (ou do heap, se o livro não tiver arena).
+// Os mapas de níveis usam scoped_allocator_adaptor para que a FIFO de cada nível herde a mesma arena.
+using LevelOrders = std::list<std::shared_ptr<Order>, ArenaAllocator<std::shared_ptr<Order>>>;
+using OrderIterator = LevelOrders::iterator;
+
+// Um nível de preço: a FIFO das ordens (cabeça/cauda e contagem vêm da própria lista) e a quantidade restante
+// somada do nível. Como a profundidade mora no mesmo nó da árvore que a FIFO, cada mutação do livro toca um nó
+// só, e os snapshots leem a profundidade direto daqui. O nível sai da árvore quando a FIFO esvazia.
+struct BookLevel
+{
+    using allocator_type = LevelOrders::allocator_type;
+
+    explicit BookLevel(const allocator_type& allocator) : orders(allocator) {}
+
+    size_t orderCount() const { return orders.size(); }
+
+    LevelOrders orders;
+    uint64_t total_quantity = 0;
+};
+
+// Prioridade de preço de cada lado, fixada em tempo de compilação: na compra o melhor preço é o maior, na venda
+// o menor. Todo o código que depende do lado compara preços com este comparador em vez de testar o OrderSide.
+template<OrderSide Side>
+struct SidePriority;
+
+template<>
+struct SidePriority<OrderSide::Buy>
+{
+    using Compare = std::greater<double>;
+};
+
+template<>
+struct SidePriority<OrderSide::Sell>
+{
+    using Compare = std::less<double>;
+};
+
+template<OrderSide Side>
+using SideLevels = std::map<double, BookLevel, typename SidePriority<Side>::Compare,
+                            std::scoped_allocator_adaptor<ArenaAllocator<std::pair<const double, BookLevel>>>>;
+using BidLevels = SideLevels<OrderSide::Buy>;
+using AskLevels = SideLevels<OrderSide::Sell>;
+
+// Posição completa de uma ordem no livro: o nível de preço (apenas o iterador do lado da ordem é válido)
+// e o nó na FIFO do nível. Com ela a remoção é O(1) e não precisa procurar o preço na árvore de novo.
+struct OrderLocation
+{
+    BidLevels::iterator bid_level;
+    AskLevels::iterator ask_level;
+    OrderIterator order;
+
+    // Iterador do nível no lado 'Side', escolhido em tempo de compilação
+    template<OrderSide Side>
+    typename SideLevels<Side>::iterator& level()
+    {
+        if constexpr (Side == OrderSide::Buy) return bid_level;
+        else return ask_level;
+    }
+    template<OrderSide Side>
+    typename SideLevels<Side>::iterator level() const
+    {
+        if constexpr (Side == OrderSide::Buy) return bid_level;
+        else return ask_level;
+    }
+};
+
+using OrderIndex = std::unordered_map<ClientOrderKey, OrderLocation, ClientOrderKeyHash, std::equal_to<ClientOrderKey>,
+                                      ArenaAllocator<std::pair<const ClientOrderKey, OrderLocation>>>;
+
+// Uma execução produzida pelo sweep: preço/quantidade e o estado das duas ordens logo após o fill
+struct Fill
+{
+    std::shared_ptr<Order> passive_order;
+    double price;
+    uint32_t quantity;
+    uint32_t passive_remaining;
+    OrderStatus passive_status;
+    uint32_t aggressive_remaining;
+    OrderStatus aggressive_status;
+};
+
+// Fase de negociação do livro. Em Continuous cada ordem casa ao chegar; em Auction (abertura/fechamento) as ordens
+// limitadas só acumulam, o livro pode ficar cruzado e tudo executa de uma vez no descruzamento (uncross).
+enum class TradingPhase : uint8_t
+{
+    Continuous,
+    Auction
+};
+
+// Execução de um leilão: não há agressor, as duas pontas são ordens que estavam no livro. Os estados são os de
+// logo após o fill, como em Fill.
+struct AuctionFill
+{
+    std::shared_ptr<Order> buy_order;
+    std::shared_ptr<Order> sell_order;
+    uint32_t quantity;
+    uint32_t buy_remaining;
+    OrderStatus buy_status;
+    uint32_t sell_remaining;
+    OrderStatus sell_status;
+};
+
+// Preço de equilíbrio de um leilão: o preço único que maximiza o volume executável. Empates são decididos pelo
+// menor desequilíbrio e depois pela proximidade do preço de referência (último trade, ou o meio da faixa cruzada).
+struct AuctionResult
+{
+    bool crossed = false;   // false: o livro não cruza, não há o que executar
+    double price = 0.0;
+    uint64_t volume = 0;    // quantidade executada (ou executável) ao preço
+    int64_t imbalance = 0;  // compra - venda elegíveis ao preço; positivo sobra compra
+    size_t trades = 0;      // execuções geradas pelo uncross (0 no cálculo indicativo)
+};
+
+// Grade de preços do cálculo do leilão: os preços distintos dos dois lados dentro da faixa cruzada, em ordem
+// crescente, com a quantidade de cada lado e os acumulados alinhados pelo mesmo índice. Os vetores são
+// reaproveitados entre leilões.
+struct AuctionGrid
+{
+    std::vector<double> prices;
+    std::vector<uint64_t> bid_quantity;
+    std::vector<uint64_t> ask_quantity;
+    std::vector<uint64_t> demand;      // compra com preço >= prices[i]
+    std::vector<uint64_t> supply;      // venda com preço <= prices[i]
+    std::vector<uint64_t> executable;  // min(demand, supply)
+};
+
+// Profundidade acumulada dos N melhores níveis de um lado, usada pelo pré-check de FOK. É reconstruída
+// sob demanda e só é invalidada quando uma mudança cai dentro dos níveis que ela cobre.
+struct DepthPrefix
+{
+    std::vector<double> prices;
+    std::vector<uint64_t> cumulative;
+    bool dirty = true;
+};
+
+// Melhor compra e melhor venda do livro: preço, quantidade total e número de ordens do nível do topo.
+// Um lado vazio tem orders == 0 (e preço/quantidade zerados).
+struct TopOfBook
+{
+    double bid_price = 0.0;
+    uint64_t bid_quantity = 0;
+    uint32_t bid_orders = 0;
+    double ask_price = 0.0;
+    uint64_t ask_quantity = 0;
+    uint32_t ask_orders = 0;
+
+    bool hasBid() const { return bid_orders > 0; }
+    bool hasAsk() const { return ask_orders > 0; }
+
+    bool operator==(const TopOfBook& other) const
+    {
+        return bid_price == other.bid_price && bid_quantity == other.bid_quantity && bid_orders == other.bid_orders &&
+               ask_price == other.ask_price && ask_quantity == other.ask_quantity && ask_orders == other.ask_orders;
+    }
+};
+
+// Top-N de profundidade que o livro publica para leitores de outras threads (risco, consultas, dashboards).
+// Tamanho fixo e trivialmente copiável, para ser publicado por seqlock sem alocação.
+struct BookDepthView
+{
+    static constexpr size_t kMaxLevels = 10;
+
+    struct Level
+    {
+        double price;
+        uint64_t quantity;
+        uint32_t orders;
+        uint32_t reserved;
+    };
+
+    uint64_t version = 0;          // publicações do livro; a mesma versão em duas leituras = nada mudou
+    uint32_t bid_count = 0;
+    uint32_t ask_count = 0;
+    double last_trade_price = 0.0; // 0 antes do primeiro trade
+    Level bids[kMaxLevels] = {};
+    Level asks[kMaxLevels] = {};
+};
+
+// Um lado do livro: a árvore de níveis na prioridade do lado, a free list de níveis esvaziados e o prefixo de
+// profundidade do pré-check de FOK. Compra e venda são instâncias do mesmo código: as comparações de preço vêm
+// do comparador do lado, inlined em cada instância, e nenhum caminho testa o lado em tempo de execução.
+template<OrderSide Side>
+class BookSide
+{
+public:
+    using Levels = SideLevels<Side>;
+    using Compare = typename SidePriority<Side>::Compare;
+
+    // Limite de uma ordem a mercado contra este lado: alcança qualquer nível
+    static constexpr double kUnlimited = Side == OrderSide::Sell ? std::numeric_limits<double>::infinity()
+                                                                 : -std::numeric_limits<double>::infinity();
+
+    // 'price' está em 'bound' ou antes dele na prioridade do lado (compra: >=, venda: <=). Com 'bound' sendo o
+    // limite de uma ordem agressiva do lado oposto, diz se o nível a 'price' cruza com ela.
+    static bool notWorse(double price, double bound) { return !Compare{}(bound, price); }
+
+    explicit BookSide(const typename Levels::allocator_type& allocator) : levels_(allocator) {}
+
+    Levels& levels() { return levels_; }
+    const Levels& levels() const { return levels_; }
+
+    // Nível do preço: o existente, um nó da free list (sem alocar) ou, com a lista vazia, um nó novo
+    typename Levels::iterator acquireLevel(double price);
+    // Tira da árvore um nível cuja FIFO esvaziou; o nó vai para a free list enquanto ela tiver espaço
+    void releaseLevel(typename Levels::iterator level);
+    void setLevelPoolCapacity(size_t levels);
+    uint64_t getLevelCreations() const { return level_creations_; }
+    uint64_t getLevelReuses() const { return level_reuses_; }
+
+    // Prefixo de profundidade dos 'levels' melhores níveis (0 = desligado)
+    void setDepthPrefixLevels(size_t levels);
+    // Marca o prefixo como sujo se 'price' estiver dentro dos níveis cobertos
+    void invalidateDepthPrefix(double price);
+    void markDepthPrefixDirty() { prefix_.dirty = true; }
+    // Indica se os níveis que cruzam com 'limit' somam ao menos 'needed'
+    bool hasLiquidity(double limit, uint64_t needed) const;
+
+    // O melhor nível cruza com uma ordem do lado oposto limitada a 'limit'
+    bool crossedBy(double limit) const { return !levels_.empty() && notWorse(levels_.begin()->first, limit); }
+    // Uma mudança em 'price' aparece num snapshot com 'depth' níveis deste lado
+    bool affectsTopLevels(double price, size_t depth) const;
+
+    // Relê o melhor nível (begin() da árvore é O(1)) nos campos do lado no BBO
+    void refreshTop(TopOfBook& top) const;
+    // Copia até 'depth' níveis do topo para 'out' e retorna quantos foram copiados
+    uint32_t copyTopLevels(BookDepthView::Level* out, size_t depth) const;
+
+private:
+    Levels levels_;
+
+    // Quando o último pedido de um preço sai, o nó do nível (com a FIFO já vazia) é extraído da árvore e guardado
+    // aqui em vez de liberado; o próximo preço novo do lado reaproveita o nó só trocando a chave. Preços oscilando
+    // em volta do topo deixam de fazer malloc/free a cada volta. A lista é LIFO: o nível reaproveitado é o último
+    // a esvaziar, normalmente perto do topo e ainda no cache.
+    std::vector<typename Levels::node_type> free_levels_;
+    size_t level_pool_capacity_ = 0;
+    uint64_t level_creations_ = 0;
+    uint64_t level_reuses_ = 0;
+
+    // Prefixo do pré-check de FOK (mutable: é cache, reconstruído dentro de hasLiquidity, que é const)
+    size_t depth_prefix_levels_ = 0;
+    mutable DepthPrefix prefix_;
+};
+
+// Resultado de um amend (35=G) aplicado ao livro
+struct AmendOutcome
+{
+    enum class Result
+    {
+        Amended,
+        UnknownOrder,
+        InvalidQuantity,
+        DuplicateClientOrderId
+    };
+
+    Result result;
+    std::shared_ptr<Order> order;   // a ordem já alterada (nullptr se o amend foi rejeitado)
+    double previous_price = 0.0;
+    bool kept_priority = false;     // true quando o amend foi só uma redução de quantidade no mesmo preço
+};
 
 class OrderBook 
 {
 public:
-    OrderBook(const std::string& symbol);
+    // Sem arena os containers usam o heap; com ela, a arena precisa viver mais que o livro
+    explicit OrderBook(const std::string& symbol, MemoryArena* arena = nullptr);
     ~OrderBook() = default;
 
+    // Retorna false se o cliente já tiver uma ordem viva com o mesmo ClOrdID
     bool addOrder(std::shared_ptr<Order> order);
-    bool removeOrder(uint64_t orderId);
+
+    // Remove a ordem em O(1) (um probe no índice + unlink da FIFO) e retorna o ponteiro para ela,
+    // ou nullptr se ela não estiver no livro. A quantidade restante sai do agregado do nível.
+    std::shared_ptr<Order> removeOrder(uint64_t client_id, uint64_t client_order_id);
+
+    // Altera a ordem (client_id, orig_client_order_id) sem removê-la do livro. Uma redução de quantidade no
+    // mesmo preço só ajusta a quantidade restante e o agregado do nível (mantém a prioridade). Uma mudança
+    // de preço ou aumento de quantidade move o nó da FIFO para o fim do nível de destino com splice (O(1),
+    // sem realocação). Depois do amend a ordem passa a ser indexada pelo novo ClOrdID.
+    AmendOutcome amendOrder(uint64_t client_id, uint64_t orig_client_order_id, uint64_t new_client_order_id,
+                            uint32_t new_quantity, double new_price);
+
+    // Consome o lado oposto nível a nível, percorrendo a FIFO de cada nível diretamente, até a ordem agressiva
+    // acabar ou o próximo nível deixar de cruzar (ordens Market não têm limite). O agregado de cada nível é
+    // atualizado uma vez por nível e os níveis esvaziados saem da árvore para a free list do lado.
+    // As execuções são anexadas em 'fills' (o chamador reaproveita o vetor); custo O(ordens tocadas).
+    void sweep(Order& aggressive_order, std::vector<Fill>& fills);
+
+    // Pré-check de Fill-or-Kill: indica se o lado oposto tem, dentro do limite da ordem, quantidade agregada
+    // suficiente para executá-la inteira. Não altera o livro. Sem o prefixo de profundidade anda nível a
+    // nível (O(níveis que cruzam)); com ele, resolve por busca binária nos N melhores níveis.
+    bool hasLiquidityFor(const Order& order) const;
+
+    // Liga (levels > 0) ou desliga o prefixo de profundidade mantido sobre os 'levels' melhores níveis de cada lado
+    void setDepthPrefixLevels(size_t levels);
+
+    // Quantos níveis esvaziados cada lado guarda para reaproveitar (0 = todo nível vazio é liberado na hora)
+    static constexpr size_t kDefaultLevelPoolCapacity = 64;
+    void setLevelPoolCapacity(size_t levels);
+    // Níveis de preço criados com alocação e níveis tirados da free list desde a criação do livro
+    uint64_t getLevelCreations() const { return bids_.getLevelCreations() + asks_.getLevelCreations(); }
+    uint64_t getLevelReuses() const { return bids_.getLevelReuses() + asks_.getLevelReuses(); }
+
+    // Fase de negociação. O livro só registra a fase; quem deixa de casar durante o leilão é a engine.
+    void setTradingPhase(TradingPhase phase) { phase_ = phase; }
+    TradingPhase getTradingPhase() const { return phase_; }
+    bool inAuction() const { return phase_ == TradingPhase::Auction; }
+
+    // Preço de equilíbrio indicativo do livro como está agora, sem alterá-lo. O custo é O(níveis na faixa cruzada):
+    // a demanda e a oferta acumuladas saem de somas de prefixo sobre vetores contíguos da grade de preços.
+    AuctionResult computeAuctionPrice() const;
+
+    // Executa tudo o que cruza ao preço de equilíbrio: compras e vendas elegíveis são casadas em prioridade de
+    // preço e tempo numa única passada pelas FIFOs, e os níveis consumidos saem da árvore para a free list.
+    // As execuções são anexadas em 'fills', reservado uma vez pelo número de ordens elegíveis. Não muda a fase.
+    AuctionResult uncross(std::vector<AuctionFill>& fills);
+
+    // Indica se esta ordem (o mesmo objeto, não só o mesmo ClOrdID) está descansando no livro
+    bool isResting(const Order& order) const;
+
+    // Indica se o cliente tem uma ordem viva com este ClOrdID descansando no livro
+    bool containsOrder(uint64_t client_id, uint64_t client_order_id) const;
+
+    // Ordens stop ainda não disparadas deste símbolo (não aparecem no livro nem nos snapshots)
+    TriggerBook& getTriggerBook() { return trigger_book_; }
+
+    // Preço do último trade executado neste livro; só é válido quando hasTraded() é true
+    bool hasTraded() const { return has_traded_; }
+    double getLastTradePrice() const { return last_trade_price_; }
+
+    // Indica se a ordem cruzaria com o melhor preço do lado oposto
+    bool isMarketable(const Order& order) const;
+
+    // Indica se uma mudança em 'price' aparece num snapshot com 'depth' níveis do lado informado
+    bool affectsTopLevels(OrderSide side, double price, size_t depth) const;
 
     void printOrders() const;
     void printBids() const;
@@ -26,38 +359,80 @@ public:
     void printTopAsk() const;
     void printTopBid() const;
 
-    std::shared_ptr<Order> getTopBid();
-    std::shared_ptr<Order> getTopAsk();
+    // Primeira ordem (prioridade de tempo) do melhor nível de cada lado, ou nullptr se o lado estiver vazio
+    std::shared_ptr<Order> getTopBid() const;
+    std::shared_ptr<Order> getTopAsk() const;
+
+    // BBO mantido a cada mutação do livro; leitura O(1), sem tocar na árvore
+    const TopOfBook& getTopOfBook() const { return top_of_book_; }
+
+    // Número de BBOs entregues por takeTopOfBookChange (sequência dos BboEvents do símbolo)
+    uint64_t getTopOfBookSequence() const { return top_sequence_; }
+
+    // Indica se o BBO mudou desde a última chamada que retornou true (usado pela engine para publicar o BBO
+    // uma vez por comando, e só quando o topo realmente mudou)
+    bool takeTopOfBookChange();
+    // Publica o top-'depth' atual (até BookDepthView::kMaxLevels por lado). Só a thread dona do livro chama;
+    // a escrita nunca espera pelos leitores.
+    void publishDepthView(size_t depth);
+    // Cópia consistente da última publicação, de qualquer thread e sem lock (o leitor só repete a cópia se
+    // cruzar com uma publicação em andamento)
+    BookDepthView readDepthView() const { return depth_view_.load(); }
+
     const std::string& getSymbol() const { return symbol_; }
+    // Id do símbolo na SymbolTable, o que os eventos do livro carregam
+    SymbolId getSymbolId() const { return symbol_id_; }
     
-    const std::map<double, std::list<std::shared_ptr<Order>>, std::greater<double>>& getBids() const { return bids_; }
-    const std::map<double, std::list<std::shared_ptr<Order>>>& getAsks() const { return asks_; }
-    const std::unordered_map<uint64_t, OrderIterator>& getOrderIdMap() const { return order_id_map_; }
-
-    const std::map<double, uint64_t, std::greater<double>>& getAggregatedBids() const { return aggregated_bids_; }
-    const std::map<double, uint64_t>& getAggregatedAsks() const { return aggregated_asks_; }
-    void updateAggregatedQuantity(OrderSide side, double price, uint32_t quantity);
+    const BidLevels& getBids() const { return bids_.levels(); }
+    const AskLevels& getAsks() const { return asks_.levels(); }
+    const OrderIndex& getOrderIndex() const { return order_index_; }
 
 private:
+    // Os métodos públicos testam o lado da ordem uma vez e seguem por uma destas instâncias, que só conhecem o
+    // seu lado (no sweep, o lado passivo)
+    template<OrderSide Side>
+    void addToSide(BookSide<Side>& book_side, OrderLocation& location, std::shared_ptr<Order> order);
+    template<OrderSide Side>
+    void removeFromSide(BookSide<Side>& book_side, const OrderLocation& location, const Order& order);
+    // Retorna true se o amend manteve a prioridade (redução de quantidade no mesmo preço)
+    template<OrderSide Side>
+    bool amendOnSide(BookSide<Side>& book_side, OrderLocation& indexed, const OrderLocation& previous, double old_price,
+                     uint32_t old_remaining, double new_price, uint32_t new_remaining);
+    template<OrderSide Side>
+    void sweepSide(Order& aggressive_order, BookSide<Side>& passive_side, std::vector<Fill>& fills);
+
     // Simbolo do book, por exemplo "AAPL", "GOOGL", etc.
     std::string symbol_;
+    SymbolId symbol_id_;
 
     // A ideia é termos uma estrutura de dados que permita acesso rápido às ordens por preço e por ID
     // Cada preço vai categorizar um nível e cada nível de preço vai conter uma lista de ordens
     // Dessa forma somos capazes de organizar a ordem por prioridade de preço e também de tempo (inserção na lista)
-    std::map<double, std::list<std::shared_ptr<Order>>, std::greater<double>> bids_;
-    std::map<double, std::list<std::shared_ptr<Order>>> asks_;
+    // O nível também guarda a quantidade total, então quando quisermos retornar um book para o MarketDataGateway
+    // não precisamos iterar pela lista de ordens de cada nível
+    BookSide<OrderSide::Buy> bids_;
+    BookSide<OrderSide::Sell> asks_;
 
     // Para não termos que iterar pela lista de ordens nos níveis dos preços, temos essa segunda estrutura
-    // Ela serve para buscarmos o iterador de uma ordem específica usando o ID da ordem
-    // O iterador aponta para uma posicao na lista de ordens no nível de preço, dessa forma podemos remover a ordem rapidamente
-    std::unordered_map<uint64_t, OrderIterator> order_id_map_;
-
-    // Mapeia um preço diretamente para a quantidade total naquele preço. Serve como um snapshot do livro
-    // Dessa forma, não precisamos iterar pela lista de ordens para saber a quantidade total naquele nível de preço
-    // Quando quisermos retornar um book para o MarketDataGateway, podemos usar esses mapas agregados
-    std::map<double, uint64_t, std::greater<double>> aggregated_bids_;
-    std::map<double, uint64_t> aggregated_asks_;
+    // Ela serve para buscarmos a posição de uma ordem específica usando a chave (cliente, ClOrdID)
+    // A posição guarda o nível e o nó na lista, dessa forma podemos remover a ordem sem nenhuma outra busca
+    OrderIndex order_index_;
+
+    TopOfBook top_of_book_;
+    TopOfBook published_top_;
+    uint64_t top_sequence_ = 0;
+
+    TriggerBook trigger_book_;
+    double last_trade_price_ = 0.0;
+    bool has_traded_ = false;
+
+    TradingPhase phase_ = TradingPhase::Continuous;
+    // Cache de trabalho do cálculo do leilão (mutable: preenchido dentro de computeAuctionPrice, que é const)
+    mutable AuctionGrid auction_grid_;
+
+    // Profundidade publicada para as outras threads e o número de publicações feitas
+    SeqLock<BookDepthView> depth_view_;
+    uint64_t depth_view_version_ = 0;
 };
 
 #endif // ORDER_BOOK_HPP
\ No newline at end of file
@@ -0,0 +1,107 @@
+#ifndef PRE_TRADE_RISK_HPP
+#define PRE_TRADE_RISK_HPP
+
+#include "types/order_params.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Limites de um cliente. Zero desliga o limite correspondente.
+struct RiskLimits
+{
+    uint32_t max_order_quantity = 0;
+    double max_order_notional = 0.0;     // quantidade * preço (ordens a mercado usam o preço de referência)
+    uint32_t max_open_orders = 0;        // ordens aceitas pelo gateway que ainda não terminaram na engine
+    uint32_t max_messages_per_second = 0;
+    uint32_t price_band_bps = 0;         // distância máxima do último trade do símbolo, em basis points
+};
+
+enum class RiskRejectReason : uint8_t
+{
+    None,
+    UnknownSymbol,
+    InvalidSide,
+    InvalidQuantity,
+    InvalidPrice,
+    MaxOrderQuantity,
+    MaxOrderNotional,
+    PriceBand,
+    MaxOpenOrders,
+    MessageRate,
+    TooManyClients
+};
+
+// Checagens pré-trade feitas nas threads do gateway, antes de a mensagem virar comando e ocupar a fila da engine.
+// O estado por cliente fica numa tabela de tamanho fixo, um slot por linha de cache, atualizado só com atômicos
+// relaxed: clientes em threads diferentes não disputam nem o mesmo lock nem a mesma linha. Os contadores são
+// aproximados sob concorrência do mesmo cliente (ex: a virada da janela de taxa), o que basta para limites de risco.
+//
+// Símbolos e limites por cliente são registrados antes do tráfego começar; depois disso só os contadores mudam.
+// A engine devolve as ordens abertas (releaseOpenOrder) e publica o último trade (updateReferencePrice).
+class PreTradeRisk
+{
+public:
+    static constexpr size_t kMaxClients = 4096;
+
+    explicit PreTradeRisk(const RiskLimits& default_limits = RiskLimits{});
+
+    // Configuração (antes de qualquer thread de gateway começar)
+    void addSymbol(const std::string& symbol);
+    bool hasSymbol(const std::string& symbol) const { return symbols_.find(symbol) != symbols_.end(); }
+    bool setClientLimits(uint64_t client_id, const RiskLimits& limits);
+    const RiskLimits& getDefaultLimits() const { return default_limits_; }
+
+    // Threads do gateway. Uma nova ordem aprovada passa a contar como aberta para o cliente.
+    RiskRejectReason checkNewOrder(uint64_t client_id, const std::string& symbol, OrderSide side, OrderType type,
+                                   uint32_t quantity, double price, double stop_price,
+                                   const std::chrono::system_clock::time_point& timestamp);
+    RiskRejectReason checkAmend(uint64_t client_id, const std::string& symbol, OrderSide side, uint32_t new_quantity,
+                                double new_price, const std::chrono::system_clock::time_point& timestamp);
+    RiskRejectReason checkCancel(uint64_t client_id, const std::string& symbol, OrderSide side,
+                                 const std::chrono::system_clock::time_point& timestamp);
+
+    // Thread da engine
+    void releaseOpenOrder(uint64_t client_id);
+    void updateReferencePrice(const std::string& symbol, double price);
+
+    uint32_t getOpenOrders(uint64_t client_id) const;
+    uint64_t getRejectedCount(uint64_t client_id) const;
+    double getReferencePrice(const std::string& symbol) const;
+
+    static const char* reasonName(RiskRejectReason reason);
+
+private:
+    struct alignas(64) ClientState
+    {
+        std::atomic<uint64_t> key{0};            // client_id + 1; 0 = slot livre
+        std::atomic<uint32_t> open_orders{0};
+        std::atomic<uint32_t> window_messages{0};
+        std::atomic<int64_t> window_second{0};
+        std::atomic<uint64_t> rejected{0};
+        bool custom_limits = false;              // escritos só na configuração
+        RiskLimits limits;
+    };
+
+    struct alignas(64) SymbolState
+    {
+        std::atomic<double> reference_price{0.0};
+    };
+
+    // Acha o slot do cliente, reservando um livre na primeira mensagem; nullptr com a tabela cheia
+    ClientState* acquireClient(uint64_t client_id);
+    const ClientState* findClient(uint64_t client_id) const;
+    const RiskLimits& limitsOf(const ClientState& client) const { return client.custom_limits ? client.limits : default_limits_; }
+
+    bool withinMessageRate(ClientState& client, const RiskLimits& limits, const std::chrono::system_clock::time_point& timestamp);
+    RiskRejectReason checkSize(const SymbolState& symbol, const RiskLimits& limits, uint32_t quantity, double price) const;
+    RiskRejectReason reject(ClientState& client, RiskRejectReason reason);
+
+    RiskLimits default_limits_;
+    std::unique_ptr<ClientState[]> clients_;
+    std::unordered_map<std::string, std::unique_ptr<SymbolState>> symbols_;
+};
+
+#endif // PRE_TRADE_RISK_HPP
@@ -0,0 +1,65 @@
+#ifndef REPLAY_DRIVER_HPP
+#define REPLAY_DRIVER_HPP
+
+#include "domain/engine.hpp"
+#include "domain/event_bus_dispatcher.hpp"
+#include "messaging/command_log.hpp"
+#include "messaging/event_digest.hpp"
+#include "utils/latency_histogram.hpp"
+#include "utils/market_data_channel.hpp"
+#include "utils/thread_safe_queue.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+struct ReplayReport
+{
+    uint64_t batches = 0;
+    uint64_t commands = 0;
+    uint64_t events = 0;
+    uint64_t checksum = 0;
+    double engine_seconds = 0.0; // soma dos lotes dentro da engine, sem a leitura do arquivo e o resumo da saída
+    double wall_seconds = 0.0;
+    bool complete = true;        // false se o registro terminou num lote incompleto
+};
+
+// Reexecuta um registro de comandos (CommandRecorder) numa engine própria, na thread chamadora e sem esperas:
+// cada lote gravado passa por Engine::processBatch com o mesmo instante de timers da gravação. A latência de
+// cada comando é a do lote em que ele foi executado (até a publicação do lote, como no run()), e toda a saída
+// (eventos transacionais, BBO e snapshots) entra num EventDigest fora da região medida.
+//
+// Os ids de ordem e de trade vêm do gerador do processo: para comparar checksums entre execuções, cada
+// reexecução deve rodar num processo novo (ids a partir de 1), como faz o modo --replay do binário.
+class ReplayDriver
+{
+public:
+    explicit ReplayDriver(std::ostream* events_out = nullptr);
+
+    // Abre o registro e prepara a engine: os livros e os horários de sessão da engine gravada
+    bool open(const std::string& path);
+
+    // Executa o registro inteiro
+    ReplayReport run();
+
+    const LatencyHistogram& getLatency() const { return latency_; }
+    Engine& getEngine() { return engine_; }
+
+private:
+    // Tudo que a engine publicou no lote, na ordem: transacionais, BBO e então snapshots conflacionados
+    void collectOutput();
+
+    ThreadSafeQueue<std::unique_ptr<Command>> command_queue_;
+    ThreadSafeQueue<Event> event_queue_;
+    MarketDataChannel market_data_channel_;
+    ThreadSafeQueue<Event> bbo_queue_;
+    EventBusDispatcher event_bus_;
+    Engine engine_;
+
+    CommandLogReader reader_;
+    EventDigest digest_;
+    LatencyHistogram latency_;
+    std::vector<std::unique_ptr<Command>> batch_;
+    std::vector<Event> output_;
+};
+
+#endif // REPLAY_DRIVER_HPP
@@ -0,0 +1,69 @@
+#ifndef SHM_INGRESS_GATEWAY_HPP
+#define SHM_INGRESS_GATEWAY_HPP
+
+#include "domain/inbound_gateway.hpp"
+#include "messaging/shm_order_message.hpp"
+#include "utils/shm_ring.hpp"
+#include "utils/wait_strategy.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Entrada dos clientes co-located: um segmento de memória compartilhada por cliente, com um ring SPSC de
+// ShmOrderMessage (o cliente escreve com ShmOrderClient, este gateway lê). Uma thread faz polling de todos os
+// rings; cada mensagem é validada e convertida em comando lendo o slot no lugar, sem texto FIX, e os comandos
+// de uma volta pelos rings entram na fila da engine com um único push_batch.
+//
+// A sequência de cada cliente é checada como no acceptor TCP: duplicatas são descartadas e saltos são logados.
+class ShmIngressGateway
+{
+public:
+    explicit ShmIngressGateway(InboundGateway& gateway);
+
+    // Cria o segmento do cliente em shmIngressSegmentName(client_id), apagando um anterior com o mesmo nome.
+    // Deve ser chamado antes de run().
+    bool addClient(uint64_t client_id, uint32_t capacity = 4096);
+
+    // Como a thread espera quando nenhum ring tem mensagens: busy_spin gira, yield cede o núcleo, spin_park
+    // gira spin_iterations voltas e depois dorme em intervalos curtos, blocking dorme direto.
+    void setWaitStrategy(const WaitStrategy& strategy) { wait_strategy_ = strategy; }
+
+    void run();
+    void stop() { stop_flag_.store(true, std::memory_order_relaxed); }
+
+    uint64_t messagesReceived() const { return messages_received_.load(std::memory_order_relaxed); }
+    uint64_t commandsQueued() const { return commands_queued_.load(std::memory_order_relaxed); }
+    uint64_t sequenceGaps() const { return sequence_gaps_.load(std::memory_order_relaxed); }
+    uint64_t duplicatesDropped() const { return duplicates_dropped_.load(std::memory_order_relaxed); }
+
+private:
+    // Mensagens retiradas de um ring por volta, para um cliente rápido não atrasar os outros
+    static constexpr size_t kMaxBatch = 64;
+    // Intervalo de sono quando não há mensagens e a estratégia manda dormir
+    static constexpr std::chrono::microseconds kIdleSleep{50};
+
+    struct ClientRing
+    {
+        uint64_t client_id = 0;
+        uint32_t expected_sequence = 1;
+        ShmSpscRing<ShmOrderMessage> ring;
+    };
+
+    // Retorna quantas mensagens foram lidas do ring
+    size_t pollClient(ClientRing& client);
+    void idle(uint64_t idle_rounds) const;
+
+    InboundGateway& gateway_;
+    std::vector<std::unique_ptr<ClientRing>> clients_;
+    std::vector<std::unique_ptr<Command>> batch_;
+    WaitStrategy wait_strategy_;
+    std::atomic<bool> stop_flag_{false};
+
+    std::atomic<uint64_t> messages_received_{0};
+    std::atomic<uint64_t> commands_queued_{0};
+    std::atomic<uint64_t> sequence_gaps_{0};
+    std::atomic<uint64_t> duplicates_dropped_{0};
+};
+
+#endif // SHM_INGRESS_GATEWAY_HPP
@@ -0,0 +1,40 @@
+#ifndef SYMBOL_TABLE_HPP
+#define SYMBOL_TABLE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Id compacto de um símbolo, usado nos eventos no lugar do nome
+using SymbolId = uint16_t;
+
+// Tabela de símbolos do processo: cada nome recebe um id na primeira vez que é visto e o mantém até o fim.
+// Os eventos carregam só o id (ficam trivialmente copiáveis) e os consumidores recuperam o nome com name().
+//
+// intern() serializa as inserções por um mutex; name() não trava. O nome é escrito antes de o id ser devolvido
+// e os ids chegam às outras threads pelas filas (que sincronizam), então o leitor sempre vê o nome completo.
+// A capacidade é fixa para que os nomes nunca mudem de lugar; esgotada, intern() devolve kUnknownSymbol.
+class SymbolTable
+{
+public:
+    static constexpr size_t kMaxSymbols = 4096;
+
+    // Id 0 é reservado: nome vazio, devolvido quando a tabela está cheia
+    static constexpr SymbolId kUnknownSymbol = 0;
+
+    static SymbolId intern(const std::string& symbol);
+    static const std::string& name(SymbolId id);
+    static size_t size() { return count_.load(std::memory_order_acquire); }
+
+private:
+    static std::array<std::string, kMaxSymbols> names_;
+    static std::unordered_map<std::string, SymbolId> ids_;
+    static std::atomic<size_t> count_;
+    static std::mutex mutex_;
+};
+
+#endif // SYMBOL_TABLE_HPP
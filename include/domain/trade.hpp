@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <string>
 #include <chrono>
+#include "utils/id_generator.hpp"
 
 class Trade
 {
@@ -12,8 +13,9 @@ public:
           const std::string& symbol, double price, uint32_t quantity, 
           const std::chrono::system_clock::time_point& timestamp);
 
-    static uint64_t getNextTradeId() { return next_trade_id_++; }
-    static void resetTradeIdCounter() { next_trade_id_ = 1; }
+    // Gerador por thread, no shard de IdGenerator::threadShard(): sem atômicos fora da reserva de blocos
+    static uint64_t getNextTradeId();
+    static IdBlockAllocator& getIdAllocator() { return id_allocator_; }
 
     uint64_t getTradeId() const { return trade_id_; }
     uint64_t getAggressiveOrderId() const { return aggressive_order_id_; }
@@ -24,7 +26,7 @@ public:
     const std::chrono::system_clock::time_point& getTimestamp() const { return timestamp_; }
     
 private:
-    static uint64_t next_trade_id_; 
+    static IdBlockAllocator id_allocator_;
 
     uint64_t trade_id_;
     uint64_t aggressive_order_id_;
@@ -0,0 +1,97 @@
+#ifndef TRIGGER_BOOK_HPP
+#define TRIGGER_BOOK_HPP
+
+#include "domain/order.hpp"
+#include "domain/client_order_key.hpp"
+#include <map>
+#include <list>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+
+// Índice das ordens stop de um OrderBook que ainda não dispararam. Elas não fazem parte do livro visível:
+// ficam aqui, ordenadas pelo preço de disparo, até que uma negociação cruze esse preço.
+//
+// - Stop e StopLimit: um multimap por lado ordenado pelo StopPx, com o stop mais próximo do mercado no início.
+//   Um trade libera todos os stops cruzados com uma única varredura a partir do begin(). Dentro do mesmo
+//   preço o multimap preserva a ordem de inserção.
+// - TrailingStop: o stop acompanha o melhor preço negociado desde a entrada (máximo para venda, mínimo para
+//   compra). As ordens são agrupadas por distância e, dentro dela, por esse preço de referência. Quando o
+//   mercado faz um novo extremo, todos os grupos que ficaram para trás são unidos em um só com splice, então
+//   um trade custa O(log n) por distância distinta e não O(ordens trailing).
+class TriggerBook
+{
+public:
+    // Retorna false se o cliente já tiver uma ordem stop viva com o mesmo ClOrdID.
+    // reference_price é o preço a partir do qual o trailing stop começa a andar.
+    bool addOrder(std::shared_ptr<Order> order, double reference_price);
+
+    // Retira a ordem do índice (cancelamento) ou retorna nullptr se ela não estiver aqui
+    std::shared_ptr<Order> removeOrder(uint64_t client_id, uint64_t client_order_id);
+
+    // Indica se esta ordem (o mesmo objeto) ainda está esperando o disparo
+    bool contains(const Order& order) const;
+
+    // Indica se o cliente tem uma ordem stop viva com este ClOrdID
+    bool contains(uint64_t client_id, uint64_t client_order_id) const;
+
+    // Atualiza as referências dos trailing stops com a faixa negociada [low, high] e move para 'triggered'
+    // todas as ordens cujo stop foi cruzado: stops de compra por high, de venda por low e trailing stops pelo
+    // último preço. As ordens liberadas saem em ordem de chegada (order_id), o que torna o disparo determinístico.
+    void collectTriggered(double low, double high, double last, std::vector<std::shared_ptr<Order>>& triggered);
+
+    size_t size() const { return index_.size(); }
+    bool empty() const { return index_.empty(); }
+
+private:
+    using BuyStops = std::multimap<double, std::shared_ptr<Order>>;
+    using SellStops = std::multimap<double, std::shared_ptr<Order>, std::greater<double>>;
+    using OrderList = std::list<std::shared_ptr<Order>>;
+
+    // Grupos de trailing stops com a mesma distância, indexados pelo preço de referência. Para venda o
+    // mapa é decrescente (máximo negociado); para compra, crescente (mínimo negociado).
+    using SellTrailing = std::map<double, OrderList, std::greater<double>>;
+    using BuyTrailing = std::map<double, OrderList>;
+
+    enum class Kind
+    {
+        BuyStop,
+        SellStop,
+        Trailing
+    };
+
+    struct TriggerLocation
+    {
+        Kind kind;
+        BuyStops::iterator buy_stop;
+        SellStops::iterator sell_stop;
+        std::shared_ptr<Order> order;   // identifica o nó vivo: um ClOrdID pode ser reaproveitado depois de um cancel
+    };
+
+    // Retira do índice uma ordem trailing que disparou; false se ela já tinha sido cancelada
+    bool releaseTrailing(const std::shared_ptr<Order>& order);
+
+    // Une ao grupo do novo extremo todos os grupos cujo preço de referência ficou para trás
+    template<typename Groups>
+    static void dragGroups(Groups& groups, double extreme);
+
+    template<typename Groups>
+    void compactGroups(std::map<double, Groups>& by_offset);
+    void compactTrailing();
+
+    BuyStops buy_stops_;
+    SellStops sell_stops_;
+    std::map<double, SellTrailing> sell_trailing_;  // distância -> grupos
+    std::map<double, BuyTrailing> buy_trailing_;
+
+    // Trailing stops mudam de lista a cada novo extremo, então o cancelamento é preguiçoso: a ordem sai do
+    // índice e é marcada como cancelada, e o nó é descartado quando o grupo disparar ou na compactação
+    // (feita quando os nós mortos passam dos vivos, o que mantém o custo amortizado)
+    size_t live_trailing_ = 0;
+    size_t dead_trailing_ = 0;
+
+    std::unordered_map<ClientOrderKey, TriggerLocation, ClientOrderKeyHash> index_;
+};
+
+#endif // TRIGGER_BOOK_HPP
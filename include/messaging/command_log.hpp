@@ -0,0 +1,138 @@
+#ifndef COMMAND_LOG_HPP
+#define COMMAND_LOG_HPP
+
+#include "messaging/commands/command.hpp"
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Registro binário do fluxo de comandos exatamente como a engine o consumiu: os lotes retirados da fila, na ordem,
+// com os limites de cada lote e o instante usado para avançar os timers naquele lote. Reexecutado numa engine
+// nova (ver ReplayDriver), reproduz a mesma saída, incluindo a conflação de market data por lote e as expirações.
+//
+// Layout: FileHeader, symbol_count nomes de kSymbolBytes, e então uma sequência de BatchHeader seguidos de
+// 'count' CommandRecord. Tudo em little-endian, estruturas de tamanho fixo.
+namespace command_log
+{
+
+constexpr char kMagic[8] = {'O', 'B', 'C', 'M', 'D', 'L', 'O', 'G'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kSymbolBytes = 16;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t symbol_count;       // livros da engine, na ordem de criação
+    int64_t session_close_ns;    // horários da sessão em system_clock (0 = não configurado)
+    int64_t opening_auction_ns;
+    int64_t closing_auction_ns;
+    int64_t timer_start_ns;      // relógio da timer wheel da engine quando a gravação começou
+};
+
+struct BatchHeader
+{
+    uint32_t count;
+    uint32_t reserved;
+    int64_t timer_now_ns;        // instante passado a advanceTimers no lote (0 = timers não avançaram)
+};
+
+struct CommandRecord
+{
+    enum Type : uint8_t
+    {
+        NewOrder = 'D',
+        Cancel = 'F',
+        Amend = 'G'
+    };
+
+    uint8_t type;
+    uint8_t side;
+    uint8_t order_type;
+    uint8_t time_in_force;
+    uint8_t capacity;
+    uint8_t reserved[3];
+    char symbol[kSymbolBytes];   // completado com '\0'
+    uint32_t quantity;           // no amend, a nova quantidade total
+    uint32_t reserved2;
+    uint64_t client_id;
+    uint64_t client_order_id;
+    uint64_t orig_client_order_id;
+    double price;
+    double stop_price;
+    double trailing_offset;
+    int64_t received_ns;
+    int64_t expire_ns;
+};
+
+static_assert(sizeof(FileHeader) == 48, "FileHeader layout changed");
+static_assert(sizeof(BatchHeader) == 16, "BatchHeader layout changed");
+static_assert(sizeof(CommandRecord) == 96, "CommandRecord layout changed");
+
+// Horários da sessão com que a engine gravada foi configurada (time_point{} = não configurado) e o ponto de
+// partida da timer wheel dela, para que as expirações e leilões disparem nos mesmos lotes na reexecução
+struct SessionSchedule
+{
+    std::chrono::system_clock::time_point session_close{};
+    std::chrono::system_clock::time_point opening_auction{};
+    std::chrono::system_clock::time_point closing_auction{};
+    std::chrono::system_clock::time_point timer_start{};
+};
+
+} // namespace command_log
+
+// Grava os lotes na thread da engine. A escrita é bufferizada (um buffer grande no ofstream), então o custo no
+// caminho quente é copiar os campos de cada comando; só é ligado quando engine.record aponta para um arquivo.
+class CommandRecorder
+{
+public:
+    CommandRecorder() = default;
+    ~CommandRecorder();
+
+    bool open(const std::string& path, const std::vector<std::string>& symbols, const command_log::SessionSchedule& schedule);
+    void recordBatch(const std::vector<std::unique_ptr<Command>>& batch, const std::chrono::system_clock::time_point& timer_now);
+    void close();
+
+    bool isOpen() const { return file_.is_open(); }
+    uint64_t commandsRecorded() const { return commands_recorded_; }
+    uint64_t batchesRecorded() const { return batches_recorded_; }
+
+private:
+    static constexpr size_t kBufferBytes = 1 << 20;
+
+    std::ofstream file_;
+    std::unique_ptr<char[]> buffer_;
+    std::vector<command_log::CommandRecord> records_;
+    uint64_t commands_recorded_ = 0;
+    uint64_t batches_recorded_ = 0;
+};
+
+// Lê um registro gravado pelo CommandRecorder e recria os comandos de cada lote
+class CommandLogReader
+{
+public:
+    bool open(const std::string& path);
+
+    const std::vector<std::string>& getSymbols() const { return symbols_; }
+    const command_log::SessionSchedule& getSchedule() const { return schedule_; }
+
+    // Próximo lote em 'batch' (substitui o conteúdo); false no fim do arquivo ou se ele estiver truncado
+    bool nextBatch(std::vector<std::unique_ptr<Command>>& batch, std::chrono::system_clock::time_point& timer_now);
+
+    // Lotes lidos até aqui e se a leitura parou num registro incompleto
+    uint64_t batchesRead() const { return batches_read_; }
+    bool truncated() const { return truncated_; }
+
+private:
+    std::ifstream file_;
+    std::vector<std::string> symbols_;
+    command_log::SessionSchedule schedule_;
+    std::vector<command_log::CommandRecord> records_;
+    uint64_t batches_read_ = 0;
+    bool truncated_ = false;
+};
+
+#endif // COMMAND_LOG_HPP
@@ -2,24 +2,40 @@
 #define AMEND_ORDER_COMMAND_HPP
 
 #include "command.hpp"
+#include "types/order_params.hpp"
 #include <string>
 #include <cstdint> 
+#include <chrono>
 
 class AmendOrderCommand : public Command 
 {
 public:
-    AmendOrderCommand(uint64_t order_id, uint32_t new_quantity, double new_price);
+    // Espelha o Order Cancel/Replace Request (35=G): a ordem é identificada pelo OrigClOrdID (tag 41)
+    // e passa a responder pelo novo ClOrdID (tag 11). new_quantity é a nova quantidade total (tag 38).
+    AmendOrderCommand(uint64_t client_id, uint64_t client_order_id, uint64_t orig_client_order_id,
+                      const std::string& symbol, OrderSide side, uint32_t new_quantity, double new_price,
+                      const std::chrono::system_clock::time_point& received_timestamp);
 
     void execute(Engine& engine) override;
     
-    uint64_t getOrderId() const { return order_id_; }
+    uint64_t getClientId() const { return client_id_; }
+    uint64_t getClientOrderId() const { return client_order_id_; }
+    uint64_t getOrigClientOrderId() const { return orig_client_order_id_; }
+    const std::string& getSymbol() const { return symbol_; }
+    OrderSide getSide() const { return side_; }
     uint32_t getNewQuantity() const { return new_quantity_; }
     double getNewPrice() const { return new_price_; }
+    const std::chrono::system_clock::time_point& getReceivedTimestamp() const { return received_timestamp_; }
 
 private:
-    uint64_t order_id_;
+    uint64_t client_id_;
+    uint64_t client_order_id_;
+    uint64_t orig_client_order_id_;
+    std::string symbol_;
+    OrderSide side_;
     uint32_t new_quantity_;
     double new_price_;
+    std::chrono::system_clock::time_point received_timestamp_;
 };
 
-#endif // AMEND_ORDER_COMMAND_HPP
\ No newline at end of file
+#endif // AMEND_ORDER_COMMAND_HPP
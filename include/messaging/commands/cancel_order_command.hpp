@@ -2,20 +2,35 @@
 #define CANCEL_ORDER_COMMAND_HPP
 
 #include "command.hpp"
+#include "types/order_params.hpp"
 #include <string>
 #include <cstdint> 
+#include <chrono>
 
 class CancelOrderCommand : public Command 
 {
 public:
-    explicit CancelOrderCommand(uint64_t order_id);
+    // client_order_id é o ClOrdID do próprio pedido de cancelamento (tag 11);
+    // orig_client_order_id é o ClOrdID da ordem que deve sair do livro (tag 41)
+    CancelOrderCommand(uint64_t client_id, uint64_t client_order_id, uint64_t orig_client_order_id,
+                       const std::string& symbol, OrderSide side, const std::chrono::system_clock::time_point& received_timestamp);
     
     void execute(Engine& engine) override;
 
-    uint64_t getOrderIdToCancel() const { return order_id_to_cancel_; }
+    uint64_t getClientId() const { return client_id_; }
+    uint64_t getClientOrderId() const { return client_order_id_; }
+    uint64_t getOrigClientOrderId() const { return orig_client_order_id_; }
+    const std::string& getSymbol() const { return symbol_; }
+    OrderSide getSide() const { return side_; }
+    const std::chrono::system_clock::time_point& getReceivedTimestamp() const { return received_timestamp_; }
 
 private:
-    uint64_t order_id_to_cancel_;
+    uint64_t client_id_;
+    uint64_t client_order_id_;
+    uint64_t orig_client_order_id_;
+    std::string symbol_;
+    OrderSide side_;
+    std::chrono::system_clock::time_point received_timestamp_;
 };
 
-#endif // CANCEL_ORDER_COMMAND_HPP
\ No newline at end of file
+#endif // CANCEL_ORDER_COMMAND_HPP
@@ -4,6 +4,7 @@
 #include <string>
 #include <cstdint>
 #include <memory>
+#include <chrono>
 
 class Engine;
 
@@ -13,6 +14,15 @@ public:
     
     // Todo comando DEVE implementar esta função. Ele recebe uma referência ao motor para poder chamar os métodos de negócio corretos
     virtual void execute(Engine& engine) = 0;
+
+    // Instante em que o comando deveria ter sido enviado segundo o agendamento do gerador de carga.
+    // A latência medida a partir dele (e não do envio real) já vem corrigida para coordinated omission.
+    // Fica zerado para comandos que não passaram por um gerador com pacing.
+    void setIntendedTimestamp(const std::chrono::steady_clock::time_point& timestamp) { intended_timestamp_ = timestamp; }
+    const std::chrono::steady_clock::time_point& getIntendedTimestamp() const { return intended_timestamp_; }
+
+private:
+    std::chrono::steady_clock::time_point intended_timestamp_{};
 };
 
 #endif // COMMAND_HPP
\ No newline at end of file
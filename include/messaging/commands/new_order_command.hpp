@@ -27,6 +27,15 @@ public:
     OrderCapacity getCapacity() const { return capacity_; }
     const std::chrono::system_clock::time_point& getReceivedTimestamp() const { return received_timestamp_; }
 
+    // Parâmetros das ordens stop: StopPx (tag 99) e a distância do trailing stop (tag 211)
+    void setStopParameters(double stop_price, double trailing_offset) { stop_price_ = stop_price; trailing_offset_ = trailing_offset; }
+    double getStopPrice() const { return stop_price_; }
+    double getTrailingOffset() const { return trailing_offset_; }
+
+    // Prazo de uma ordem GoodTillDate (tag 126)
+    void setExpireTime(const std::chrono::system_clock::time_point& expire_time) { expire_time_ = expire_time; }
+    const std::chrono::system_clock::time_point& getExpireTime() const { return expire_time_; }
+
 private:
     uint64_t client_order_id_;
     uint64_t client_id_;
@@ -38,6 +47,9 @@ private:
     OrderTimeInForce tif_;
     OrderCapacity capacity_;
     std::chrono::system_clock::time_point received_timestamp_;
+    double stop_price_ = 0.0;
+    double trailing_offset_ = 0.0;
+    std::chrono::system_clock::time_point expire_time_{};
 };
 
 #endif // NEW_ORDER_COMMAND_HPP
@@ -0,0 +1,42 @@
+#ifndef EVENT_DIGEST_HPP
+#define EVENT_DIGEST_HPP
+
+#include "messaging/events/event.hpp"
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Resumo determinístico da saída da engine: cada evento vira uma codificação binária canônica (tipo e campos,
+// sem os timestamps de relógio de parede) que entra num FNV-1a de 64 bits e, opcionalmente, num stream.
+// Duas execuções do mesmo registro de comandos devem produzir o mesmo checksum; quando não produzem, os
+// dumps gravados pelo stream podem ser comparados byte a byte (cmp) para achar o primeiro evento diferente.
+class EventDigest
+{
+public:
+    explicit EventDigest(std::ostream* dump = nullptr) : dump_(dump) {}
+
+    void add(const Event& event);
+
+    uint64_t checksum() const { return hash_; }
+    uint64_t eventCount() const { return events_; }
+    uint64_t bytes() const { return bytes_; }
+
+private:
+    static constexpr uint64_t kFnvOffset = 14695981039346656037ULL;
+    static constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+    void putByte(uint8_t value) { record_.push_back(static_cast<char>(value)); }
+    void putU32(uint32_t value);
+    void putU64(uint64_t value);
+    void putDouble(double value);
+    void putString(const std::string& value);
+    void putString(const char* value);
+
+    std::ostream* dump_;
+    std::string record_; // codificação do evento corrente, reaproveitada entre eventos
+    uint64_t hash_ = kFnvOffset;
+    uint64_t events_ = 0;
+    uint64_t bytes_ = 0;
+};
+
+#endif // EVENT_DIGEST_HPP
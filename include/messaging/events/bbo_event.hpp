@@ -0,0 +1,29 @@
+#ifndef BBO_EVENT_HPP
+#define BBO_EVENT_HPP
+
+#include "messaging/events/event_header.hpp"
+#include "domain/order_book.hpp"
+#include <cstdint>
+
+// Melhor compra/venda de um símbolo, publicada só quando o topo do livro muda. É bem mais leve que o
+// BookSnapshotEvent e segue por um canal próprio, então consumidores de profundidade lentos não a atrasam.
+// A sequência é por símbolo e sem buracos: um salto indica que o consumidor perdeu uma atualização.
+class BboEvent : public EventHeader 
+{
+public:
+    BboEvent() = default;
+    BboEvent(SymbolId symbol_id, const TopOfBook& top, uint64_t sequence, const std::chrono::system_clock::time_point& timestamp)
+        : EventHeader(symbol_id, timestamp), top_(top), sequence_(sequence)
+    {}
+
+    const char* getEventName() const { return "BboEvent"; }
+
+    const TopOfBook& getTop() const { return top_; }
+    uint64_t getSequence() const { return sequence_; }
+
+private:
+    TopOfBook top_;
+    uint64_t sequence_ = 0;
+};
+
+#endif // BBO_EVENT_HPP
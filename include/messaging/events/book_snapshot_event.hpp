@@ -1,16 +1,15 @@
 #ifndef BOOK_SNAPSHOT_EVENT_HPP
 #define BOOK_SNAPSHOT_EVENT_HPP
 
-#include "messaging/events/event.hpp"
+#include "messaging/events/event_header.hpp"
 #include "domain/order_book.hpp" 
-#include <string>
-#include <vector>
+#include "utils/inline_vector.hpp"
+#include <algorithm>
 #include <cstdint>
-#include <iostream>
 
 class OrderBook;
 
-class BookSnapshotEvent : public Event 
+class BookSnapshotEvent : public EventHeader 
 {
 public:
     struct PriceLevel {
@@ -18,31 +17,38 @@ public:
         uint64_t quantity;
     };
 
+    // Profundidade máxima da "foto", fixa para que o evento tenha tamanho fixo
+    static constexpr size_t kMaxDepth = 5;
+    using Levels = InlineVector<PriceLevel, kMaxDepth>;
+
+    BookSnapshotEvent() = default;
+
     // Construtor que cria a "foto" a partir de um OrderBook existente.
-    // Ele copia os 'depth' melhores níveis de preço de compra e venda.
-    explicit BookSnapshotEvent(const OrderBook& book, size_t depth = 5)
-        : symbol_(book.getSymbol())
+    // Ele copia os 'depth' melhores níveis de preço de compra e venda (no máximo kMaxDepth).
+    BookSnapshotEvent(const OrderBook& book, const std::chrono::system_clock::time_point& timestamp, size_t depth = kMaxDepth)
+        : EventHeader(book.getSymbolId(), timestamp)
     {
-        auto bid_it = book.getAggregatedBids().begin();
-        for (size_t i = 0; i < depth && bid_it != book.getAggregatedBids().end(); ++i, ++bid_it) {
-            bids_.push_back({bid_it->first, bid_it->second}); 
+        depth = std::min(depth, kMaxDepth);
+
+        // A profundidade vem direto dos níveis do livro (quantidade total guardada em cada nível)
+        auto bid_it = book.getBids().begin();
+        for (size_t i = 0; i < depth && bid_it != book.getBids().end(); ++i, ++bid_it) {
+            bids_.push_back({bid_it->first, bid_it->second.total_quantity}); 
         }
-        auto ask_it = book.getAggregatedAsks().begin();
-        for (size_t i = 0; i < depth && ask_it != book.getAggregatedAsks().end(); ++i, ++ask_it) {
-            asks_.push_back({ask_it->first, ask_it->second});
+        auto ask_it = book.getAsks().begin();
+        for (size_t i = 0; i < depth && ask_it != book.getAsks().end(); ++i, ++ask_it) {
+            asks_.push_back({ask_it->first, ask_it->second.total_quantity});
         }
     }
 
-    const char* getEventName() const override { return "BookSnapshotEvent"; }
+    const char* getEventName() const { return "BookSnapshotEvent"; }
 
-    const std::string& getSymbol() const { return symbol_; }
-    const std::vector<PriceLevel>& getBids() const { return bids_; }
-    const std::vector<PriceLevel>& getAsks() const { return asks_; }
+    const Levels& getBids() const { return bids_; }
+    const Levels& getAsks() const { return asks_; }
 
 private:
-    std::string symbol_;
-    std::vector<PriceLevel> bids_;
-    std::vector<PriceLevel> asks_;
+    Levels bids_;
+    Levels asks_;
 };
 
-#endif // BOOK_SNAPSHOT_EVENT_HPP
\ No newline at end of file
+#endif // BOOK_SNAPSHOT_EVENT_HPP
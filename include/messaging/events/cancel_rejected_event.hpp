@@ -0,0 +1,46 @@
+#ifndef CANCEL_REJECTED_EVENT_HPP
+#define CANCEL_REJECTED_EVENT_HPP
+
+#include "messaging/events/event_header.hpp"
+#include <cstdint>
+
+// Equivalente ao Order Cancel Reject (35=9) do FIX: a mesma mensagem responde a cancels e a amends
+class CancelRejectedEvent : public EventHeader 
+{
+public:
+    enum class ResponseTo
+    {
+        Cancel = 1,
+        Amend = 2
+    };
+
+    CancelRejectedEvent() = default;
+
+    // 'reason' deve apontar para uma string estática (literal), o evento não copia o texto
+    CancelRejectedEvent(uint64_t client_id, uint64_t client_order_id, uint64_t orig_client_order_id, SymbolId symbol_id,
+                        ResponseTo response_to, const char* reason, const std::chrono::system_clock::time_point& timestamp) :
+            EventHeader(symbol_id, timestamp),
+            client_id_(client_id),
+            client_order_id_(client_order_id),
+            orig_client_order_id_(orig_client_order_id),
+            response_to_(response_to),
+            reason_(reason)
+    {}
+
+    const char* getEventName() const { return "CancelRejectedEvent"; }
+
+    uint64_t getClientId() const { return client_id_; }
+    uint64_t getClientOrderId() const { return client_order_id_; }
+    uint64_t getOrigClientOrderId() const { return orig_client_order_id_; }
+    ResponseTo getResponseTo() const { return response_to_; }
+    const char* getReason() const { return reason_; }
+
+private:
+    uint64_t client_id_;
+    uint64_t client_order_id_;
+    uint64_t orig_client_order_id_;
+    ResponseTo response_to_;
+    const char* reason_;
+};
+
+#endif // CANCEL_REJECTED_EVENT_HPP
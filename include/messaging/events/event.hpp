@@ -1,28 +1,38 @@
 #ifndef EVENT_HPP
 #define EVENT_HPP
 
-#include <chrono>
+#include "messaging/events/order_accepted_event.hpp"
+#include "messaging/events/trade_executed_event.hpp"
+#include "messaging/events/order_canceled_event.hpp"
+#include "messaging/events/cancel_rejected_event.hpp"
+#include "messaging/events/order_rejected_event.hpp"
+#include "messaging/events/order_amended_event.hpp"
+#include "messaging/events/stop_triggered_event.hpp"
+#include "messaging/events/orders_expired_event.hpp"
+#include "messaging/events/bbo_event.hpp"
+#include "messaging/events/book_snapshot_event.hpp"
+#include <type_traits>
+#include <variant>
 
-class Event 
-{
-    // Um evento é uma classe base que pode ser estendida para criar eventos específicos
-    // Ele contém um timestamp que indica quando o evento foi gerado
-    // As classes filhas devem implementar a lógica específica do evento
-public:
-    virtual ~Event() = default;
+// Um evento é um registro de tamanho fixo com um dos tipos abaixo. Nenhum deles guarda strings ou vetores,
+// então criar, copiar e enfileirar um evento não passa pelo alocador: as filas e o barramento carregam o
+// próprio registro, e os consumidores escolhem o tipo com std::get_if.
+using Event = std::variant<OrderAcceptedEvent, TradeExecutedEvent, OrderCanceledEvent, CancelRejectedEvent, OrderRejectedEvent, OrderAmendedEvent,
+                           StopTriggeredEvent, OrdersExpiredEvent, BboEvent, BookSnapshotEvent>;
 
-    // Cada evento deve ter um nome único para identificação
-    virtual const char* getEventName() const = 0;
-    
-    // Todo evento tem um timestamp de quando foi gerado
-    const std::chrono::system_clock::time_point& getTimestamp() const { return timestamp_; }
+static_assert(std::is_trivially_copyable<Event>::value, "Events must stay trivially copyable");
+static_assert(sizeof(Event) <= kEventRecordBytes, "Event record exceeds kEventRecordBytes");
 
-protected:
-    // O construtor é protegido para que apenas as classes filhas possam chamá-lo
-    Event() : timestamp_(std::chrono::system_clock::now()) {}
+// Símbolo e timestamp de qualquer evento
+inline const EventHeader& getEventHeader(const Event& event)
+{
+    return std::visit([](const EventHeader& header) -> const EventHeader& { return header; }, event);
+}
 
-private:
-    std::chrono::system_clock::time_point timestamp_;
-};
+// Nome do tipo do evento (ex: para logs)
+inline const char* getEventName(const Event& event)
+{
+    return std::visit([](const auto& typed) { return typed.getEventName(); }, event);
+}
 
-#endif // EVENT_HPP
\ No newline at end of file
+#endif // EVENT_HPP
@@ -0,0 +1,35 @@
+#ifndef EVENT_HEADER_HPP
+#define EVENT_HEADER_HPP
+
+#include "domain/symbol_table.hpp"
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+// Orçamento de tamanho de um registro de evento (sizeof(Event), conferido em event.hpp). Toda fila e todo
+// consumidor copia o registro inteiro, então o maior tipo dita o custo de cada aceite e de cada fill: as
+// capacidades inline dos eventos de tamanho variável saem deste número, e não o contrário.
+constexpr size_t kEventRecordBytes = 256;
+
+// Campos comuns a todo evento: o símbolo (como SymbolId) e o instante em que foi gerado. O instante vem de quem
+// cria o evento (a engine lê o relógio uma vez por comando), não de uma leitura do relógio por evento.
+class EventHeader
+{
+public:
+    SymbolId getSymbolId() const { return symbol_id_; }
+    const std::string& getSymbol() const { return SymbolTable::name(symbol_id_); }
+    const std::chrono::system_clock::time_point& getTimestamp() const { return timestamp_; }
+
+protected:
+    // Protegido para que apenas os eventos concretos o construam
+    EventHeader() = default;
+    EventHeader(SymbolId symbol_id, const std::chrono::system_clock::time_point& timestamp)
+        : symbol_id_(symbol_id), timestamp_(timestamp)
+    {}
+
+private:
+    SymbolId symbol_id_ = SymbolTable::kUnknownSymbol;
+    std::chrono::system_clock::time_point timestamp_{};
+};
+
+#endif // EVENT_HEADER_HPP
@@ -1,44 +1,42 @@
 #ifndef ORDER_ACCEPTED_EVENT_HPP
 #define ORDER_ACCEPTED_EVENT_HPP
 
-#include "messaging/events/event.hpp"
+#include "messaging/events/event_header.hpp"
 #include "domain/order.hpp" 
-#include <memory>
-#include <string>
+#include <cstdint>
 
 class Order;
 
-class OrderAcceptedEvent : public Event 
+class OrderAcceptedEvent : public EventHeader 
 {
 public:
-    explicit OrderAcceptedEvent(const Order& order) :
+    OrderAcceptedEvent() = default;
+    OrderAcceptedEvent(const Order& order, SymbolId symbol_id, const std::chrono::system_clock::time_point& timestamp) :
+            EventHeader(symbol_id, timestamp),
             order_id_(order.getOrderId()),
             client_id_(order.getClientId()),
             client_order_id_(order.getClientOrderId()),
-            symbol_(order.getSymbol()),
             quantity_(order.getQuantity()),
             price_(order.getPrice()),
             side_(order.getSide())
     {}
 
-    virtual const char* getEventName() const override { return "OrderAcceptedEvent"; }
+    const char* getEventName() const { return "OrderAcceptedEvent"; }
 
     uint64_t getOrderId() const { return order_id_; }
     uint64_t getClientId() const { return client_id_; }
     uint64_t getClientOrderId() const { return client_order_id_; }
-    const std::string& getSymbol() const { return symbol_; }
     uint32_t getQuantity() const { return quantity_; }
     double getPrice() const { return price_; }
     OrderSide getSide() const { return side_; }
 
 private:
-    const uint64_t order_id_;
-    const uint64_t client_id_;
-    const uint64_t client_order_id_;
-    const std::string symbol_;
-    const uint32_t quantity_;
-    const double price_;
-    const OrderSide side_;
+    uint64_t order_id_;
+    uint64_t client_id_;
+    uint64_t client_order_id_;
+    uint32_t quantity_;
+    double price_;
+    OrderSide side_;
 };
 
-#endif // ORDER_ACCEPTED_EVENT_HPP
\ No newline at end of file
+#endif // ORDER_ACCEPTED_EVENT_HPP
@@ -0,0 +1,51 @@
+#ifndef ORDER_AMENDED_EVENT_HPP
+#define ORDER_AMENDED_EVENT_HPP
+
+#include "messaging/events/event_header.hpp"
+#include "domain/order.hpp"
+#include <cstdint>
+
+class OrderAmendedEvent : public EventHeader 
+{
+public:
+    // Copia o estado da ordem já alterada; a ordem passa a responder pelo ClOrdID do amend
+    OrderAmendedEvent() = default;
+    OrderAmendedEvent(const Order& order, uint64_t orig_client_order_id, bool kept_priority, SymbolId symbol_id,
+                      const std::chrono::system_clock::time_point& timestamp) :
+            EventHeader(symbol_id, timestamp),
+            order_id_(order.getOrderId()),
+            client_id_(order.getClientId()),
+            client_order_id_(order.getClientOrderId()),
+            orig_client_order_id_(orig_client_order_id),
+            side_(order.getSide()),
+            price_(order.getPrice()),
+            quantity_(order.getQuantity()),
+            remaining_quantity_(order.getRemainingQuantity()),
+            kept_priority_(kept_priority)
+    {}
+
+    const char* getEventName() const { return "OrderAmendedEvent"; }
+
+    uint64_t getOrderId() const { return order_id_; }
+    uint64_t getClientId() const { return client_id_; }
+    uint64_t getClientOrderId() const { return client_order_id_; }
+    uint64_t getOrigClientOrderId() const { return orig_client_order_id_; }
+    OrderSide getSide() const { return side_; }
+    double getPrice() const { return price_; }
+    uint32_t getQuantity() const { return quantity_; }
+    uint32_t getRemainingQuantity() const { return remaining_quantity_; }
+    bool keptPriority() const { return kept_priority_; }
+
+private:
+    uint64_t order_id_;
+    uint64_t client_id_;
+    uint64_t client_order_id_;
+    uint64_t orig_client_order_id_;
+    OrderSide side_;
+    double price_;
+    uint32_t quantity_;
+    uint32_t remaining_quantity_;
+    bool kept_priority_;
+};
+
+#endif // ORDER_AMENDED_EVENT_HPP
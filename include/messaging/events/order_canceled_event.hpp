@@ -0,0 +1,48 @@
+#ifndef ORDER_CANCELED_EVENT_HPP
+#define ORDER_CANCELED_EVENT_HPP
+
+#include "messaging/events/event_header.hpp"
+#include "domain/order.hpp"
+#include <cstdint>
+
+class OrderCanceledEvent : public EventHeader 
+{
+public:
+    // client_order_id é o ClOrdID do pedido que originou o cancelamento; para cancelamentos gerados
+    // pela própria engine (ex: restante de uma ordem IOC) ele é igual ao ClOrdID da ordem.
+    OrderCanceledEvent() = default;
+    OrderCanceledEvent(const Order& order, uint64_t client_order_id, SymbolId symbol_id, const std::chrono::system_clock::time_point& timestamp) :
+            EventHeader(symbol_id, timestamp),
+            order_id_(order.getOrderId()),
+            client_id_(order.getClientId()),
+            client_order_id_(client_order_id),
+            orig_client_order_id_(order.getClientOrderId()),
+            side_(order.getSide()),
+            price_(order.getPrice()),
+            canceled_quantity_(order.getRemainingQuantity()),
+            filled_quantity_(order.getFilledQuantity())
+    {}
+
+    const char* getEventName() const { return "OrderCanceledEvent"; }
+
+    uint64_t getOrderId() const { return order_id_; }
+    uint64_t getClientId() const { return client_id_; }
+    uint64_t getClientOrderId() const { return client_order_id_; }
+    uint64_t getOrigClientOrderId() const { return orig_client_order_id_; }
+    OrderSide getSide() const { return side_; }
+    double getPrice() const { return price_; }
+    uint32_t getCanceledQuantity() const { return canceled_quantity_; }
+    uint32_t getFilledQuantity() const { return filled_quantity_; }
+
+private:
+    uint64_t order_id_;
+    uint64_t client_id_;
+    uint64_t client_order_id_;
+    uint64_t orig_client_order_id_;
+    OrderSide side_;
+    double price_;
+    uint32_t canceled_quantity_;
+    uint32_t filled_quantity_;
+};
+
+#endif // ORDER_CANCELED_EVENT_HPP
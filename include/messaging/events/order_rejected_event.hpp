@@ -0,0 +1,50 @@
+#ifndef ORDER_REJECTED_EVENT_HPP
+#define ORDER_REJECTED_EVENT_HPP
+
+#include "messaging/events/event_header.hpp"
+#include "types/order_params.hpp"
+#include <cstdint>
+
+// Ordem nova recusada antes de existir no livro, pela engine (ClOrdID repetido, stop sem preço de disparo, símbolo
+// desconhecido) ou pelo risco pré-trade no gateway. Vira um 35=8 com ExecType e OrdStatus 8 (Rejected) e o motivo
+// na tag 58, para o cliente não ficar esperando por uma ordem que nunca foi aceita.
+class OrderRejectedEvent : public EventHeader
+{
+public:
+    OrderRejectedEvent() = default;
+
+    // order_id é 0 quando a ordem nem chegou a ser criada (rejeição no gateway).
+    // 'reason' deve apontar para uma string estática (literal), o evento não copia o texto
+    OrderRejectedEvent(uint64_t order_id, uint64_t client_id, uint64_t client_order_id, SymbolId symbol_id, OrderSide side,
+                       uint32_t quantity, double price, const char* reason, const std::chrono::system_clock::time_point& timestamp) :
+            EventHeader(symbol_id, timestamp),
+            order_id_(order_id),
+            client_id_(client_id),
+            client_order_id_(client_order_id),
+            quantity_(quantity),
+            price_(price),
+            side_(side),
+            reason_(reason)
+    {}
+
+    const char* getEventName() const { return "OrderRejectedEvent"; }
+
+    uint64_t getOrderId() const { return order_id_; }
+    uint64_t getClientId() const { return client_id_; }
+    uint64_t getClientOrderId() const { return client_order_id_; }
+    uint32_t getQuantity() const { return quantity_; }
+    double getPrice() const { return price_; }
+    OrderSide getSide() const { return side_; }
+    const char* getReason() const { return reason_; }
+
+private:
+    uint64_t order_id_;
+    uint64_t client_id_;
+    uint64_t client_order_id_;
+    uint32_t quantity_;
+    double price_;
+    OrderSide side_;
+    const char* reason_;
+};
+
+#endif // ORDER_REJECTED_EVENT_HPP
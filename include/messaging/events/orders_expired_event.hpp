@@ -0,0 +1,52 @@
+#ifndef ORDERS_EXPIRED_EVENT_HPP
+#define ORDERS_EXPIRED_EVENT_HPP
+
+#include "messaging/events/event_header.hpp"
+#include "types/order_params.hpp"
+#include "utils/inline_vector.hpp"
+#include <cstdint>
+
+// Registro compacto de uma ordem expirada: o suficiente para o relatório ao cliente (ExecType=Expired)
+struct ExpiredOrder
+{
+    uint64_t order_id;
+    uint64_t client_id;
+    uint64_t client_order_id;
+    OrderSide side;
+    double price;
+    uint32_t expired_quantity;
+    uint32_t filled_quantity;
+};
+
+// As ordens de um símbolo que venceram no mesmo avanço do timer (ex: todas as ordens Day no fechamento), em
+// blocos de até kMaxOrders por evento em vez de um evento e um snapshot por ordem.
+//
+// kMaxOrders é o que cabe em kEventRecordBytes depois do cabeçalho, do tamanho da InlineVector e do índice do
+// variant: 4 ordens de 48 bytes em 256. Aumentá-lo aumentaria o registro de todos os eventos, e os aceites e
+// fills (um ou mais por comando) pagariam a cópia maior para favorecer a expiração, que é rara (o fechamento).
+// Um avanço da TimerWheel com centenas de ordens sai em eventos seguidos de 4, todos com o mesmo timestamp,
+// ainda sem alocação e com um único snapshot do livro no fim.
+class OrdersExpiredEvent : public EventHeader 
+{
+public:
+    static constexpr size_t kMaxOrders = (kEventRecordBytes - sizeof(EventHeader) - 2 * sizeof(uint64_t)) / sizeof(ExpiredOrder);
+    using Orders = InlineVector<ExpiredOrder, kMaxOrders>;
+
+    OrdersExpiredEvent() = default;
+    OrdersExpiredEvent(SymbolId symbol_id, const std::chrono::system_clock::time_point& timestamp)
+        : EventHeader(symbol_id, timestamp)
+    {}
+
+    const char* getEventName() const { return "OrdersExpiredEvent"; }
+
+    // Retorna false se o evento já está cheio
+    bool addOrder(const ExpiredOrder& order) { return orders_.push_back(order); }
+    void clearOrders() { orders_.clear(); }
+
+    const Orders& getOrders() const { return orders_; }
+
+private:
+    Orders orders_;
+};
+
+#endif // ORDERS_EXPIRED_EVENT_HPP
@@ -0,0 +1,51 @@
+#ifndef STOP_TRIGGERED_EVENT_HPP
+#define STOP_TRIGGERED_EVENT_HPP
+
+#include "messaging/events/event_header.hpp"
+#include "domain/order.hpp"
+#include <cstdint>
+
+// Publicado quando uma ordem stop sai do TriggerBook e entra no matching. A ordem já vem convertida
+// (Stop/TrailingStop -> Market, StopLimit -> Limit); trigger_price é o último preço negociado no disparo.
+class StopTriggeredEvent : public EventHeader 
+{
+public:
+    StopTriggeredEvent() = default;
+    StopTriggeredEvent(const Order& order, double trigger_price, SymbolId symbol_id, const std::chrono::system_clock::time_point& timestamp) :
+            EventHeader(symbol_id, timestamp),
+            order_id_(order.getOrderId()),
+            client_id_(order.getClientId()),
+            client_order_id_(order.getClientOrderId()),
+            side_(order.getSide()),
+            type_(order.getType()),
+            price_(order.getPrice()),
+            stop_price_(order.getStopPrice()),
+            trigger_price_(trigger_price),
+            quantity_(order.getRemainingQuantity())
+    {}
+
+    const char* getEventName() const { return "StopTriggeredEvent"; }
+
+    uint64_t getOrderId() const { return order_id_; }
+    uint64_t getClientId() const { return client_id_; }
+    uint64_t getClientOrderId() const { return client_order_id_; }
+    OrderSide getSide() const { return side_; }
+    OrderType getType() const { return type_; }
+    double getPrice() const { return price_; }
+    double getStopPrice() const { return stop_price_; }
+    double getTriggerPrice() const { return trigger_price_; }
+    uint32_t getQuantity() const { return quantity_; }
+
+private:
+    uint64_t order_id_;
+    uint64_t client_id_;
+    uint64_t client_order_id_;
+    OrderSide side_;
+    OrderType type_;
+    double price_;
+    double stop_price_;
+    double trigger_price_;
+    uint32_t quantity_;
+};
+
+#endif // STOP_TRIGGERED_EVENT_HPP
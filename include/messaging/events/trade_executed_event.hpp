@@ -3,20 +3,20 @@
 #ifndef TRADE_EXECUTED_EVENT_HPP
 #define TRADE_EXECUTED_EVENT_HPP
 
-#include "messaging/events/event.hpp"
+#include "messaging/events/event_header.hpp"
 #include "domain/trade.hpp"
 #include "domain/order.hpp"
-#include <memory>
-#include <string>
 #include <cstdint>
 
-class TradeExecutedEvent : public Event 
+class TradeExecutedEvent : public EventHeader 
 {
 public:
-    // O construtor copia os dados do Trade e os estados atualizados das ordens.
-    TradeExecutedEvent(const Trade& trade, const Order& aggressive_order, const Order& passive_order)
-        : trade_id_(trade.getTradeId()),
-          symbol_(trade.getSymbol()),
+    TradeExecutedEvent() = default;
+
+    // O construtor copia os dados do Trade e os estados atualizados das ordens. O timestamp é o do Trade.
+    TradeExecutedEvent(const Trade& trade, SymbolId symbol_id, const Order& aggressive_order, const Order& passive_order)
+        : EventHeader(symbol_id, trade.getTimestamp()),
+          trade_id_(trade.getTradeId()),
           price_(trade.getPrice()),
           quantity_(trade.getQuantity()),
           aggressive_order_id_(aggressive_order.getOrderId()),
@@ -24,13 +24,45 @@ public:
           aggressive_order_status_(aggressive_order.getStatus()),
           passive_order_status_(passive_order.getStatus()),
           aggressive_remaining_qty_(aggressive_order.getRemainingQuantity()),
-          passive_remaining_qty_(passive_order.getRemainingQuantity())
+          passive_remaining_qty_(passive_order.getRemainingQuantity()),
+          aggressive_client_id_(aggressive_order.getClientId()),
+          passive_client_id_(passive_order.getClientId()),
+          aggressive_client_order_id_(aggressive_order.getClientOrderId()),
+          passive_client_order_id_(passive_order.getClientOrderId()),
+          aggressive_side_(aggressive_order.getSide()),
+          passive_side_(passive_order.getSide()),
+          aggressive_order_qty_(aggressive_order.getQuantity()),
+          passive_order_qty_(passive_order.getQuantity())
+    {}
+
+    // Usado pelo sweep: as ordens já avançaram para além deste fill, então o estado de cada uma no
+    // momento da execução vem explicitamente (capturado no Fill)
+    TradeExecutedEvent(const Trade& trade, SymbolId symbol_id, const Order& aggressive_order, const Order& passive_order,
+                       OrderStatus aggressive_order_status, uint32_t aggressive_remaining_qty,
+                       OrderStatus passive_order_status, uint32_t passive_remaining_qty)
+        : EventHeader(symbol_id, trade.getTimestamp()),
+          trade_id_(trade.getTradeId()),
+          price_(trade.getPrice()),
+          quantity_(trade.getQuantity()),
+          aggressive_order_id_(aggressive_order.getOrderId()),
+          passive_order_id_(passive_order.getOrderId()),
+          aggressive_order_status_(aggressive_order_status),
+          passive_order_status_(passive_order_status),
+          aggressive_remaining_qty_(aggressive_remaining_qty),
+          passive_remaining_qty_(passive_remaining_qty),
+          aggressive_client_id_(aggressive_order.getClientId()),
+          passive_client_id_(passive_order.getClientId()),
+          aggressive_client_order_id_(aggressive_order.getClientOrderId()),
+          passive_client_order_id_(passive_order.getClientOrderId()),
+          aggressive_side_(aggressive_order.getSide()),
+          passive_side_(passive_order.getSide()),
+          aggressive_order_qty_(aggressive_order.getQuantity()),
+          passive_order_qty_(passive_order.getQuantity())
     {}
 
-    const char* getEventName() const override { return "TradeExecutedEvent"; }
+    const char* getEventName() const { return "TradeExecutedEvent"; }
 
     uint64_t getTradeId() const { return trade_id_; }
-    const std::string& getSymbol() const { return symbol_; }
     double getPrice() const { return price_; }
     uint32_t getQuantity() const { return quantity_; }
     uint64_t getAggressiveOrderId() const { return aggressive_order_id_; }
@@ -40,20 +72,37 @@ public:
     uint32_t getAggressiveRemainingQuantity() const { return aggressive_remaining_qty_; }
     uint32_t getPassiveRemainingQuantity() const { return passive_remaining_qty_; }
 
+    // Identificação de cada lado para os execution reports aos clientes
+    uint64_t getAggressiveClientId() const { return aggressive_client_id_; }
+    uint64_t getPassiveClientId() const { return passive_client_id_; }
+    uint64_t getAggressiveClientOrderId() const { return aggressive_client_order_id_; }
+    uint64_t getPassiveClientOrderId() const { return passive_client_order_id_; }
+    OrderSide getAggressiveSide() const { return aggressive_side_; }
+    OrderSide getPassiveSide() const { return passive_side_; }
+    uint32_t getAggressiveOrderQuantity() const { return aggressive_order_qty_; }
+    uint32_t getPassiveOrderQuantity() const { return passive_order_qty_; }
+
 private:
     // Dados do Trade
-    const uint64_t trade_id_;
-    const std::string symbol_;
-    const double price_;
-    const uint32_t quantity_;
+    uint64_t trade_id_;
+    double price_;
+    uint32_t quantity_;
 
     // Dados das Ordens envolvidas (no momento do evento)
-    const uint64_t aggressive_order_id_;
-    const uint64_t passive_order_id_;
-    const OrderStatus aggressive_order_status_;
-    const OrderStatus passive_order_status_;
-    const uint32_t aggressive_remaining_qty_;
-    const uint32_t passive_remaining_qty_;
+    uint64_t aggressive_order_id_;
+    uint64_t passive_order_id_;
+    OrderStatus aggressive_order_status_;
+    OrderStatus passive_order_status_;
+    uint32_t aggressive_remaining_qty_;
+    uint32_t passive_remaining_qty_;
+    uint64_t aggressive_client_id_;
+    uint64_t passive_client_id_;
+    uint64_t aggressive_client_order_id_;
+    uint64_t passive_client_order_id_;
+    OrderSide aggressive_side_;
+    OrderSide passive_side_;
+    uint32_t aggressive_order_qty_;
+    uint32_t passive_order_qty_;
 };
 
 #endif // TRADE_EXECUTED_EVENT_HPP
\ No newline at end of file
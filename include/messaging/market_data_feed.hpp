@@ -0,0 +1,105 @@
+#ifndef MARKET_DATA_FEED_HPP
+#define MARKET_DATA_FEED_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Formato binário do feed de market data por UDP multicast (ver MulticastMarketDataPublisher e
+// MarketDataSubscriber). Todo datagrama começa com um FeedPacketHeader seguido de 'count' registros de tamanho
+// fixo, na ordem de bytes do host (o feed é pensado para a rede local da engine).
+//
+// - Canal incremental: registros FeedLevelUpdate, cada um com a sua sequência (header.sequence + índice).
+//   Quantidade 0 remove o nível; o assinante que aplica tudo em ordem reproduz o top-N de cada livro.
+// - Canal de snapshot: registros FeedBookSnapshot com o top-N completo de cada símbolo. Todos os pacotes de um
+//   ciclo levam em header.sequence a última sequência incremental que o snapshot já reflete.
+namespace market_data_feed
+{
+
+constexpr uint32_t kMagic = 0x4D44424F; // "OBDM"
+// Payload UDP máximo por datagrama, abaixo do MTU de 1500 da Ethernet para não fragmentar
+constexpr size_t kMaxDatagramBytes = 1400;
+// Profundidade máxima de um snapshot (a engine publica 5 níveis)
+constexpr size_t kMaxSnapshotDepth = 10;
+constexpr size_t kSymbolBytes = 8;
+
+enum PacketKind : uint8_t
+{
+    Incremental = 1,
+    Snapshot = 2
+};
+
+enum PacketFlags : uint8_t
+{
+    SnapshotBegin = 1, // primeiro pacote de um ciclo de snapshot
+    SnapshotEnd = 2    // último pacote de um ciclo de snapshot
+};
+
+struct FeedPacketHeader
+{
+    uint32_t magic;
+    uint8_t kind;          // PacketKind
+    uint8_t flags;         // PacketFlags (só no canal de snapshot)
+    uint16_t count;        // registros após o header
+    uint64_t sequence;     // incremental: sequência do primeiro registro; snapshot: última sequência refletida
+    int64_t send_time_ns;  // system_clock no envio, para a latência publicação -> recebimento
+};
+
+struct FeedLevelUpdate
+{
+    char symbol[kSymbolBytes]; // completado com '\0'
+    uint8_t side;              // OrderSide (1 = compra, 2 = venda)
+    uint8_t reserved[7];
+    double price;
+    uint64_t quantity;         // quantidade total no nível; 0 = nível removido do top-N
+};
+
+struct FeedSnapshotLevel
+{
+    double price;
+    uint64_t quantity;
+};
+
+struct FeedBookSnapshot
+{
+    char symbol[kSymbolBytes];
+    uint8_t bid_count;
+    uint8_t ask_count;
+    uint16_t index;            // posição do símbolo no ciclo, a partir de 0
+    uint16_t total;            // símbolos no ciclo; o assinante só instala o snapshot se receber todos
+    uint8_t reserved[2];
+    FeedSnapshotLevel bids[kMaxSnapshotDepth];
+    FeedSnapshotLevel asks[kMaxSnapshotDepth];
+};
+
+static_assert(sizeof(FeedPacketHeader) == 24, "FeedPacketHeader layout changed");
+static_assert(sizeof(FeedLevelUpdate) == 32, "FeedLevelUpdate layout changed");
+static_assert(sizeof(FeedBookSnapshot) == 336, "FeedBookSnapshot layout changed");
+
+constexpr size_t kUpdatesPerPacket = (kMaxDatagramBytes - sizeof(FeedPacketHeader)) / sizeof(FeedLevelUpdate);
+constexpr size_t kSnapshotsPerPacket = (kMaxDatagramBytes - sizeof(FeedPacketHeader)) / sizeof(FeedBookSnapshot);
+
+inline std::string symbolFromRecord(const char (&symbol)[kSymbolBytes])
+{
+    size_t length = 0;
+    while (length < kSymbolBytes && symbol[length] != '\0') ++length;
+    return std::string(symbol, length);
+}
+
+} // namespace market_data_feed
+
+// Endereços do feed, compartilhados entre o publicador e os assinantes. Os dois canais podem usar o mesmo grupo
+// em portas diferentes. interface_address escolhe a interface de envio/recebimento do multicast; com 127.0.0.1
+// o feed fica no loopback do host.
+struct MulticastFeedOptions
+{
+    std::string group = "239.255.0.1";
+    uint16_t port = 31001;
+    std::string snapshot_group = "239.255.0.1";
+    uint16_t snapshot_port = 31002;
+    std::string interface_address = "127.0.0.1";
+    int ttl = 1;
+    uint32_t snapshot_interval_ms = 500;
+};
+
+#endif // MARKET_DATA_FEED_HPP
@@ -0,0 +1,43 @@
+#ifndef SHM_ORDER_MESSAGE_HPP
+#define SHM_ORDER_MESSAGE_HPP
+
+#include <cstdint>
+#include <string>
+
+// Mensagem binária do transporte em memória compartilhada (ver ShmIngressGateway). Uma linha de cache por
+// mensagem; os códigos seguem os valores das tags FIX equivalentes, então a conversão para comando é direta.
+// O transporte cobre o fluxo dos clientes co-located: Market/Limit/Stop/StopLimit com Day/GTC/IOC/FOK.
+struct ShmOrderMessage
+{
+    enum Type : uint8_t
+    {
+        NewOrder = 'D',
+        Cancel = 'F',
+        Amend = 'G'
+    };
+
+    uint8_t type;              // 35 (MsgType)
+    uint8_t side;              // 54 (OrderSide)
+    uint8_t order_type;        // 40 (OrderType)
+    uint8_t time_in_force;     // 59 (OrderTimeInForce)
+    char capacity;             // 47 (OrderCapacity)
+    uint8_t reserved[3];
+    char symbol[8];            // 55, completado com '\0'
+    uint32_t quantity;         // 38 (no amend, a nova quantidade total)
+    uint32_t sequence;         // sequência da sessão, a partir de 1
+    uint64_t client_order_id;  // 11
+    uint64_t orig_client_order_id; // 41 (cancel/amend)
+    double price;              // 44
+    double stop_price;         // 99
+    int64_t send_timestamp_ns; // steady_clock do host no envio (0 = não informado); vira o intended timestamp do comando
+};
+
+static_assert(sizeof(ShmOrderMessage) == 64, "ShmOrderMessage must fit one cache line");
+
+// Nome do segmento de um cliente, combinado entre o gateway e a biblioteca do cliente
+inline std::string shmIngressSegmentName(uint64_t client_id)
+{
+    return "/orderbook-ingress-" + std::to_string(client_id);
+}
+
+#endif // SHM_ORDER_MESSAGE_HPP
@@ -41,7 +41,8 @@ enum class OrderTimeInForce
 	Day = 1,
 	GoodTillCancelled = 2,
 	ImmediateOrCancel = 3,
-	FillOrKill = 4
+	FillOrKill = 4,
+	GoodTillDate = 6
 };
 
 enum class OrderStatus
@@ -52,7 +53,8 @@ enum class OrderStatus
 	Canceled = 4,
 	Rejected = 5,
 	PendingCancel = 6,
-	PendingNew = 7
+	PendingNew = 7,
+	Expired = 8
 };
 
 enum class OrderCapacity
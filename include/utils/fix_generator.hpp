@@ -2,7 +2,6 @@
 #define FIX_GENERATOR_HPP
 
 #include <string>
-#include <mutex>
 #include <vector>
 #include <random>
 #include <chrono>
@@ -14,7 +13,9 @@
 // Cada thread que chama um método static executa sua própria instância da função.
 // As variáveis LOCAIS dentro do método são privadas de cada thread.
 
-// Apenas variáveis STATIC da classe (como seqnum_) são compartilhadas entre threads.
+// Apenas variáveis STATIC da classe são compartilhadas entre threads. O seqnum_ é thread_local:
+// cada thread simula uma sessão FIX própria, com sua sequência (tag 34) e seus ClOrdIDs (tag 11),
+// e por isso a geração não precisa de mutex e threads não se serializam umas nas outras.
 
 class FixGenerator 
 {
@@ -23,9 +24,11 @@ public:
                                       const std::string& targetCancelId = "", const std::string& orderType = "1", const std::string& timeInForce = "0", const std::string& orderCapacity = "A");
     static std::pair<std::string, std::chrono::system_clock::time_point> generateFIXMessageForThread();
 
+    // Próximo número de sequência da sessão da thread atual, também usado como ClOrdID da mensagem
+    static int peekNextSeqNum() { return seqnum_ + 1; }
+
 private:
-    static int seqnum_;
-    static std::mutex seq_mutex_;
+    static thread_local int seqnum_;
     static std::string calculateChecksum(const std::string& msg);
 };
 
@@ -0,0 +1,149 @@
+#ifndef FIX_MESSAGE_WRITER_HPP
+#define FIX_MESSAGE_WRITER_HPP
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+// Texto "<tag>=" montado em tempo de compilação: cada campo escrito copia um literal curto em vez de formatar a tag
+template<unsigned Tag>
+struct FixTagPrefix
+{
+    static_assert(Tag > 0 && Tag < 100000, "FIX tag out of range");
+    static constexpr size_t digits = Tag >= 10000 ? 5 : Tag >= 1000 ? 4 : Tag >= 100 ? 3 : Tag >= 10 ? 2 : 1;
+
+    static constexpr std::array<char, digits + 1> make()
+    {
+        std::array<char, digits + 1> text{};
+        unsigned value = Tag;
+        for (size_t i = digits; i > 0; --i)
+        {
+            text[i - 1] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+        text[digits] = '=';
+        return text;
+    }
+
+    static constexpr std::array<char, digits + 1> text = make();
+};
+
+// Monta uma mensagem FIX direto num buffer de tamanho fixo, sem alocação nem stringstream. O corpo é escrito a
+// partir de uma folga reservada no início; finish() escreve 8=/9= imediatamente antes dele (o BodyLength só é
+// conhecido no fim) e acrescenta o 10= com o checksum. Se o buffer não comportar a mensagem, finish() retorna vazio.
+//
+//     FixMessageWriter writer(buffer, sizeof(buffer));
+//     writer.field<35>('8');
+//     writer.field<11>(client_order_id);
+//     std::string_view message = writer.finish();
+class FixMessageWriter
+{
+public:
+    static constexpr char kSoh = '\x01';
+
+    FixMessageWriter(char* buffer, size_t capacity)
+        : end_(buffer + capacity), body_(buffer + kHeaderReserve), pos_(body_), overflow_(capacity < kHeaderReserve + kTrailerBytes)
+    {
+    }
+
+    template<unsigned Tag>
+    void field(std::string_view value)
+    {
+        if (!reserve(FixTagPrefix<Tag>::text.size() + value.size() + 1)) return;
+        pos_ = copy(pos_, FixTagPrefix<Tag>::text.data(), FixTagPrefix<Tag>::text.size());
+        pos_ = copy(pos_, value.data(), value.size());
+        *pos_++ = kSoh;
+    }
+
+    template<unsigned Tag>
+    void field(const std::string& value) { field<Tag>(std::string_view(value)); }
+
+    template<unsigned Tag>
+    void field(const char* value) { field<Tag>(std::string_view(value)); }
+
+    template<unsigned Tag>
+    void field(char value) { field<Tag>(std::string_view(&value, 1)); }
+
+    template<unsigned Tag>
+    void field(uint64_t value)
+    {
+        char digits[20];
+        std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+        field<Tag>(std::string_view(digits, static_cast<size_t>(result.ptr - digits)));
+    }
+
+    template<unsigned Tag>
+    void field(uint32_t value) { field<Tag>(static_cast<uint64_t>(value)); }
+
+    // Menor representação que volta ao mesmo double (10.02, não 10.019999999999999)
+    template<unsigned Tag>
+    void field(double value)
+    {
+        char digits[32];
+        std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+        field<Tag>(std::string_view(digits, static_cast<size_t>(result.ptr - digits)));
+    }
+
+    // Fecha a mensagem e retorna o texto completo dentro do buffer (vazio se não coube)
+    std::string_view finish(std::string_view begin_string = "FIX.4.2")
+    {
+        if (overflow_) return {};
+
+        char header[32];
+        char* header_end = copy(header, "8=", 2);
+        header_end = copy(header_end, begin_string.data(), begin_string.size());
+        *header_end++ = kSoh;
+        header_end = copy(header_end, "9=", 2);
+        header_end = std::to_chars(header_end, header + sizeof(header), static_cast<uint64_t>(pos_ - body_)).ptr;
+        *header_end++ = kSoh;
+
+        const size_t header_length = static_cast<size_t>(header_end - header);
+        if (header_length > kHeaderReserve || static_cast<size_t>(end_ - pos_) < kTrailerBytes) return {};
+        char* start = body_ - header_length;
+        copy(start, header, header_length);
+
+        unsigned int sum = 0;
+        for (const char* c = start; c < pos_; ++c) sum += static_cast<unsigned char>(*c);
+        sum %= 256;
+        pos_ = copy(pos_, "10=", 3);
+        *pos_++ = static_cast<char>('0' + sum / 100);
+        *pos_++ = static_cast<char>('0' + sum / 10 % 10);
+        *pos_++ = static_cast<char>('0' + sum % 10);
+        *pos_++ = kSoh;
+        return std::string_view(start, static_cast<size_t>(pos_ - start));
+    }
+
+    bool overflowed() const { return overflow_; }
+
+private:
+    // Espaço para "8=FIX.4.x<SOH>9=nnnnn<SOH>" antes do corpo e para "10=nnn<SOH>" depois dele
+    static constexpr size_t kHeaderReserve = 24;
+    static constexpr size_t kTrailerBytes = 7;
+
+    bool reserve(size_t bytes)
+    {
+        if (overflow_ || static_cast<size_t>(end_ - pos_) < bytes + kTrailerBytes)
+        {
+            overflow_ = true;
+            return false;
+        }
+        return true;
+    }
+
+    static char* copy(char* destination, const char* source, size_t length)
+    {
+        std::memcpy(destination, source, length);
+        return destination + length;
+    }
+
+    char* end_;
+    char* body_;
+    char* pos_;
+    bool overflow_;
+};
+
+#endif // FIX_MESSAGE_WRITER_HPP
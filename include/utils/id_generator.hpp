@@ -0,0 +1,81 @@
+#ifndef ID_GENERATOR_HPP
+#define ID_GENERATOR_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// Ids de 64 bits com o shard nos bits altos: [shard: 10 bits][sequência: 54 bits]. O shard 0 gera 1, 2, 3...
+// (os mesmos ids de antes), e shards diferentes nunca colidem, então várias engines/gateways podem gerar ids
+// sem coordenação.
+//
+// Cada thread consome um bloco pré-reservado de sequências (IdGenerator::next() é um incremento local); só a
+// reserva de um bloco novo toca o contador atômico do shard. Com um arquivo de checkpoint configurado, a marca
+// d'água de cada shard é persistida ANTES de o bloco ser usado, então depois de um restart (mesmo após um
+// crash) os ids continuam acima de tudo o que pode ter sido emitido. Um bloco que não pôde ser persistido não é
+// entregue. O resto de um bloco não usado é descartado.
+class IdBlockAllocator
+{
+public:
+    static constexpr unsigned kShardBits = 10;
+    static constexpr unsigned kSequenceBits = 64 - kShardBits;
+    static constexpr uint32_t kMaxShards = 1u << kShardBits;
+    static constexpr uint64_t kDefaultBlockSize = 1u << 16;
+
+    explicit IdBlockAllocator(uint64_t block_size = kDefaultBlockSize);
+
+    // Retorna a primeira sequência de um bloco [first, first + block_size) exclusivo do shard, ou 0 se o shard
+    // estiver fora de [0, kMaxShards) ou se a nova marca não pôde ser persistida (nenhum id do bloco pode sair)
+    uint64_t reserveBlock(uint32_t shard);
+    uint64_t getBlockSize() const { return block_size_; }
+
+    // Carrega as marcas d'água do arquivo (se existir) e passa a persisti-las a cada bloco reservado. Grava o
+    // checkpoint uma vez já aqui, para um caminho sem permissão de escrita falhar na partida e não no primeiro
+    // bloco. Retorna false se o arquivo não puder ser lido ou gravado.
+    bool setCheckpointFile(const std::string& path);
+    bool saveCheckpoint() const;
+
+private:
+    bool loadCheckpoint(const std::string& path);
+
+    const uint64_t block_size_;
+    std::array<std::atomic<uint64_t>, kMaxShards> high_water_;  // próxima sequência livre de cada shard
+    mutable std::mutex checkpoint_mutex_;                       // só no caminho de reserva
+    std::string checkpoint_path_;
+};
+
+class IdGenerator
+{
+public:
+    // Lança std::out_of_range se shard >= kMaxShards: reduzir o shard módulo kMaxShards faria dois shards
+    // gerarem os mesmos ids
+    IdGenerator(IdBlockAllocator& allocator, uint32_t shard);
+
+    uint64_t next()
+    {
+        if (next_sequence_ == block_end_) refill();
+        return shard_prefix_ | next_sequence_++;
+    }
+
+    uint32_t getShard() const { return static_cast<uint32_t>(shard_prefix_ >> IdBlockAllocator::kSequenceBits); }
+
+    // Shard usado pelos geradores por thread (Order::getNextOrderId, Trade::getNextTradeId). Precisa ser
+    // definido antes do primeiro id gerado pela thread; o padrão é o shard 0. Retorna false (e mantém o shard
+    // atual) se shard >= kMaxShards.
+    static bool setThreadShard(uint32_t shard);
+    static uint32_t threadShard();
+
+    static uint32_t shardOf(uint64_t id) { return static_cast<uint32_t>(id >> IdBlockAllocator::kSequenceBits); }
+
+private:
+    void refill();
+
+    IdBlockAllocator& allocator_;
+    uint64_t shard_prefix_;
+    uint64_t next_sequence_ = 0;
+    uint64_t block_end_ = 0;
+};
+
+#endif // ID_GENERATOR_HPP
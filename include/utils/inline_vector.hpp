@@ -0,0 +1,40 @@
+#ifndef INLINE_VECTOR_HPP
+#define INLINE_VECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Sequência de até N elementos guardada dentro do próprio objeto. Nunca aloca e, como T precisa ser
+// trivialmente copiável, o InlineVector também é: serve para registros de tamanho fixo (ex: os eventos).
+template<typename T, size_t N>
+class InlineVector
+{
+    static_assert(std::is_trivially_copyable<T>::value, "InlineVector requires a trivially copyable type");
+
+public:
+    // Retorna false (sem inserir) se já estiver cheio
+    bool push_back(const T& value)
+    {
+        if (size_ == N) return false;
+        items_[size_++] = value;
+        return true;
+    }
+
+    void clear() { size_ = 0; }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == N; }
+    static constexpr size_t capacity() { return N; }
+
+    const T& operator[](size_t index) const { return items_[index]; }
+    const T* begin() const { return items_; }
+    const T* end() const { return items_ + size_; }
+
+private:
+    uint32_t size_ = 0;
+    T items_[N] = {};
+};
+
+#endif // INLINE_VECTOR_HPP
@@ -0,0 +1,90 @@
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+// Histograma log-linear (no estilo HDR) para latências em nanossegundos.
+// Valores abaixo de 64 ns têm bucket próprio; acima disso cada potência de 2 é dividida em 32 sub-buckets,
+// o que garante erro relativo de no máximo ~3% com memória fixa e registro O(1).
+// Não é thread-safe: cada histograma deve ter um único escritor.
+class LatencyHistogram
+{
+public:
+    void record(uint64_t value_ns)
+    {
+        buckets_[bucketIndex(value_ns)]++;
+        count_++;
+        sum_ += value_ns;
+        min_ = std::min(min_, value_ns);
+        max_ = std::max(max_, value_ns);
+    }
+
+    void merge(const LatencyHistogram& other)
+    {
+        for (size_t i = 0; i < kBucketCount; ++i) buckets_[i] += other.buckets_[i];
+        count_ += other.count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    // Retorna o limite superior do bucket que contém o percentil pedido (0-100)
+    uint64_t percentile(double pct) const
+    {
+        if (count_ == 0) return 0;
+
+        uint64_t rank = static_cast<uint64_t>(pct / 100.0 * count_ + 0.5);
+        rank = std::clamp<uint64_t>(rank, 1, count_);
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBucketCount; ++i)
+        {
+            seen += buckets_[i];
+            if (seen >= rank) return std::min(bucketUpperBound(i), max_);
+        }
+        return max_;
+    }
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+private:
+    static constexpr int kSubBucketBits = 5;
+    static constexpr uint64_t kLinearLimit = 64;
+    static constexpr size_t kBucketCount = kLinearLimit + (64 - 6) * (1 << kSubBucketBits);
+
+    static int highestBit(uint64_t value) { return 63 - __builtin_clzll(value); }
+
+    static size_t bucketIndex(uint64_t value)
+    {
+        if (value < kLinearLimit) return static_cast<size_t>(value);
+
+        int exponent = highestBit(value);
+        uint64_t sub = (value >> (exponent - kSubBucketBits)) & ((1 << kSubBucketBits) - 1);
+        return kLinearLimit + static_cast<size_t>(exponent - 6) * (1 << kSubBucketBits) + sub;
+    }
+
+    static uint64_t bucketUpperBound(size_t index)
+    {
+        if (index < kLinearLimit) return index;
+
+        size_t offset = index - kLinearLimit;
+        int exponent = static_cast<int>(offset >> kSubBucketBits) + 6;
+        uint64_t sub = offset & ((1 << kSubBucketBits) - 1);
+        uint64_t width = 1ULL << (exponent - kSubBucketBits);
+        return (1ULL << exponent) + (sub + 1) * width - 1;
+    }
+
+    std::array<uint64_t, kBucketCount> buckets_{};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t min_ = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ = 0;
+};
+
+#endif // LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,72 @@
+#ifndef LOAD_GENERATOR_HPP
+#define LOAD_GENERATOR_HPP
+
+#include "domain/inbound_gateway.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Configuração do gerador de carga sintético. Todos os campos podem ser sobrescritos pela linha
+// de comando (ver fromArgs), então não é preciso recompilar para variar a carga.
+struct LoadGeneratorConfig
+{
+    enum class PriceDistribution { Uniform, Normal };
+    enum class SizeDistribution { Uniform, Geometric };
+
+    double target_rate = 10000.0;        // mensagens/s somando todas as threads
+    int threads = 2;                     // uma sessão FIX simulada por thread
+    double duration_seconds = 5.0;
+    std::vector<std::string> symbols = {"GOOG", "AMZN", "AAPL", "MSFT"};
+
+    PriceDistribution price_distribution = PriceDistribution::Normal;
+    double price_mid = 100.0;
+    double price_width = 0.10;           // desvio padrão (Normal) ou meia largura (Uniform)
+
+    SizeDistribution size_distribution = SizeDistribution::Uniform;
+    uint32_t min_quantity = 1;
+    uint32_t max_quantity = 100;
+
+    double market_order_ratio = 0.0;     // fração das novas ordens enviadas como 40=1 (Market)
+    double cancel_ratio = 0.0;           // fração das mensagens que são 35=F
+    double amend_ratio = 0.0;            // fração das mensagens que são 35=G
+
+    // Interpreta argumentos no formato --chave=valor. Retorna false se algum argumento for inválido.
+    static bool fromArgs(int argc, char** argv, LoadGeneratorConfig& config);
+    static void printUsage();
+};
+
+struct LoadGeneratorReport
+{
+    uint64_t messages_sent = 0;
+    uint64_t messages_rejected = 0;      // mensagens que o gateway não conseguiu transformar em comando
+    uint64_t new_orders = 0;
+    uint64_t cancels = 0;
+    uint64_t amends = 0;
+    double elapsed_seconds = 0.0;
+    uint64_t max_send_lag_ns = 0;        // maior atraso do envio em relação ao agendamento (sinal de saturação)
+};
+
+// Gerador open-loop: cada thread tem um agendamento fixo (start + i / taxa_por_thread) e envia cada
+// mensagem no seu instante agendado, mesmo que as anteriores tenham atrasado. O instante agendado
+// viaja no Command, e a engine mede a latência a partir dele, o que corrige coordinated omission.
+class LoadGenerator
+{
+public:
+    LoadGenerator(InboundGateway& gateway, const LoadGeneratorConfig& config);
+
+    // Chamado por cada thread cliente antes de começar a enviar (ex: nomear a thread e fixá-la nas CPUs do gateway)
+    void setThreadStartHook(std::function<void(int thread_id)> hook) { thread_start_hook_ = std::move(hook); }
+
+    // Bloqueia até que todas as threads terminem de enviar
+    LoadGeneratorReport run();
+
+private:
+    void producerLoop(int thread_id, LoadGeneratorReport& report);
+
+    InboundGateway& gateway_;
+    LoadGeneratorConfig config_;
+    std::function<void(int)> thread_start_hook_;
+};
+
+#endif // LOAD_GENERATOR_HPP
@@ -3,50 +3,85 @@
 
 #include <mutex>
 #include <condition_variable>
-#include <memory>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "utils/wait_strategy.hpp"
 #include "messaging/events/event.hpp"
 
 class MarketDataChannel {
 public:
     MarketDataChannel() : stop_requested_(false) {}
 
-    // Usado pelo produtor (EventBus) para publicar o novo estado
-    void update(std::shared_ptr<const Event> new_snapshot) {
+    // Define como o consumidor espera por snapshots (ver WaitStrategy)
+    void setWaitStrategy(const WaitStrategy& wait_strategy) { wait_strategy_ = wait_strategy; }
+
+    // Usado pelo produtor (EventBus) para publicar o novo estado de um símbolo. Enquanto o consumidor não retira,
+    // um snapshot novo substitui o pendente do mesmo símbolo, mas símbolos diferentes não se sobrescrevem.
+    void update(SymbolId symbol, const Event& new_snapshot) {
         {
             std::lock_guard<std::mutex> lock(mtx_);
-            latest_snapshot_ = std::move(new_snapshot);
+            if (symbol >= pending_slot_.size()) pending_slot_.resize(symbol + 1, 0);
+            if (pending_slot_[symbol] != 0) {
+                pending_[pending_slot_[symbol] - 1] = new_snapshot;
+            } else {
+                pending_.push_back(new_snapshot);
+                pending_slot_[symbol] = static_cast<uint32_t>(pending_.size());
+            }
+            has_update_.store(true, std::memory_order_release);
         }
         cv_.notify_all(); // Notifica todos os consumidores
     }
 
-    // Usado pelo consumidor (MarketDataGateway) para esperar por uma atualização
-    // Retorna nullptr se o canal for desligado
-    std::shared_ptr<const Event> wait_for_update() {
+    // Usado pelo consumidor (MarketDataGateway): espera até haver snapshots pendentes ou 'deadline' passar e
+    // move para 'out' o último de cada símbolo, na ordem da primeira atualização. Um prazo vencido retorna true
+    // com 'out' vazio; false só depois do shutdown, quando não sobrou nada pendente.
+    bool wait_for_updates(std::vector<Event>& out,
+                          std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()) {
+        wait_strategy_.spinUntil([this]{ return has_update_.load(std::memory_order_acquire) || stop_flag_.load(std::memory_order_acquire); }, deadline);
+
         std::unique_lock<std::mutex> lock(mtx_);
 
-        // Dorme até que 'update' ou 'shutdown' seja chamado
-        cv_.wait(lock, [this]{ return latest_snapshot_ != nullptr || stop_requested_; });
-        
-        if (stop_requested_) {
-            return nullptr;
+        // Dorme até que 'update' ou 'shutdown' seja chamado, ou até o prazo
+        auto ready = [this]{ return !pending_.empty() || stop_requested_; };
+        if (deadline == std::chrono::steady_clock::time_point::max()) cv_.wait(lock, ready);
+        else cv_.wait_until(lock, deadline, ready);
+
+        if (pending_.empty()) {
+            return !stop_requested_;
         }
 
-        return std::move(latest_snapshot_);
+        for (const Event& snapshot : pending_) {
+            out.push_back(snapshot);
+            pending_slot_[getEventHeader(snapshot).getSymbolId()] = 0;
+        }
+        pending_.clear();
+        has_update_.store(false, std::memory_order_relaxed);
+        return true;
     }
 
     void shutdown() {
         {
             std::lock_guard<std::mutex> lock(mtx_);
             stop_requested_ = true;
+            stop_flag_.store(true, std::memory_order_release);
         }
         cv_.notify_all();
     }
 
 private:
-    std::shared_ptr<const Event> latest_snapshot_ = nullptr;
+    // Último snapshot pendente de cada símbolo e, por SymbolId, a posição dele em pending_ mais 1 (0 = nenhum)
+    std::vector<Event> pending_;
+    std::vector<uint32_t> pending_slot_;
     mutable std::mutex mtx_;
     std::condition_variable cv_;
     bool stop_requested_;
+
+    // Espelhos atômicos lidos pelas estratégias de spin sem pegar o mutex
+    std::atomic<bool> has_update_{false};
+    std::atomic<bool> stop_flag_{false};
+    WaitStrategy wait_strategy_;
 };
 
 #endif // MARKET_DATA_CHANNEL_HPP
\ No newline at end of file
@@ -0,0 +1,132 @@
+#ifndef MEMORY_ARENA_HPP
+#define MEMORY_ARENA_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+struct ArenaOptions
+{
+    size_t capacity_bytes = 0;
+    bool use_hugepages = true;     // tenta páginas de 2 MB (MAP_HUGETLB), senão pede transparent hugepages
+    int numa_node = -1;            // -1: nó da thread que cria a arena
+    bool prefault = true;          // toca todas as páginas na criação para não pagar page fault no caminho quente
+};
+
+// Região contígua reservada de uma vez com mmap, de onde saem os nós dos livros, os buffers das filas e o
+// buffer do journal. Com tudo no mesmo bloco (idealmente em páginas de 2 MB), percorrer um livro grande toca
+// poucas entradas de TLB em vez de nós espalhados pelo heap.
+//
+// Alocações pequenas (até kMaxPooledSize) usam free lists por classe de tamanho, então os nós liberados por
+// std::map/std::list são reaproveitados; blocos maiores vão para uma lista first-fit. Se a arena esgotar, a
+// alocação cai no heap (e o deallocate reconhece o endereço pela faixa), então nunca falha por falta de espaço.
+//
+// Não é thread-safe: cada arena tem um único dono (os livros da engine, ou uma fila que já serializa o acesso
+// pelo seu mutex).
+class MemoryArena
+{
+public:
+    static constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+    static constexpr size_t kSizeClassGranularity = 16;
+    static constexpr size_t kMaxPooledSize = 512;
+
+    explicit MemoryArena(const ArenaOptions& options);
+    ~MemoryArena();
+
+    MemoryArena(const MemoryArena&) = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+    void deallocate(void* pointer, size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    // Indica se o endereço está dentro da região mapeada
+    bool owns(const void* pointer) const
+    {
+        const char* p = static_cast<const char*>(pointer);
+        return p >= base_ && p < base_ + capacity_;
+    }
+
+    bool isMapped() const { return base_ != nullptr; }
+    bool usesHugePages() const { return huge_pages_; }
+    int getNumaNode() const { return numa_node_; }
+    size_t capacity() const { return capacity_; }
+    size_t used() const { return offset_; }
+    uint64_t heapFallbacks() const { return heap_fallbacks_; }
+
+    // Nó NUMA da CPU onde a thread atual está rodando (0 se não for possível descobrir)
+    static int currentNumaNode();
+
+    // Nó NUMA de uma CPU, lido de /sys (-1 se desconhecido)
+    static int numaNodeOfCpu(int cpu);
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+        size_t size;
+    };
+
+    void* bump(size_t bytes, size_t alignment);
+    void* heapAllocate(size_t bytes, size_t alignment);
+    void bindToNode(size_t length);
+
+    char* base_ = nullptr;
+    size_t capacity_ = 0;
+    size_t offset_ = 0;
+    bool huge_pages_ = false;
+    int numa_node_ = -1;
+
+    std::array<FreeBlock*, kMaxPooledSize / kSizeClassGranularity> free_lists_{};
+    FreeBlock* large_free_ = nullptr;
+    uint64_t heap_fallbacks_ = 0;
+};
+
+// Allocator STL que tira a memória de uma MemoryArena. Construído sem arena, usa o heap normalmente, então os
+// mesmos tipos de container servem para livros com e sem arena (ex: nos benchmarks).
+template<typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    ArenaAllocator() noexcept = default;
+    explicit ArenaAllocator(MemoryArena* arena) noexcept : arena_(arena) {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.getArena()) {}
+
+    T* allocate(size_t n)
+    {
+        if (arena_ == nullptr)
+        {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, size_t n) noexcept
+    {
+        if (arena_ == nullptr)
+        {
+            ::operator delete(pointer);
+            return;
+        }
+        arena_->deallocate(pointer, n * sizeof(T), alignof(T));
+    }
+
+    MemoryArena* getArena() const noexcept { return arena_; }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena_ == other.getArena(); }
+
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena_ != other.getArena(); }
+
+private:
+    static_assert(alignof(T) <= alignof(std::max_align_t), "ArenaAllocator does not support over-aligned types");
+
+    MemoryArena* arena_ = nullptr;
+};
+
+#endif // MEMORY_ARENA_HPP
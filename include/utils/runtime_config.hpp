@@ -0,0 +1,47 @@
+#ifndef RUNTIME_CONFIG_HPP
+#define RUNTIME_CONFIG_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "utils/wait_strategy.hpp"
+#include "utils/memory_arena.hpp"
+
+// Configuração de deploy lida em tempo de execução, para ajustar afinidade de threads e estratégias de espera
+// ao host sem recompilar. Formato: uma entrada 'chave=valor' por linha, '#' inicia comentário. Ver
+// config/runtime.conf para as chaves reconhecidas; chaves ausentes mantêm o comportamento padrão.
+class RuntimeConfig
+{
+public:
+    // Caminho do arquivo: --config=PATH na linha de comando, senão a variável ORDERBOOK_CONFIG.
+    // Retorna string vazia se nenhum dos dois foi informado.
+    static std::string resolvePath(int argc, char** argv);
+
+    bool loadFile(const std::string& path);
+
+    bool has(const std::string& key) const;
+    std::string getString(const std::string& key, const std::string& fallback = "") const;
+    int64_t getInt(const std::string& key, int64_t fallback) const;
+    bool getBool(const std::string& key, bool fallback) const;
+
+    // Lista de CPUs no formato do kernel (ex: "2", "2-3,6"). Chave ausente ou vazia retorna lista vazia.
+    std::vector<int> getCpuList(const std::string& key) const;
+
+    // Lista de ids separados por vírgula (ex: clientes "1,2,7"). Chave ausente ou inválida retorna lista vazia.
+    std::vector<uint64_t> getIdList(const std::string& key) const;
+
+    // Lê '<prefix>.wait' e '<prefix>.spin_iterations'
+    WaitStrategy getWaitStrategy(const std::string& prefix) const;
+
+    // Lê 'arena.<name>_kb' (0 desliga a arena) e as opções comuns 'arena.hugepages' e 'arena.prefault'.
+    // A arena é ligada ao nó NUMA da primeira CPU do dono; sem CPUs, ao nó da thread que criar a arena.
+    ArenaOptions getArenaOptions(const std::string& name, size_t default_kb, const std::vector<int>& owner_cpus) const;
+
+    static bool parseCpuList(const std::string& text, std::vector<int>& cpus);
+
+private:
+    std::map<std::string, std::string> values_;
+};
+
+#endif // RUNTIME_CONFIG_HPP
@@ -0,0 +1,75 @@
+#ifndef SEQLOCK_HPP
+#define SEQLOCK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Valor publicado por um único escritor e lido por qualquer número de leitores sem lock. O escritor nunca
+// espera: torna a sequência ímpar, copia o valor e a torna par de novo. O leitor copia o valor entre duas
+// leituras da sequência e repete se ela estava ímpar ou mudou no meio (o escritor passou por ali).
+//
+// O valor fica guardado em palavras atômicas lidas/escritas com memory_order_relaxed, então a cópia
+// concorrente não é uma data race no modelo de memória do C++; as fences dão a ordem em relação à sequência.
+// T precisa ser trivialmente copiável. Um leitor só espera enquanto uma escrita está em andamento.
+template<typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock requires a trivially copyable type");
+
+public:
+    SeqLock()
+    {
+        store(T{});
+        sequence_.store(0, std::memory_order_relaxed);
+    }
+
+    // Só o escritor chama
+    void store(const T& value)
+    {
+        uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) words_[i].store(words[i], std::memory_order_relaxed);
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Uma tentativa; retorna false se cruzou com uma escrita (out fica indefinido)
+    bool tryLoad(T& out) const
+    {
+        const uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) return false;
+
+        uint64_t words[kWords];
+        for (size_t i = 0; i < kWords; ++i) words[i] = words_[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) != before) return false;
+
+        std::memcpy(&out, words, sizeof(T));
+        return true;
+    }
+
+    // Repete até obter uma cópia consistente
+    T load() const
+    {
+        T value;
+        while (!tryLoad(value)) {}
+        return value;
+    }
+
+    // Número de publicações desde a construção
+    uint64_t version() const { return sequence_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    // Sequência e dados em linhas de cache próprias: leitores girando na sequência não disputam com vizinhos
+    alignas(64) std::atomic<uint64_t> sequence_{0};
+    alignas(64) std::atomic<uint64_t> words_[kWords];
+};
+
+#endif // SEQLOCK_HPP
@@ -0,0 +1,204 @@
+#ifndef SHM_RING_HPP
+#define SHM_RING_HPP
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <new>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+// Ring SPSC de mensagens de tamanho fixo num segmento de memória compartilhada nomeado (shm_open), para um
+// produtor e um consumidor em processos diferentes no mesmo host. O lado que cria o segmento (o gateway) define
+// a capacidade; o outro lado só o abre. head é escrito só pelo produtor e tail só pelo consumidor, cada um na sua
+// linha de cache; cada lado guarda uma cópia local do índice do outro e só relê o atômico quando ela se esgota.
+template<typename T>
+class ShmSpscRing
+{
+    static_assert(std::is_trivially_copyable<T>::value, "shared memory messages must be trivially copyable");
+
+public:
+    ShmSpscRing() = default;
+    ~ShmSpscRing() { detach(); }
+
+    ShmSpscRing(const ShmSpscRing&) = delete;
+    ShmSpscRing& operator=(const ShmSpscRing&) = delete;
+
+    // Cria (ou recria, zerado) o segmento. capacity é arredondada para potência de dois.
+    bool create(const std::string& name, uint32_t capacity, uint64_t owner_id)
+    {
+        uint32_t slots = 1;
+        while (slots < capacity) slots <<= 1;
+
+        shm_unlink(name.c_str());
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+        {
+            std::cerr << "Failed to create shared memory segment " << name << ": " << std::strerror(errno) << '\n';
+            return false;
+        }
+
+        size_t bytes = sizeof(Header) + static_cast<size_t>(slots) * sizeof(T);
+        if (ftruncate(fd, static_cast<off_t>(bytes)) != 0 || !map(fd, bytes))
+        {
+            std::cerr << "Failed to size/map shared memory segment " << name << ": " << std::strerror(errno) << '\n';
+            close(fd);
+            shm_unlink(name.c_str());
+            return false;
+        }
+        close(fd);
+
+        header_ = new (mapping_) Header();
+        header_->capacity = slots;
+        header_->message_size = sizeof(T);
+        header_->owner_id = owner_id;
+        // O magic por último: quem abrir o segmento antes disso vê um ring ainda não inicializado
+        std::atomic_thread_fence(std::memory_order_release);
+        header_->magic = kMagic;
+
+        name_ = name;
+        owner_ = true;
+        attachSlots();
+        return true;
+    }
+
+    // Abre um segmento criado pelo outro lado
+    bool open(const std::string& name)
+    {
+        int fd = shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0)
+        {
+            std::cerr << "Failed to open shared memory segment " << name << ": " << std::strerror(errno) << '\n';
+            return false;
+        }
+
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header) || !map(fd, static_cast<size_t>(info.st_size)))
+        {
+            std::cerr << "Failed to map shared memory segment " << name << '\n';
+            close(fd);
+            return false;
+        }
+        close(fd);
+
+        header_ = static_cast<Header*>(mapping_);
+        if (header_->magic != kMagic || header_->message_size != sizeof(T) ||
+            sizeof(Header) + static_cast<size_t>(header_->capacity) * sizeof(T) > mapped_bytes_)
+        {
+            std::cerr << "Shared memory segment " << name << " has an incompatible layout\n";
+            detach();
+            return false;
+        }
+
+        name_ = name;
+        owner_ = false;
+        attachSlots();
+        return true;
+    }
+
+    // Desfaz o mapeamento; quem criou o segmento também remove o nome
+    void detach()
+    {
+        if (mapping_)
+        {
+            munmap(mapping_, mapped_bytes_);
+            if (owner_) shm_unlink(name_.c_str());
+        }
+        mapping_ = nullptr;
+        header_ = nullptr;
+        slots_ = nullptr;
+        mapped_bytes_ = 0;
+    }
+
+    bool isAttached() const { return header_ != nullptr; }
+    uint64_t getOwnerId() const { return header_->owner_id; }
+    uint32_t capacity() const { return header_->capacity; }
+    const std::string& getName() const { return name_; }
+
+    // Produtor: copia a mensagem para o próximo slot e a publica. false com o ring cheio.
+    bool tryPush(const T& message)
+    {
+        const uint64_t head = header_->head.load(std::memory_order_relaxed);
+        if (head - cached_tail_ >= header_->capacity)
+        {
+            cached_tail_ = header_->tail.load(std::memory_order_acquire);
+            if (head - cached_tail_ >= header_->capacity) return false;
+        }
+        slots_[head & mask_] = message;
+        header_->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor: quantas mensagens (até max) podem ser lidas no lugar com at(); release() as devolve ao produtor
+    size_t peek(size_t max)
+    {
+        const uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+        if (cached_head_ == tail)
+        {
+            cached_head_ = header_->head.load(std::memory_order_acquire);
+        }
+        size_t available = static_cast<size_t>(cached_head_ - tail);
+        return available < max ? available : max;
+    }
+
+    const T& at(size_t index) const
+    {
+        return slots_[(header_->tail.load(std::memory_order_relaxed) + index) & mask_];
+    }
+
+    void release(size_t count)
+    {
+        header_->tail.store(header_->tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+private:
+    static constexpr uint32_t kMagic = 0x4F425247; // "OBRG"
+
+    struct Header
+    {
+        uint32_t magic = 0;
+        uint32_t capacity = 0;
+        uint32_t message_size = 0;
+        uint64_t owner_id = 0;
+        alignas(64) std::atomic<uint64_t> head{0}; // próxima posição a escrever (produtor)
+        alignas(64) std::atomic<uint64_t> tail{0}; // próxima posição a ler (consumidor)
+    };
+    static_assert(sizeof(Header) % 64 == 0, "slots must start on a cache line");
+
+    bool map(int fd, size_t bytes)
+    {
+        void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) return false;
+        mapping_ = mapping;
+        mapped_bytes_ = bytes;
+        return true;
+    }
+
+    void attachSlots()
+    {
+        slots_ = reinterpret_cast<T*>(reinterpret_cast<char*>(mapping_) + sizeof(Header));
+        mask_ = header_->capacity - 1;
+        cached_head_ = header_->head.load(std::memory_order_acquire);
+        cached_tail_ = header_->tail.load(std::memory_order_acquire);
+    }
+
+    void* mapping_ = nullptr;
+    size_t mapped_bytes_ = 0;
+    Header* header_ = nullptr;
+    T* slots_ = nullptr;
+    uint64_t mask_ = 0;
+    std::string name_;
+    bool owner_ = false;
+
+    // Cópias locais do índice do outro lado (cada objeto é usado por um só lado)
+    uint64_t cached_head_ = 0;
+    uint64_t cached_tail_ = 0;
+};
+
+#endif // SHM_RING_HPP
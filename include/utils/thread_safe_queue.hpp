@@ -1,56 +1,149 @@
 #ifndef THREAD_SAFE_QUEUE_HPP
 #define THREAD_SAFE_QUEUE_HPP
 
-#include <queue>
+#include <vector>
+#include <algorithm>
 #include <mutex>
 #include <memory>
 #include <condition_variable>
+#include <chrono>
+#include <atomic>
+#include "utils/wait_strategy.hpp"
+#include "utils/memory_arena.hpp"
 
 template<typename T>
 class ThreadSafeQueue 
 {
 public:
-    ThreadSafeQueue() : stop_requested_(false) {}
+    // Com uma arena, o buffer da fila sai dela. Todo acesso ao buffer acontece sob o mutex da fila, então a
+    // arena pode ser exclusiva da fila mesmo com vários produtores.
+    explicit ThreadSafeQueue(MemoryArena* arena = nullptr) : buffer_(ArenaAllocator<T>(arena)), stop_requested_(false) {}
+
+    // Define como o consumidor espera por itens (ver WaitStrategy). Deve ser chamado antes de o consumidor começar.
+    void setWaitStrategy(const WaitStrategy& wait_strategy) { wait_strategy_ = wait_strategy; }
+    const WaitStrategy& getWaitStrategy() const { return wait_strategy_; }
 
     // Adiciona um item à fila e notifica um consumidor.
     void push(T item) 
     {
         {
             std::lock_guard<std::mutex> lock(mutex_);
-            queue_.push(std::move(item));
+            pushLocked(std::move(item));
+            pending_.fetch_add(1, std::memory_order_release);
         }
         condition_.notify_one(); 
     }
 
+    // Adiciona todos os itens de 'items' com uma única aquisição do mutex e esvazia o vetor (que pode ser reaproveitado).
+    void push_batch(std::vector<T>& items)
+    {
+        if (items.empty()) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (T& item : items)
+            {
+                pushLocked(std::move(item));
+            }
+            pending_.fetch_add(items.size(), std::memory_order_release);
+        }
+        items.clear();
+        condition_.notify_one();
+    }
+
     // Espera por um item e o retira da fila.
     // Retorna 'false' se a fila foi desligada e está vazia, indicando que o consumidor deve parar.
     bool wait_and_pop(T& value)
     {
+        // Estratégias de spin esperam fora do lock olhando só o contador atômico
+        wait_strategy_.spinUntil([this]{ return hasWork(); });
+
         std::unique_lock<std::mutex> lock(mutex_);
         
         // A thread vai dormir e liberar o mutex até que uma das duas condições seja verdadeira:
         // 1. A fila não está mais vazia.
         // 2. O desligamento foi solicitado.
-        condition_.wait(lock, [this]{ return !queue_.empty() || stop_requested_; });
+        condition_.wait(lock, [this]{ return size_ != 0 || stop_requested_; });
 
         // Após acordar, verificamos por que acordamos.
         // Se o desligamento foi solicitado E a fila estiver vazia, retornamos 'false'.
-        if (stop_requested_ && queue_.empty()) 
+        if (stop_requested_ && size_ == 0) 
         {
             return false;
         }
 
-        value = std::move(queue_.front());
-        queue_.pop();
+        value = popLocked();
+        pending_.fetch_sub(1, std::memory_order_relaxed);
         return true;
     }
 
+    enum class PopResult
+    {
+        Popped,
+        TimedOut,
+        Shutdown
+    };
+
+    // Igual ao wait_and_pop, mas desiste em 'deadline' se nenhum item chegar. Usado por consumidores que
+    // também têm trabalho periódico (ex: a engine avançando os timers de expiração).
+    PopResult wait_and_pop_until(T& value, const std::chrono::steady_clock::time_point& deadline)
+    {
+        wait_strategy_.spinUntil([this]{ return hasWork(); }, deadline);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        if (!condition_.wait_until(lock, deadline, [this]{ return size_ != 0 || stop_requested_; })) 
+        {
+            return PopResult::TimedOut;
+        }
+
+        if (stop_requested_ && size_ == 0) 
+        {
+            return PopResult::Shutdown;
+        }
+
+        value = popLocked();
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        return PopResult::Popped;
+    }
+
+    // Espera como o wait_and_pop (ou até 'deadline') e então move até 'max_items' itens para o fim de 'out' com
+    // uma única aquisição do mutex, amortizando a sincronização quando a fila acumula trabalho.
+    PopResult drain_into(std::vector<T>& out, size_t max_items,
+                         const std::chrono::steady_clock::time_point& deadline = std::chrono::steady_clock::time_point::max())
+    {
+        wait_strategy_.spinUntil([this]{ return hasWork(); }, deadline);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (deadline == std::chrono::steady_clock::time_point::max()) 
+        {
+            condition_.wait(lock, [this]{ return size_ != 0 || stop_requested_; });
+        } 
+        else if (!condition_.wait_until(lock, deadline, [this]{ return size_ != 0 || stop_requested_; })) 
+        {
+            return PopResult::TimedOut;
+        }
+
+        if (stop_requested_ && size_ == 0) 
+        {
+            return PopResult::Shutdown;
+        }
+
+        size_t count = std::min(std::max<size_t>(max_items, 1), size_);
+        for (size_t i = 0; i < count; ++i)
+        {
+            out.push_back(popLocked());
+        }
+        pending_.fetch_sub(count, std::memory_order_relaxed);
+        return PopResult::Popped;
+    }
+
     // Novo método para sinalizar o desligamento da fila.
     void shutdown() 
     {
         {
             std::lock_guard<std::mutex> lock(mutex_);
             stop_requested_ = true;
+            stop_flag_.store(true, std::memory_order_release);
         }
         // Notifica TODAS as threads que possam estar esperando para que elas reavaliem a condição.
         condition_.notify_all();
@@ -59,20 +152,63 @@ public:
     bool empty() const 
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        return queue_.empty();
+        return size_ == 0;
     }
 
     size_t size() const 
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        return queue_.size();
+        return size_;
     }
 
 private:
-    std::queue<T> queue_;
+    bool hasWork() const 
+    {
+        return pending_.load(std::memory_order_acquire) > 0 || stop_flag_.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t kInitialCapacity = 64;
+
+    // Sob o mutex. O buffer circular só cresce (dobra quando enche), então depois que a fila atinge o tamanho
+    // de trabalho push e pop não alocam mais; as posições retiradas guardam o item movido até serem reusadas.
+    void pushLocked(T&& item)
+    {
+        if (size_ == buffer_.size()) grow();
+        buffer_[(head_ + size_) & (buffer_.size() - 1)] = std::move(item);
+        ++size_;
+    }
+
+    T popLocked()
+    {
+        T item = std::move(buffer_[head_]);
+        head_ = (head_ + 1) & (buffer_.size() - 1);
+        --size_;
+        return item;
+    }
+
+    void grow()
+    {
+        std::vector<T, ArenaAllocator<T>> bigger(buffer_.get_allocator());
+        bigger.resize(buffer_.empty() ? kInitialCapacity : buffer_.size() * 2);
+        for (size_t i = 0; i < size_; ++i)
+        {
+            bigger[i] = std::move(buffer_[(head_ + i) & (buffer_.size() - 1)]);
+        }
+        buffer_.swap(bigger);
+        head_ = 0;
+    }
+
+    std::vector<T, ArenaAllocator<T>> buffer_;   // capacidade sempre potência de 2
+    size_t head_ = 0;
+    size_t size_ = 0;
     mutable std::mutex mutex_;
     std::condition_variable condition_;
     bool stop_requested_;
+
+    // Espelhos atômicos do tamanho e do shutdown, lidos pelas estratégias de spin sem pegar o mutex
+    std::atomic<size_t> pending_{0};
+    std::atomic<bool> stop_flag_{false};
+    WaitStrategy wait_strategy_;
 };
 
 #endif // THREAD_SAFE_QUEUE_HPP
\ No newline at end of file
@@ -0,0 +1,21 @@
+#ifndef THREAD_UTILS_HPP
+#define THREAD_UTILS_HPP
+
+#include <string>
+#include <vector>
+
+// Helpers para preparar uma thread do pipeline num host com núcleos isolados (isolcpus/nohz_full).
+// Devem ser chamados pela própria thread, logo no início do seu loop.
+namespace thread_utils
+{
+    // Nome visível em top -H / perf / gdb. O kernel limita a 15 caracteres, o resto é truncado.
+    bool setCurrentThreadName(const std::string& name);
+
+    // Fixa a thread atual nas CPUs informadas. Lista vazia não faz nada (a thread fica livre para migrar).
+    bool pinCurrentThread(const std::vector<int>& cpus);
+
+    // Atalho usado pelas threads do pipeline: nomeia, fixa e loga a afinidade aplicada.
+    void applyThreadRole(const std::string& name, const std::vector<int>& cpus);
+}
+
+#endif // THREAD_UTILS_HPP
@@ -0,0 +1,121 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+// Timer wheel hierárquica (Varghese & Lauck) com 4 níveis de 256 slots. O tempo é medido em ticks inteiros
+// (a engine usa milissegundos de relógio de parede): o nível 0 cobre 256 ticks, o 1 cobre 256^2 e assim por
+// diante; prazos além de 256^4 ticks (~49 dias em ms) ficam numa lista de overflow reavaliada a cada volta
+// completa. Agendar é O(1) e cada entrada desce de nível no máximo 3 vezes antes de disparar.
+//
+// Não há cancelamento: quem agenda deve validar a entrada no disparo (a engine guarda weak_ptr<Order> e
+// ignora ordens que já saíram do livro). Uso single-thread, pela thread da engine.
+template<typename T>
+class TimerWheel
+{
+public:
+    explicit TimerWheel(uint64_t start_tick = 0) : current_tick_(start_tick) {}
+
+    // Agenda 'value' para disparar no tick 'deadline'. Prazos já vencidos disparam no próximo advance().
+    void schedule(uint64_t deadline, T value)
+    {
+        if (deadline <= current_tick_) deadline = current_tick_ + 1;
+        place(Entry{deadline, std::move(value)});
+        ++size_;
+    }
+
+    // Avança até o tick 'now' (inclusive) chamando fire(deadline, value) para cada entrada vencida, em ordem de
+    // prazo. Sem entradas pendentes o relógio salta direto para 'now'.
+    template<typename Fire>
+    void advance(uint64_t now, Fire&& fire)
+    {
+        while (current_tick_ < now)
+        {
+            // Com os níveis de baixo vazios, nenhum tick até a próxima fronteira do primeiro nível ocupado dispara
+            // nada: salta direto para ela (sem entradas pendentes, salta direto para 'now')
+            uint64_t skip_to = current_tick_;
+            for (size_t level = 0; level < kLevels && counts_[level] == 0; ++level)
+            {
+                skip_to = current_tick_ | ((uint64_t{1} << (kBitsPerLevel * (level + 1))) - 1);
+            }
+            if (size_ == 0 || skip_to >= now)
+            {
+                current_tick_ = now;
+                return;
+            }
+
+            current_tick_ = skip_to + 1;
+            cascade();
+
+            std::vector<Entry>& slot = levels_[0][current_tick_ & kSlotMask];
+            if (slot.empty()) continue;
+
+            // Troca o slot por um vetor reaproveitado: fire() pode agendar novas entradas neste mesmo slot
+            firing_.swap(slot);
+            size_ -= firing_.size();
+            counts_[0] -= firing_.size();
+            for (Entry& entry : firing_) fire(entry.deadline, entry.value);
+            firing_.clear();
+        }
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    uint64_t currentTick() const { return current_tick_; }
+
+private:
+    static constexpr size_t kLevels = 4;
+    static constexpr unsigned kBitsPerLevel = 8;
+    static constexpr size_t kSlots = size_t{1} << kBitsPerLevel;
+    static constexpr uint64_t kSlotMask = kSlots - 1;
+
+    struct Entry
+    {
+        uint64_t deadline;
+        T value;
+    };
+
+    void place(Entry entry)
+    {
+        uint64_t delta = entry.deadline - current_tick_;
+        for (size_t level = 0; level < kLevels; ++level)
+        {
+            if (delta < (uint64_t{1} << (kBitsPerLevel * (level + 1))))
+            {
+                levels_[level][(entry.deadline >> (kBitsPerLevel * level)) & kSlotMask].push_back(std::move(entry));
+                ++counts_[level];
+                return;
+            }
+        }
+        overflow_.push_back(std::move(entry));
+    }
+
+    // Quando os bits de um nível viram zero, o slot correspondente do nível acima é redistribuído para baixo
+    void cascade()
+    {
+        for (size_t level = 1; level <= kLevels; ++level)
+        {
+            if ((current_tick_ & ((uint64_t{1} << (kBitsPerLevel * level)) - 1)) != 0) return;
+
+            std::vector<Entry> pending;
+            if (level == kLevels) pending.swap(overflow_);
+            else pending.swap(levels_[level][(current_tick_ >> (kBitsPerLevel * level)) & kSlotMask]);
+            if (level < kLevels) counts_[level] -= pending.size();
+
+            for (Entry& entry : pending) place(std::move(entry));
+        }
+    }
+
+    uint64_t current_tick_;
+    size_t size_ = 0;
+    std::array<size_t, kLevels> counts_{};  // entradas por nível, para saltar ticks vazios
+    std::array<std::array<std::vector<Entry>, kSlots>, kLevels> levels_;
+    std::vector<Entry> overflow_;
+    std::vector<Entry> firing_;
+};
+
+#endif // TIMER_WHEEL_HPP
@@ -0,0 +1,79 @@
+#ifndef WAIT_STRATEGY_HPP
+#define WAIT_STRATEGY_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+// Como um consumidor espera por trabalho numa fila:
+// - Blocking: dorme direto no condition_variable (menor uso de CPU, acordar custa alguns microssegundos)
+// - Yield: checa a fila em loop cedendo o núcleo com yield() entre as checagens
+// - SpinThenPark: gira spin_iterations vezes e só então dorme no condition_variable
+// - BusySpin: gira para sempre; só faz sentido com a thread fixada num núcleo isolado
+struct WaitStrategy
+{
+    enum class Kind
+    {
+        Blocking,
+        Yield,
+        SpinThenPark,
+        BusySpin
+    };
+
+    Kind kind = Kind::Blocking;
+    uint32_t spin_iterations = 20000;
+
+    // Aceita blocking, yield, spin_park e busy_spin
+    static bool parse(const std::string& text, Kind& kind)
+    {
+        if (text == "blocking") kind = Kind::Blocking;
+        else if (text == "yield") kind = Kind::Yield;
+        else if (text == "spin_park") kind = Kind::SpinThenPark;
+        else if (text == "busy_spin") kind = Kind::BusySpin;
+        else return false;
+        return true;
+    }
+
+    const char* name() const
+    {
+        switch (kind)
+        {
+            case Kind::Yield: return "yield";
+            case Kind::SpinThenPark: return "spin_park";
+            case Kind::BusySpin: return "busy_spin";
+            default: return "blocking";
+        }
+    }
+
+    // Espera, sem segurar nenhum lock, até ready() ficar true ou 'deadline' passar. Retorna ready(); um false
+    // significa que o chamador deve estacionar no condition_variable (Blocking, SpinThenPark esgotado ou prazo).
+    template<typename Ready>
+    bool spinUntil(Ready ready, std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()) const
+    {
+        if (kind == Kind::Blocking) return ready();
+
+        const bool has_deadline = deadline != std::chrono::steady_clock::time_point::max();
+        for (uint64_t i = 0; ; ++i)
+        {
+            if (ready()) return true;
+            if (kind == Kind::SpinThenPark && i >= spin_iterations) return false;
+            // Lê o relógio só de vez em quando para não dominar o loop
+            if (has_deadline && (i & 63) == 63 && std::chrono::steady_clock::now() >= deadline) return false;
+
+            if (kind == Kind::Yield) std::this_thread::yield();
+            else cpuRelax();
+        }
+    }
+
+    static void cpuRelax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+};
+
+#endif // WAIT_STRATEGY_HPP
@@ -0,0 +1,259 @@
+#include "client/market_data_subscriber.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace market_data_feed;
+
+MarketDataSubscriber::MarketDataSubscriber(const MulticastFeedOptions& options)
+    : options_(options)
+{
+}
+
+MarketDataSubscriber::~MarketDataSubscriber()
+{
+    close();
+}
+
+bool MarketDataSubscriber::open()
+{
+    incremental_fd_ = openSocket(options_, options_.group, options_.port);
+    snapshot_fd_ = openSocket(options_, options_.snapshot_group, options_.snapshot_port);
+    if (incremental_fd_ < 0 || snapshot_fd_ < 0)
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MarketDataSubscriber::close()
+{
+    if (incremental_fd_ >= 0) ::close(incremental_fd_);
+    if (snapshot_fd_ >= 0) ::close(snapshot_fd_);
+    incremental_fd_ = -1;
+    snapshot_fd_ = -1;
+}
+
+int MarketDataSubscriber::openSocket(const MulticastFeedOptions& options, const std::string& group, uint16_t port)
+{
+    ip_mreq membership{};
+    if (inet_pton(AF_INET, group.c_str(), &membership.imr_multiaddr) != 1 || inet_pton(AF_INET, options.interface_address.c_str(), &membership.imr_interface) != 1)
+    {
+        std::cerr << "MarketDataSubscriber: invalid address " << group << " / " << options.interface_address << '\n';
+        return -1;
+    }
+
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        std::cerr << "MarketDataSubscriber: socket failed: " << std::strerror(errno) << '\n';
+        return -1;
+    }
+
+    // Vários assinantes no mesmo host dividem a porta; o bind no endereço do grupo filtra outros grupos nela
+    int one = 1;
+    int receive_buffer = 4 * 1024 * 1024;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receive_buffer, sizeof(receive_buffer));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr = membership.imr_multiaddr;
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0)
+    {
+        std::cerr << "MarketDataSubscriber: cannot join " << group << ':' << port << ": " << std::strerror(errno) << '\n';
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int MarketDataSubscriber::poll(int timeout_ms)
+{
+    pollfd fds[2] = {{incremental_fd_, POLLIN, 0}, {snapshot_fd_, POLLIN, 0}};
+    int ready = ::poll(fds, 2, timeout_ms);
+    if (ready < 0)
+    {
+        if (errno == EINTR) return 0;
+        std::cerr << "MarketDataSubscriber: poll failed: " << std::strerror(errno) << '\n';
+        return -1;
+    }
+
+    int datagrams = 0;
+    // O canal incremental é lido primeiro: durante a recuperação os pacotes dele ficam guardados até o snapshot
+    for (int i = 0; i < 2; ++i)
+    {
+        if (ready == 0 || !(fds[i].revents & POLLIN)) continue;
+        while (true)
+        {
+            ssize_t length = recv(fds[i].fd, buffer_, sizeof(buffer_), 0);
+            if (length < 0) break;
+            ++datagrams;
+            ++packets_received_;
+            if (i == 0) onIncremental(buffer_, static_cast<size_t>(length));
+            else onSnapshot(buffer_, static_cast<size_t>(length));
+        }
+    }
+    return datagrams;
+}
+
+const MarketDataSubscriber::Book* MarketDataSubscriber::getBook(const std::string& symbol) const
+{
+    std::unordered_map<std::string, Book>::const_iterator it = books_.find(symbol);
+    return it == books_.end() ? nullptr : &it->second;
+}
+
+bool MarketDataSubscriber::validPacket(const char* data, size_t length, uint8_t kind, size_t record_size)
+{
+    if (length < sizeof(FeedPacketHeader)) return false;
+    FeedPacketHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    return header.magic == kMagic && header.kind == kind && length >= sizeof(header) + header.count * record_size;
+}
+
+void MarketDataSubscriber::onIncremental(const char* data, size_t length)
+{
+    if (!validPacket(data, length, Incremental, sizeof(FeedLevelUpdate)))
+    {
+        ++malformed_packets_;
+        return;
+    }
+
+    FeedPacketHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    if (header.send_time_ns > 0 && now_ns > header.send_time_ns) latency_.record(static_cast<uint64_t>(now_ns - header.send_time_ns));
+
+    if (synchronized_ && applyIncremental(data)) return;
+
+    // Fora de sincronia: o pacote espera o próximo snapshot
+    if (buffered_.size() == kMaxBufferedPackets) buffered_.pop_front();
+    buffered_.emplace_back(data, data + sizeof(header) + header.count * sizeof(FeedLevelUpdate));
+}
+
+bool MarketDataSubscriber::applyIncremental(const char* data)
+{
+    FeedPacketHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    const uint64_t last_sequence = header.sequence + header.count - 1;
+
+    if (header.count == 0 || last_sequence < expected_sequence_)
+    {
+        ++duplicate_packets_;
+        return true;
+    }
+    if (header.sequence > expected_sequence_)
+    {
+        std::cerr << "MarketDataSubscriber: sequence gap: expected " << expected_sequence_ << ", got " << header.sequence << '\n';
+        ++gaps_detected_;
+        synchronized_ = false;
+        return false;
+    }
+
+    // Um pacote que se sobrepõe ao que já foi aplicado é aplicado só a partir da sequência esperada
+    for (uint64_t sequence = expected_sequence_; sequence <= last_sequence; ++sequence)
+    {
+        FeedLevelUpdate update;
+        std::memcpy(&update, data + sizeof(header) + (sequence - header.sequence) * sizeof(update), sizeof(update));
+        applyUpdate(update);
+    }
+    updates_applied_ += last_sequence - expected_sequence_ + 1;
+    expected_sequence_ = last_sequence + 1;
+    return true;
+}
+
+void MarketDataSubscriber::applyUpdate(const FeedLevelUpdate& update)
+{
+    Book& book = books_[symbolFromRecord(update.symbol)];
+    if (update.side == 1)
+    {
+        if (update.quantity == 0) book.bids.erase(update.price);
+        else book.bids[update.price] = update.quantity;
+    }
+    else
+    {
+        if (update.quantity == 0) book.asks.erase(update.price);
+        else book.asks[update.price] = update.quantity;
+    }
+}
+
+void MarketDataSubscriber::onSnapshot(const char* data, size_t length)
+{
+    if (!validPacket(data, length, Snapshot, sizeof(FeedBookSnapshot)))
+    {
+        ++malformed_packets_;
+        return;
+    }
+    // Sincronizado, o canal de snapshot não traz nada novo
+    if (synchronized_) return;
+
+    FeedPacketHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.flags & SnapshotBegin)
+    {
+        pending_books_.clear();
+        snapshot_in_progress_ = true;
+        snapshot_sequence_ = header.sequence;
+        snapshot_next_index_ = 0;
+    }
+    else if (!snapshot_in_progress_ || header.sequence != snapshot_sequence_)
+    {
+        snapshot_in_progress_ = false;
+        return;
+    }
+
+    uint16_t total = 0;
+    for (uint16_t i = 0; i < header.count; ++i)
+    {
+        FeedBookSnapshot record;
+        std::memcpy(&record, data + sizeof(header) + i * sizeof(record), sizeof(record));
+        // Um pacote perdido no meio do ciclo invalida o ciclo inteiro
+        if (record.index != snapshot_next_index_)
+        {
+            snapshot_in_progress_ = false;
+            return;
+        }
+        ++snapshot_next_index_;
+        total = record.total;
+
+        Book& book = pending_books_[symbolFromRecord(record.symbol)];
+        for (uint8_t level = 0; level < record.bid_count && level < kMaxSnapshotDepth; ++level) book.bids[record.bids[level].price] = record.bids[level].quantity;
+        for (uint8_t level = 0; level < record.ask_count && level < kMaxSnapshotDepth; ++level) book.asks[record.asks[level].price] = record.asks[level].quantity;
+    }
+
+    if (!(header.flags & SnapshotEnd)) return;
+    snapshot_in_progress_ = false;
+    if (snapshot_next_index_ != total) return;
+
+    books_.swap(pending_books_);
+    pending_books_.clear();
+    expected_sequence_ = snapshot_sequence_ + 1;
+    synchronized_ = true;
+    ++recoveries_;
+    replayBuffered();
+}
+
+void MarketDataSubscriber::replayBuffered()
+{
+    for (const std::vector<char>& packet : buffered_)
+    {
+        FeedPacketHeader header;
+        std::memcpy(&header, packet.data(), sizeof(header));
+        // O que o snapshot já cobre é descartado sem contar como duplicata
+        if (header.sequence + header.count <= expected_sequence_) continue;
+
+        // Faltou um pedaço entre o snapshot e os guardados: os pacotes guardados não servem mais e a recuperação
+        // recomeça com o próximo ciclo de snapshot
+        if (!applyIncremental(packet.data())) break;
+    }
+    buffered_.clear();
+}
@@ -0,0 +1,77 @@
+#include "client/shm_order_client.hpp"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+bool ShmOrderClient::connect(uint64_t client_id)
+{
+    return connect(shmIngressSegmentName(client_id));
+}
+
+bool ShmOrderClient::connect(const std::string& segment_name)
+{
+    if (!ring_.open(segment_name)) return false;
+    sequence_ = 0;
+    return true;
+}
+
+bool ShmOrderClient::sendNewOrder(uint64_t client_order_id, const std::string& symbol, OrderSide side, OrderType type, uint32_t quantity, double price,
+                                  OrderTimeInForce time_in_force, double stop_price, OrderCapacity capacity)
+{
+    ShmOrderMessage message{};
+    message.type = ShmOrderMessage::NewOrder;
+    message.side = static_cast<uint8_t>(side);
+    message.order_type = static_cast<uint8_t>(type);
+    message.time_in_force = static_cast<uint8_t>(time_in_force);
+    message.capacity = static_cast<char>(capacity);
+    message.quantity = quantity;
+    message.client_order_id = client_order_id;
+    message.price = price;
+    message.stop_price = stop_price;
+    return send(message, symbol);
+}
+
+bool ShmOrderClient::sendCancel(uint64_t client_order_id, uint64_t orig_client_order_id, const std::string& symbol, OrderSide side)
+{
+    ShmOrderMessage message{};
+    message.type = ShmOrderMessage::Cancel;
+    message.side = static_cast<uint8_t>(side);
+    message.client_order_id = client_order_id;
+    message.orig_client_order_id = orig_client_order_id;
+    return send(message, symbol);
+}
+
+bool ShmOrderClient::sendAmend(uint64_t client_order_id, uint64_t orig_client_order_id, const std::string& symbol, OrderSide side,
+                               uint32_t new_quantity, double new_price)
+{
+    ShmOrderMessage message{};
+    message.type = ShmOrderMessage::Amend;
+    message.side = static_cast<uint8_t>(side);
+    message.quantity = new_quantity;
+    message.client_order_id = client_order_id;
+    message.orig_client_order_id = orig_client_order_id;
+    message.price = new_price;
+    return send(message, symbol);
+}
+
+bool ShmOrderClient::send(ShmOrderMessage& message, const std::string& symbol)
+{
+    if (!ring_.isAttached())
+    {
+        std::cerr << "ShmOrderClient: not connected\n";
+        return false;
+    }
+    if (symbol.size() > sizeof(message.symbol))
+    {
+        std::cerr << "ShmOrderClient: symbol " << symbol << " longer than " << sizeof(message.symbol) << " bytes\n";
+        return false;
+    }
+
+    std::memcpy(message.symbol, symbol.data(), symbol.size());
+    // A sequência só avança se a mensagem entrar no ring, então um envio recusado pode ser repetido
+    message.sequence = sequence_ + 1;
+    message.send_timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (!ring_.tryPush(message)) return false;
+    ++sequence_;
+    return true;
+}
@@ -1,6 +1,11 @@
 #include "domain/auditor.hpp"
 #include "messaging/events/order_accepted_event.hpp"
 #include "messaging/events/trade_executed_event.hpp"
+#include "messaging/events/order_canceled_event.hpp"
+#include "messaging/events/cancel_rejected_event.hpp"
+#include "messaging/events/order_amended_event.hpp"
+#include "messaging/events/stop_triggered_event.hpp"
+#include "messaging/events/orders_expired_event.hpp"
 #include "utils/timestamp_formatter.hpp"
 #include "domain/order.hpp"
 #include "domain/trade.hpp"
@@ -9,9 +14,9 @@
 #include <filesystem>
 #include <chrono>
 #include <iomanip>
-#include <typeinfo>
+#include <vector>
 
-Auditor::Auditor(ThreadSafeQueue<std::shared_ptr<const Event>>& event_queue, const std::string& log_file_path)
+Auditor::Auditor(ThreadSafeQueue<Event>& event_queue, const std::string& log_file_path)
     : event_queue_(event_queue), 
       log_file_path_(log_file_path)
 {
@@ -37,6 +42,12 @@ bool Auditor::initialize()
         }
     }
     
+    // O buffer precisa ser trocado antes de o arquivo ser aberto
+    if (journal_buffer_ != nullptr)
+    {
+        log_file_.rdbuf()->pubsetbuf(journal_buffer_, static_cast<std::streamsize>(journal_buffer_size_));
+    }
+
     // Abrir arquivo de log com flags que criam o arquivo se não existir
     log_file_.open(log_file_path_, std::ios::out | std::ios::app);
     if (!log_file_.is_open()) 
@@ -58,18 +69,21 @@ bool Auditor::initialize()
 void Auditor::run() 
 {
     std::cout << "[Auditor] Thread started. Waiting for events..." << std::endl;
+    std::vector<Event> batch;
     while (true) 
     {
-        std::shared_ptr<const Event> event;
-        
-        // wait_and_pop bloqueia até que haja um item OU a fila seja desligada
-        // Se wait_and_pop retornar false, significa que a fila foi desligada e está vazia, thread deve terminar
-        if (!event_queue_.wait_and_pop(event)) {
+        // drain_into bloqueia até que haja um item OU a fila seja desligada, e então retira o que estiver
+        // acumulado (até kMaxBatch) com uma única aquisição do mutex. Shutdown: fila desligada e vazia, thread deve terminar
+        if (event_queue_.drain_into(batch, kMaxBatch) == ThreadSafeQueue<Event>::PopResult::Shutdown) {
             break; 
         }
         
-        // Se chegamos aqui, temos um evento válido e devemos logá-lo - Persistir em um banco ou arquivo
-        writeEventLog(event);
+        // Se chegamos aqui, temos eventos válidos e devemos logá-los - Persistir em um banco ou arquivo
+        for (const Event& event : batch) 
+        {
+            writeEventLog(event);
+        }
+        batch.clear();
     }
     std::cout << "Auditor has finished consuming." << std::endl;
     
@@ -79,17 +93,22 @@ void Auditor::run()
     }
 }
 
-void Auditor::writeEventLog(const std::shared_ptr<const Event>& event)
+void Auditor::writeEventLog(const Event& event)
 {
     if (!log_file_.is_open()) {
         std::cerr << "Cannot write event log: log file is not open" << std::endl;
         return;
     }
     
+    log_file_ << formatEventLog(event) << '\n';
+}
+
+std::string Auditor::formatEventLog(const Event& event) const
+{
     std::string eventType = "Unknown";
     std::string eventDetails = "";
     
-    if (auto orderEvent = std::dynamic_pointer_cast<const OrderAcceptedEvent>(event)) {
+    if (auto orderEvent = std::get_if<OrderAcceptedEvent>(&event)) {
         eventType = "OrderAccepted";
         std::stringstream details;
         details << "OrderID:" << orderEvent->getOrderId() 
@@ -101,7 +120,7 @@ void Auditor::writeEventLog(const std::shared_ptr<const Event>& event)
                << " | Price:" << orderEvent->getPrice();
         eventDetails = details.str();
     }
-    else if (auto tradeEvent = std::dynamic_pointer_cast<const TradeExecutedEvent>(event)) {
+    else if (auto tradeEvent = std::get_if<TradeExecutedEvent>(&event)) {
         eventType = "TradeExecuted";
         std::stringstream details;
         details << "TradeID:" << tradeEvent->getTradeId()
@@ -114,13 +133,91 @@ void Auditor::writeEventLog(const std::shared_ptr<const Event>& event)
                << " | PassiveRemainingQty:" << tradeEvent->getPassiveRemainingQuantity();
         eventDetails = details.str();
     }
+    else if (auto canceledEvent = std::get_if<OrderCanceledEvent>(&event)) {
+        eventType = "OrderCanceled";
+        std::stringstream details;
+        details << "OrderID:" << canceledEvent->getOrderId()
+               << " | ClientID:" << canceledEvent->getClientId()
+               << " | ClientOrderID:" << canceledEvent->getClientOrderId()
+               << " | OrigClientOrderID:" << canceledEvent->getOrigClientOrderId()
+               << " | Symbol:" << canceledEvent->getSymbol()
+               << " | Side:" << static_cast<int>(canceledEvent->getSide())
+               << " | Price:" << canceledEvent->getPrice()
+               << " | CanceledQty:" << canceledEvent->getCanceledQuantity()
+               << " | FilledQty:" << canceledEvent->getFilledQuantity();
+        eventDetails = details.str();
+    }
+    else if (auto amendedEvent = std::get_if<OrderAmendedEvent>(&event)) {
+        eventType = "OrderAmended";
+        std::stringstream details;
+        details << "OrderID:" << amendedEvent->getOrderId()
+               << " | ClientID:" << amendedEvent->getClientId()
+               << " | ClientOrderID:" << amendedEvent->getClientOrderId()
+               << " | OrigClientOrderID:" << amendedEvent->getOrigClientOrderId()
+               << " | Symbol:" << amendedEvent->getSymbol()
+               << " | Side:" << static_cast<int>(amendedEvent->getSide())
+               << " | Quantity:" << amendedEvent->getQuantity()
+               << " | RemainingQty:" << amendedEvent->getRemainingQuantity()
+               << " | Price:" << amendedEvent->getPrice()
+               << " | KeptPriority:" << (amendedEvent->keptPriority() ? "Y" : "N");
+        eventDetails = details.str();
+    }
+    else if (auto rejectedEvent = std::get_if<CancelRejectedEvent>(&event)) {
+        eventType = "CancelRejected";
+        std::stringstream details;
+        details << "ClientID:" << rejectedEvent->getClientId()
+               << " | ClientOrderID:" << rejectedEvent->getClientOrderId()
+               << " | OrigClientOrderID:" << rejectedEvent->getOrigClientOrderId()
+               << " | Symbol:" << rejectedEvent->getSymbol()
+               << " | ResponseTo:" << (rejectedEvent->getResponseTo() == CancelRejectedEvent::ResponseTo::Cancel ? "Cancel" : "Amend")
+               << " | Reason:" << rejectedEvent->getReason();
+        eventDetails = details.str();
+    }
+    else if (auto orderRejectedEvent = std::get_if<OrderRejectedEvent>(&event)) {
+        eventType = "OrderRejected";
+        std::stringstream details;
+        details << "OrderID:" << orderRejectedEvent->getOrderId()
+               << " | ClientID:" << orderRejectedEvent->getClientId()
+               << " | ClientOrderID:" << orderRejectedEvent->getClientOrderId()
+               << " | Symbol:" << orderRejectedEvent->getSymbol()
+               << " | Side:" << static_cast<int>(orderRejectedEvent->getSide())
+               << " | Quantity:" << orderRejectedEvent->getQuantity()
+               << " | Price:" << orderRejectedEvent->getPrice()
+               << " | Reason:" << orderRejectedEvent->getReason();
+        eventDetails = details.str();
+    }
+    else if (auto triggeredEvent = std::get_if<StopTriggeredEvent>(&event)) {
+        eventType = "StopTriggered";
+        std::stringstream details;
+        details << "OrderID:" << triggeredEvent->getOrderId()
+               << " | ClientID:" << triggeredEvent->getClientId()
+               << " | ClientOrderID:" << triggeredEvent->getClientOrderId()
+               << " | Symbol:" << triggeredEvent->getSymbol()
+               << " | Side:" << static_cast<int>(triggeredEvent->getSide())
+               << " | Type:" << static_cast<int>(triggeredEvent->getType())
+               << " | Price:" << triggeredEvent->getPrice()
+               << " | StopPrice:" << triggeredEvent->getStopPrice()
+               << " | TriggerPrice:" << triggeredEvent->getTriggerPrice()
+               << " | Qty:" << triggeredEvent->getQuantity();
+        eventDetails = details.str();
+    }
+    else if (auto expiredEvent = std::get_if<OrdersExpiredEvent>(&event)) {
+        eventType = "OrdersExpired";
+        std::stringstream details;
+        details << "Symbol:" << expiredEvent->getSymbol()
+               << " | Count:" << expiredEvent->getOrders().size()
+               << " | Orders:";
+        // Uma entrada OrderID/ClientID/ClientOrderID/ExpiredQty por ordem, na mesma linha do journal
+        for (const ExpiredOrder& order : expiredEvent->getOrders()) {
+            details << " " << order.order_id << "/" << order.client_id << "/" << order.client_order_id << "/" << order.expired_quantity;
+        }
+        eventDetails = details.str();
+    }
     else {
         // Evento genérico
-        eventType = event->getEventName();
+        eventType = getEventName(event);
         eventDetails = "Generic event processed";
     }
     
-    log_file_ << TimestampFormatter::format(event->getTimestamp()) << " - " 
-              << eventType << " - " 
-              << "\"" << eventDetails << "\"\n";
+    return TimestampFormatter::format(getEventHeader(event).getTimestamp()) + " - " + eventType + " - " + "\"" + eventDetails + "\"";
 }
\ No newline at end of file
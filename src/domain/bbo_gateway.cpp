@@ -0,0 +1,90 @@
+#include "domain/bbo_gateway.hpp"
+#include "messaging/events/bbo_event.hpp"
+#include "utils/timestamp_formatter.hpp"
+#include <iostream>
+#include <sstream>
+#include <filesystem>
+
+BboGateway::BboGateway(ThreadSafeQueue<Event>& bbo_queue, const std::string& output_file_path)
+    : bbo_queue_(bbo_queue), output_file_path_(output_file_path)
+{
+}
+
+bool BboGateway::initialize()
+{
+    std::filesystem::path dir_path = std::filesystem::path(output_file_path_).parent_path();
+    if (!dir_path.empty() && !std::filesystem::exists(dir_path)) 
+    {
+        try 
+        {
+            std::filesystem::create_directories(dir_path);
+        } 
+        catch (const std::filesystem::filesystem_error& e) 
+        {
+            std::cerr << "Failed to create BBO log directory: " << e.what() << '\n';
+            return false;
+        }
+    }
+
+    output_file_.open(output_file_path_, std::ios::out | std::ios::trunc);
+    if (!output_file_.is_open()) 
+    {
+        std::cerr << "Failed to open BBO output file: " << output_file_path_ << '\n';
+        return false;
+    }
+
+    std::cout << "BBO output file opened successfully: " << output_file_path_ << '\n';
+    return true;
+}
+
+void BboGateway::run() {
+
+    std::cout << "[BboGateway] Thread started. Waiting for top of book updates..." << std::endl;
+
+    while (true) {
+        Event event;
+        if (!bbo_queue_.wait_and_pop(event)) {
+            break;
+        }
+
+        if (output_file_.is_open()) {
+            output_file_ << formatBboToJSON(event) << "\n";
+        } else {
+            std::cerr << "[BboGateway] Cannot write BBO: output file is not open" << std::endl;
+        }
+    }
+
+    if (output_file_.is_open()) {
+        output_file_.close();
+    }
+
+    std::cout << "BboGateway has finished consuming." << std::endl;
+}
+
+std::string BboGateway::formatBboToJSON(const Event& event) const {
+
+    const auto* bbo = std::get_if<BboEvent>(&event);
+    if (!bbo) {
+        return "{ \"error\": \"Unknown BBO event type\" }";
+    }
+
+    // Uma linha por atualização; lado vazio sai como null
+    const TopOfBook& top = bbo->getTop();
+    std::stringstream ss;
+    ss << "{ \"symbol\": \"" << bbo->getSymbol() << "\", \"seq\": " << bbo->getSequence()
+       << ", \"timestamp\": \"" << TimestampFormatter::format(bbo->getTimestamp()) << "\", \"bid\": ";
+    if (top.hasBid()) {
+        ss << "{ \"price\": " << top.bid_price << ", \"quantity\": " << top.bid_quantity << ", \"orders\": " << top.bid_orders << " }";
+    } else {
+        ss << "null";
+    }
+    ss << ", \"ask\": ";
+    if (top.hasAsk()) {
+        ss << "{ \"price\": " << top.ask_price << ", \"quantity\": " << top.ask_quantity << ", \"orders\": " << top.ask_orders << " }";
+    } else {
+        ss << "null";
+    }
+    ss << " }";
+
+    return ss.str();
+}
@@ -2,16 +2,28 @@
 #include "domain/trade.hpp"
 #include <iostream>
 #include <sstream>
+#include <algorithm>
 #include "messaging/commands/new_order_command.hpp"
+#include "messaging/commands/cancel_order_command.hpp"
+#include "messaging/commands/amend_order_command.hpp"
 #include "messaging/commands/command.hpp"
 #include "messaging/events/trade_executed_event.hpp"
 #include "messaging/events/order_accepted_event.hpp"
 #include "messaging/events/book_snapshot_event.hpp"
+#include "messaging/events/order_canceled_event.hpp"
+#include "messaging/events/cancel_rejected_event.hpp"
+#include "messaging/events/order_rejected_event.hpp"
+#include "messaging/events/order_amended_event.hpp"
+#include "messaging/events/stop_triggered_event.hpp"
+#include "messaging/events/orders_expired_event.hpp"
+#include "messaging/events/bbo_event.hpp"
 #include "utils/timestamp_formatter.hpp" 
+#include "messaging/command_log.hpp"
 
 Engine::Engine(ThreadSafeQueue<std::unique_ptr<Command>>& command_queue, EventBusDispatcher& event_bus)
     : command_queue_(command_queue), 
-      event_bus_(event_bus)
+      event_bus_(event_bus),
+      expiry_wheel_(toTimerTick(std::chrono::system_clock::now()))
 {
 }
 
@@ -39,7 +51,11 @@ bool Engine::initializeOrderBooks(const std::string& symbol)
     }
 
     // Cria um novo OrderBook e adiciona ao mapa
-    order_books_[symbol] = std::make_unique<OrderBook>(symbol);
+    order_books_[symbol] = std::make_unique<OrderBook>(symbol, book_arena_);
+    order_books_[symbol]->setDepthPrefixLevels(depth_prefix_levels_);
+    order_books_[symbol]->setLevelPoolCapacity(level_pool_capacity_);
+    if (auction_uncross_tick_ != 0) order_books_[symbol]->setTradingPhase(TradingPhase::Auction);
+    if (pre_trade_risk_) pre_trade_risk_->addSymbol(symbol);
     std::cout << "OrderBook for symbol " << symbol << " initialized successfully.\n";
     return true;
 }
@@ -47,28 +63,333 @@ bool Engine::initializeOrderBooks(const std::string& symbol)
 void Engine::run() 
 {
     std::cout << "[Engine] Thread started. Waiting for commands..." << std::endl;
+    IdGenerator::setThreadShard(id_shard_);
 
     while (true) 
     {
-        std::unique_ptr<Command> command;
-        
-        // wait_and_pop bloqueia até que haja um item OU a fila seja desligada
-        // Se wait_and_pop retornar false, significa que a fila foi desligada e está vazia, thread deve terminar
-        if (!command_queue_.wait_and_pop(command)) {
-            break; 
+        // Retira até max_batch_size_ comandos com uma única aquisição do mutex; drain_into bloqueia até que haja
+        // um item OU a fila seja desligada (Shutdown: fila desligada e vazia, a thread deve terminar)
+        ThreadSafeQueue<std::unique_ptr<Command>>::PopResult result;
+        if (!hasPendingTimers()) 
+        {
+            result = command_queue_.drain_into(batch_, max_batch_size_);
+        } 
+        else 
+        {
+            // Com expirações ou leilões pendentes a espera é limitada, para os timers andarem mesmo sem comandos chegando
+            result = command_queue_.drain_into(batch_, max_batch_size_, std::chrono::steady_clock::now() + kTimerPollInterval);
         }
-        
-        // Se chegamos aqui, temos um comando válido e devemos executa-lo
-        command->execute(*this);
+        if (result == ThreadSafeQueue<std::unique_ptr<Command>>::PopResult::Shutdown) {
+            break;
+        }
+
+        // O instante dos timers é lido uma vez por lote e vai para o registro junto com os comandos
+        const std::chrono::system_clock::time_point timer_now = hasPendingTimers() ? std::chrono::system_clock::now() : std::chrono::system_clock::time_point{};
+        if (recorder_) recorder_->recordBatch(batch_, timer_now);
+        processBatch(batch_, timer_now);
+
+        // A latência de cada comando vai até a publicação do lote, que é quando os consumidores passam a vê-lo
+        if (latency_histogram_)
+        {
+            std::chrono::steady_clock::time_point done = std::chrono::steady_clock::now();
+            for (const std::unique_ptr<Command>& command : batch_) 
+            {
+                if (command->getIntendedTimestamp() == std::chrono::steady_clock::time_point{}) continue;
+                latency_histogram_->record(std::chrono::duration_cast<std::chrono::nanoseconds>(done - command->getIntendedTimestamp()).count());
+            }
+        }
+        batch_.clear();
     }
     std::cout << "Engine has finished consuming." << std::endl;
 }
 
-void Engine::publishEvent(std::shared_ptr<const Event> event)
+void Engine::processBatch(std::vector<std::unique_ptr<Command>>& batch, const std::chrono::system_clock::time_point& timer_now)
+{
+    // Eventos e market data de todo o lote saem juntos no fim
+    batching_ = true;
+    event_bus_.beginBatch();
+
+    if (timer_now != std::chrono::system_clock::time_point{}) advanceTimers(timer_now);
+    for (std::unique_ptr<Command>& command : batch) 
+    {
+        command->execute(*this);
+    }
+
+    flushBookUpdates();
+    event_bus_.flushBatch();
+}
+
+void Engine::setSessionClose(const std::chrono::system_clock::time_point& session_close)
+{
+    session_close_tick_ = toTimerTick(session_close);
+}
+
+uint64_t Engine::toTimerTick(const std::chrono::system_clock::time_point& time_point)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(time_point.time_since_epoch()).count());
+}
+
+std::chrono::system_clock::time_point Engine::getTimerClock() const
+{
+    return std::chrono::system_clock::time_point(std::chrono::milliseconds(expiry_wheel_.currentTick()));
+}
+
+bool Engine::resetTimerClock(const std::chrono::system_clock::time_point& start)
+{
+    if (!expiry_wheel_.empty()) 
+    {
+        std::cerr << "Cannot reset the timer clock: expirations already scheduled.\n";
+        return false;
+    }
+    expiry_wheel_ = TimerWheel<std::weak_ptr<Order>>(toTimerTick(start));
+    return true;
+}
+
+void Engine::scheduleExpiry(const std::shared_ptr<Order>& order)
+{
+    uint64_t deadline = 0;
+    if (order->getTimeInForce() == OrderTimeInForce::GoodTillDate) deadline = toTimerTick(order->getExpireTime());
+    else if (order->getTimeInForce() == OrderTimeInForce::Day) deadline = session_close_tick_;
+
+    if (deadline != 0) expiry_wheel_.schedule(deadline, order);
+}
+
+void Engine::advanceTimers(const std::chrono::system_clock::time_point& now)
+{
+    // Expirações e leilões disparados aqui levam o instante do avanço
+    event_time_ = now;
+
+    // O leilão de fechamento descruza antes de as ordens Day do mesmo instante expirarem
+    const uint64_t tick = toTimerTick(now);
+    advanceTradingPhases(tick);
+
+    expiry_wheel_.advance(tick, [this](uint64_t, std::weak_ptr<Order>& entry) {
+        std::shared_ptr<Order> order = entry.lock();
+        if (order && (order->isNew() || order->isPartiallyFilled())) expiring_.push_back(std::move(order));
+    });
+
+    if (expiring_.empty()) return;
+
+    // Agrupa por símbolo (e por chegada dentro do símbolo) para publicar um evento e um snapshot por livro
+    std::sort(expiring_.begin(), expiring_.end(), [](const std::shared_ptr<Order>& a, const std::shared_ptr<Order>& b) {
+        return a->getSymbol() != b->getSymbol() ? a->getSymbol() < b->getSymbol() : a->getOrderId() < b->getOrderId();
+    });
+
+    for (size_t begin = 0; begin < expiring_.size(); ) 
+    {
+        const std::string& symbol = expiring_[begin]->getSymbol();
+        size_t end = begin;
+        while (end < expiring_.size() && expiring_[end]->getSymbol() == symbol) ++end;
+
+        OrderBook* orderBook = findOrderBook(symbol);
+        if (!orderBook) 
+        {
+            begin = end;
+            continue;
+        }
+
+        // Um evento cheio é publicado e reaproveitado para as próximas ordens do símbolo
+        OrdersExpiredEvent expired(orderBook->getSymbolId(), event_time_);
+        size_t expired_count = 0;
+        bool book_changed = false;
+        for (size_t i = begin; i < end; ++i) 
+        {
+            Order& order = *expiring_[i];
+            if (orderBook->isResting(order)) 
+            {
+                book_changed = orderBook->affectsTopLevels(order.getSide(), order.getPrice(), kSnapshotDepth) || book_changed;
+                orderBook->removeOrder(order.getClientId(), order.getClientOrderId());
+            } 
+            else if (orderBook->getTriggerBook().contains(order)) 
+            {
+                orderBook->getTriggerBook().removeOrder(order.getClientId(), order.getClientOrderId());
+            } 
+            else 
+            {
+                continue;
+            }
+
+            order.expire();
+            releaseOrder(order);
+            const ExpiredOrder entry{order.getOrderId(), order.getClientId(), order.getClientOrderId(), order.getSide(),
+                                     order.getPrice(), order.getRemainingQuantity(), order.getFilledQuantity()};
+            if (!expired.addOrder(entry)) 
+            {
+                publishEvent(expired);
+                expired.clearOrders();
+                expired.addOrder(entry);
+            }
+            ++expired_count;
+        }
+
+        if (expired_count > 0) 
+        {
+            if (verbose_) std::cout << expired_count << " orders expired for symbol " << symbol << "\n";
+            publishEvent(expired);
+        }
+        publishBookUpdate(*orderBook, book_changed);
+
+        begin = end;
+    }
+
+    // Solta as últimas referências: as ordens expiradas são liberadas aqui
+    expiring_.clear();
+}
+
+void Engine::setOpeningAuction(const std::chrono::system_clock::time_point& open_time)
+{
+    auction_uncross_tick_ = toTimerTick(open_time);
+    for (std::pair<const std::string, std::unique_ptr<OrderBook>>& entry : order_books_) 
+    {
+        entry.second->setTradingPhase(TradingPhase::Auction);
+    }
+}
+
+bool Engine::setClosingAuction(const std::chrono::system_clock::time_point& auction_start)
+{
+    if (session_close_tick_ == 0) 
+    {
+        std::cerr << "Closing auction needs a session close time.\n";
+        return false;
+    }
+    closing_auction_tick_ = toTimerTick(auction_start);
+    return true;
+}
+
+void Engine::advanceTradingPhases(uint64_t tick)
+{
+    if (closing_auction_tick_ != 0 && tick >= closing_auction_tick_) 
+    {
+        closing_auction_tick_ = 0;
+        auction_uncross_tick_ = session_close_tick_;
+        for (std::pair<const std::string, std::unique_ptr<OrderBook>>& entry : order_books_) 
+        {
+            startAuction(entry.first);
+        }
+    }
+
+    if (auction_uncross_tick_ != 0 && tick >= auction_uncross_tick_) 
+    {
+        auction_uncross_tick_ = 0;
+        for (std::pair<const std::string, std::unique_ptr<OrderBook>>& entry : order_books_) 
+        {
+            if (entry.second->inAuction()) uncrossAuction(entry.first);
+        }
+    }
+}
+
+bool Engine::startAuction(const std::string& symbol)
+{
+    OrderBook* orderBook = findOrderBook(symbol);
+    if (!orderBook || orderBook->inAuction()) 
+    {
+        std::cerr << "Cannot start an auction for symbol " << symbol << ": unknown symbol or auction already running.\n";
+        return false;
+    }
+    orderBook->setTradingPhase(TradingPhase::Auction);
+    if (verbose_) std::cout << "Auction started for symbol " << symbol << "\n";
+    return true;
+}
+
+bool Engine::uncrossAuction(const std::string& symbol)
+{
+    OrderBook* orderBook = findOrderBook(symbol);
+    if (!orderBook || !orderBook->inAuction()) 
+    {
+        std::cerr << "Cannot uncross symbol " << symbol << ": unknown symbol or no auction running.\n";
+        return false;
+    }
+
+    auction_fills_.clear();
+    AuctionResult result = orderBook->uncross(auction_fills_);
+    orderBook->setTradingPhase(TradingPhase::Continuous);
+
+    if (verbose_) std::cout << "[Engine] Auction for " << symbol << " uncrossed: " << result.volume << " @ " << result.price << " in "
+                            << result.trades << " trades, imbalance " << result.imbalance << "\n";
+
+    if (result.trades > 0) 
+    {
+        // Um timestamp e um preço para todo o leilão; os eventos saem no lote corrente da engine
+        recordTradePrice(result.price);
+        if (pre_trade_risk_) pre_trade_risk_->updateReferencePrice(symbol, result.price);
+
+        for (const AuctionFill& fill : auction_fills_) 
+        {
+            // Num leilão não há agressor: a compra ocupa o lado agressivo do evento
+            Trade trade(Trade::getNextTradeId(), fill.buy_order->getOrderId(), fill.sell_order->getOrderId(),
+                        symbol, result.price, fill.quantity, event_time_);
+            publishEvent(TradeExecutedEvent(trade, orderBook->getSymbolId(), *fill.buy_order, *fill.sell_order,
+                                            fill.buy_status, fill.buy_remaining, fill.sell_status, fill.sell_remaining));
+            if (fill.buy_remaining == 0) releaseOrder(*fill.buy_order);
+            if (fill.sell_remaining == 0) releaseOrder(*fill.sell_order);
+        }
+        // Solta as referências às ordens que já saíram do livro
+        auction_fills_.clear();
+    }
+
+    // Os stops cruzados pelo preço do leilão disparam já na negociação contínua
+    bool book_changed = processTriggeredStops(*orderBook) || result.trades > 0;
+    publishBookUpdate(*orderBook, book_changed);
+    return true;
+}
+
+bool Engine::readDepthView(const std::string& symbol, BookDepthView& out) const
+{
+    std::unordered_map<std::string, std::unique_ptr<OrderBook>>::const_iterator it = order_books_.find(symbol);
+    if (it == order_books_.end()) return false;
+    out = it->second->readDepthView();
+    return true;
+}
+
+void Engine::publishEvent(const Event& event)
 {
     event_bus_.publish(event);
 }
 
+void Engine::publishBookUpdate(OrderBook& orderBook, bool depth_changed)
+{
+    if (batching_) 
+    {
+        // Poucos livros por lote: uma busca linear basta para juntar as marcas do mesmo livro
+        for (std::pair<OrderBook*, bool>& pending : pending_book_updates_) 
+        {
+            if (pending.first == &orderBook) 
+            {
+                pending.second = pending.second || depth_changed;
+                return;
+            }
+        }
+        pending_book_updates_.emplace_back(&orderBook, depth_changed);
+        return;
+    }
+
+    // O BBO sai primeiro: é o dado mais sensível a latência e vai por um canal que não espera a profundidade
+    const bool top_changed = orderBook.takeTopOfBookChange();
+    if (top_changed) 
+    {
+        publishEvent(BboEvent(orderBook.getSymbolId(), orderBook.getTopOfBook(), orderBook.getTopOfBookSequence(), event_time_));
+    }
+    // A visão por seqlock é atualizada antes do snapshot: leitores na mesma máquina não passam pelo barramento
+    if (top_changed || depth_changed) 
+    {
+        orderBook.publishDepthView(kSnapshotDepth);
+    }
+    if (depth_changed) 
+    {
+        publishEvent(BookSnapshotEvent(orderBook, event_time_, kSnapshotDepth));
+    }
+}
+
+void Engine::flushBookUpdates()
+{
+    batching_ = false;
+    for (const std::pair<OrderBook*, bool>& pending : pending_book_updates_) 
+    {
+        publishBookUpdate(*pending.first, pending.second);
+    }
+    pending_book_updates_.clear();
+}
+
 bool Engine::processNewOrderCommand(std::shared_ptr<Order> new_order_ptr)
 {   
     // order_ptr: imprime o ponteiro compartilhado (std::shared_ptr<Order>), mostra o endereço do objeto gerenciado.
@@ -81,13 +402,15 @@ bool Engine::processNewOrderCommand(std::shared_ptr<Order> new_order_ptr)
         std::cerr << "Received null order pointer in processNewOrderCommand.\n";
         return false; 
     }
+    event_time_ = std::chrono::system_clock::now();
 
     const std::string& symbol = new_order_ptr->getSymbol();
     std::unordered_map<std::string, std::unique_ptr<OrderBook>>::iterator it = order_books_.find(symbol);
     
     if (it == order_books_.end()) 
     {
-        std::cerr << "OrderBook for symbol " << symbol << " not found when processing new order command.\n";
+        // Como no cancel de símbolo desconhecido, o nome é internado só para o reject levar o símbolo pedido
+        rejectOrder(*new_order_ptr, SymbolTable::intern(symbol), "Unknown symbol");
         return false; 
     }
 
@@ -98,76 +421,365 @@ bool Engine::processNewOrderCommand(std::shared_ptr<Order> new_order_ptr)
     if (!orderBookPtr) 
     {
         std::cerr << "OrderBook for symbol " << symbol << " is null when processing new order command.\n";
+        rejectOrder(*new_order_ptr, SymbolTable::intern(symbol), "Unknown symbol");
         return false; 
     }
 
-    std::cout << "Processing new order with ID: " << new_order_ptr->getOrderId() << ", Symbol: " << symbol << ", Side: " << (new_order_ptr->getSide() == OrderSide::Buy ? "Buy" : "Sell") << ", Price: " << new_order_ptr->getPrice() << ", Quantity: " << new_order_ptr->getQuantity() << "\n";
-    std::shared_ptr<OrderAcceptedEvent> order_accepted_event = std::make_shared<OrderAcceptedEvent>(*new_order_ptr);
-    publishEvent(order_accepted_event);
+    if (verbose_) std::cout << "Processing new order with ID: " << new_order_ptr->getOrderId() << ", Symbol: " << symbol << ", Side: " << (new_order_ptr->getSide() == OrderSide::Buy ? "Buy" : "Sell") << ", Price: " << new_order_ptr->getPrice() << ", Quantity: " << new_order_ptr->getQuantity() << "\n";
+
+    // O livro e o TriggerBook são indexados por (client_id, ClOrdID): um ClOrdID repetido é rejeitado antes do
+    // aceite, senão a ordem seria aceita (e talvez executada) e depois não conseguiria descansar
+    if (isClientOrderIdLive(new_order_ptr->getClientId(), new_order_ptr->getClientOrderId(), *orderBookPtr)) 
+    {
+        rejectOrder(*new_order_ptr, orderBookPtr->getSymbolId(), "Duplicate ClOrdID");
+        return false;
+    }
+
+    // Ordens stop não entram no livro: esperam no TriggerBook até um trade cruzar o preço de disparo
+    if (new_order_ptr->isStopOrder()) 
+    {
+        return enterStopOrder(new_order_ptr, *orderBookPtr);
+    }
+
+    if (killUnfillableOrder(new_order_ptr, *orderBookPtr)) 
+    {
+        return true;
+    }
+
+    publishEvent(OrderAcceptedEvent(*new_order_ptr, orderBookPtr->getSymbolId(), event_time_));
    
-    tryMatchOrderWithTopOfBook(new_order_ptr, *orderBookPtr);
+    bool book_changed = executeOrder(new_order_ptr, *orderBookPtr);
+    book_changed = processTriggeredStops(*orderBookPtr) || book_changed;
+
+    // Um único snapshot por comando, depois de todo o sweep (e da cascata de stops), e só quando os níveis publicados mudaram
+    publishBookUpdate(*orderBookPtr, book_changed);
+
+    if (verbose_) orderBookPtr->printOrders();
+
+    return true;
+}
+
+bool Engine::killUnfillableOrder(const std::shared_ptr<Order>& order, OrderBook& orderBook)
+{
+    // Fill-or-Kill é decidido antes de qualquer fill, só olhando a profundidade agregada: uma ordem morta
+    // não muta o livro e gera um único evento (o cancel), sem aceite, trades ou snapshot
+    if (order->getTimeInForce() != OrderTimeInForce::FillOrKill || orderBook.hasLiquidityFor(*order)) 
+    {
+        return false;
+    }
+
+    if (verbose_) std::cout << "FOK order with ID: " << order->getOrderId() << " killed: not enough liquidity\n";
+    order->cancel();
+    releaseOrder(*order);
+    publishEvent(OrderCanceledEvent(*order, order->getClientOrderId(), orderBook.getSymbolId(), event_time_));
+    return true;
+}
+
+bool Engine::executeOrder(std::shared_ptr<Order> order, OrderBook& orderBook)
+{
+    // No leilão nada casa na chegada: a ordem limitada vai para o livro mesmo cruzando o outro lado
+    bool traded = !orderBook.inAuction() && tryMatchOrderWithTopOfBook(order, orderBook);
+    bool rested = false;
+
+    if (!order->isFilled()) 
+    {
+        if (order->getType() == OrderType::Market || order->getTimeInForce() == OrderTimeInForce::ImmediateOrCancel ||
+            order->getTimeInForce() == OrderTimeInForce::FillOrKill) 
+        {
+            // Ordem a mercado e IOC nunca descansam no livro: o que sobrou depois de varrer a liquidez é cancelado
+            order->cancel();
+            releaseOrder(*order);
+            publishEvent(OrderCanceledEvent(*order, order->getClientOrderId(), orderBook.getSymbolId(), event_time_));
+        } 
+        else if (orderBook.addOrder(order)) 
+        {
+            if (verbose_) std::cout << "Order with ID: " << order->getOrderId() << " added to OrderBook for symbol: " << orderBook.getSymbol() << "\n";
+            rested = orderBook.affectsTopLevels(order->getSide(), order->getPrice(), kSnapshotDepth);
+            scheduleExpiry(order);
+        }
+        else 
+        {
+            // A chave já está no livro (um stop disparado cujo ClOrdID foi reaproveitado): a ordem já foi aceita,
+            // então o restante é cancelado para ela chegar a um estado terminal e liberar o limite de risco
+            std::cerr << "Order " << order->getClientOrderId() << " could not rest: duplicate ClOrdID for client " << order->getClientId() << ", remainder canceled.\n";
+            order->cancel();
+            releaseOrder(*order);
+            publishEvent(OrderCanceledEvent(*order, order->getClientOrderId(), orderBook.getSymbolId(), event_time_));
+        }
+    }
+
+    return traded || rested;
+}
+
+bool Engine::enterStopOrder(std::shared_ptr<Order> order, OrderBook& orderBook)
+{
+    bool is_buy = order->getSide() == OrderSide::Buy;
+    double reference_price = 0.0;
+
+    if (order->getType() == OrderType::TrailingStop) 
+    {
+        // O trailing stop anda a partir do último trade; sem trade no símbolo, o StopPx informado é o stop inicial
+        if (order->getTrailingOffset() <= 0.0 || (!orderBook.hasTraded() && order->getStopPrice() <= 0.0)) 
+        {
+            rejectOrder(*order, orderBook.getSymbolId(), "Trailing stop needs a positive offset and a reference price");
+            return false;
+        }
+        reference_price = orderBook.hasTraded() ? orderBook.getLastTradePrice() :
+                          is_buy ? order->getStopPrice() - order->getTrailingOffset() : order->getStopPrice() + order->getTrailingOffset();
+    } 
+    else if (order->getStopPrice() <= 0.0) 
+    {
+        rejectOrder(*order, orderBook.getSymbolId(), "Missing stop price");
+        return false;
+    }
+
+    if (!orderBook.getTriggerBook().addOrder(order, reference_price)) 
+    {
+        rejectOrder(*order, orderBook.getSymbolId(), "Duplicate ClOrdID");
+        return false;
+    }
+
+    publishEvent(OrderAcceptedEvent(*order, orderBook.getSymbolId(), event_time_));
+    scheduleExpiry(order);
+
+    // Um stop que já nasce cruzado pelo último trade dispara imediatamente
+    if (orderBook.hasTraded()) 
+    {
+        recordTradePrice(orderBook.getLastTradePrice());
+        publishBookUpdate(orderBook, processTriggeredStops(orderBook));
+    }
+    return true;
+}
+
+void Engine::rejectOrder(const Order& order, SymbolId symbol_id, const char* reason)
+{
+    std::cerr << "Order " << order.getClientOrderId() << " from client " << order.getClientId() << " rejected: " << reason << ".\n";
+    releaseOrder(order);
+    publishEvent(OrderRejectedEvent(order.getOrderId(), order.getClientId(), order.getClientOrderId(), symbol_id, order.getSide(),
+                                    order.getQuantity(), order.getPrice(), reason, event_time_));
+}
+
+bool Engine::isClientOrderIdLive(uint64_t client_id, uint64_t client_order_id, OrderBook& orderBook)
+{
+    return orderBook.containsOrder(client_id, client_order_id) || orderBook.getTriggerBook().contains(client_id, client_order_id);
+}
+
+void Engine::recordTradePrice(double price)
+{
+    if (!pending_trades_) 
+    {
+        trade_low_ = price;
+        trade_high_ = price;
+        pending_trades_ = true;
+        return;
+    }
+    trade_low_ = std::min(trade_low_, price);
+    trade_high_ = std::max(trade_high_, price);
+}
 
-    if (!new_order_ptr->isFilled() && orderBookPtr->addOrder(new_order_ptr)) 
+bool Engine::processTriggeredStops(OrderBook& orderBook)
+{
+    bool book_changed = false;
+    TriggerBook& trigger_book = orderBook.getTriggerBook();
+
+    // A cascata é tratada em rodadas, sem recursão: cada rodada libera os stops cruzados pelos trades da
+    // rodada anterior e os executa em ordem de chegada. Como cada stop sai do TriggerBook ao disparar,
+    // o número de rodadas é limitado pelo número de stops do símbolo.
+    while (pending_trades_ && !trigger_book.empty()) 
     {
-        std::cout << "Order with ID: " << new_order_ptr->getOrderId() << " added to OrderBook for symbol: " << symbol << "\n";
-        std::shared_ptr<BookSnapshotEvent> book_snapshot_event = std::make_shared<BookSnapshotEvent>(*orderBookPtr);
-        publishEvent(book_snapshot_event);
+        pending_trades_ = false;
+        const double last_price = orderBook.getLastTradePrice();
+        trigger_book.collectTriggered(trade_low_, trade_high_, last_price, triggered_);
+
+        for (std::shared_ptr<Order>& order : triggered_) 
+        {
+            order->trigger();
+            if (verbose_) std::cout << "Stop order with ID: " << order->getOrderId() << " triggered at " << last_price << "\n";
+            publishEvent(StopTriggeredEvent(*order, last_price, orderBook.getSymbolId(), event_time_));
+            if (!killUnfillableOrder(order, orderBook)) book_changed = executeOrder(order, orderBook) || book_changed;
+        }
+        triggered_.clear();
     }
 
-    orderBookPtr->printOrders();
+    pending_trades_ = false;
+    return book_changed;
+}
 
+bool Engine::setIdShard(uint32_t shard)
+{
+    if (shard >= IdBlockAllocator::kMaxShards) 
+    {
+        std::cerr << "Engine id shard " << shard << " out of range (max " << IdBlockAllocator::kMaxShards - 1 << ").\n";
+        return false;
+    }
+    id_shard_ = shard;
     return true;
 }
 
-void Engine::tryMatchOrderWithTopOfBook(std::shared_ptr<Order> aggressive_order, OrderBook& orderBook) 
+void Engine::setDepthPrefixLevels(size_t levels)
 {
-    bool is_buy_side = aggressive_order->getSide() == OrderSide::Buy;
-    std::shared_ptr<Order> passive_order = is_buy_side ? orderBook.getTopAsk() : orderBook.getTopBid();
-    bool is_aggresive = (is_buy_side && passive_order && aggressive_order->getPrice() >= passive_order->getPrice()) ||
-                        (!is_buy_side && passive_order && aggressive_order->getPrice() <= passive_order->getPrice());
+    depth_prefix_levels_ = levels;
+    for (std::pair<const std::string, std::unique_ptr<OrderBook>>& entry : order_books_) 
+    {
+        entry.second->setDepthPrefixLevels(levels);
+    }
+}
 
-    if (passive_order && is_aggresive)
-    {   
-        while(passive_order && aggressive_order->getRemainingQuantity() > 0 && is_aggresive) 
+void Engine::setLevelPoolCapacity(size_t levels)
+{
+    level_pool_capacity_ = levels;
+    for (std::pair<const std::string, std::unique_ptr<OrderBook>>& entry : order_books_) 
+    {
+        entry.second->setLevelPoolCapacity(levels);
+    }
+}
+
+OrderBook* Engine::findOrderBook(const std::string& symbol)
+{
+    std::unordered_map<std::string, std::unique_ptr<OrderBook>>::iterator it = order_books_.find(symbol);
+    return it == order_books_.end() ? nullptr : it->second.get();
+}
+
+bool Engine::processCancelOrderCommand(const CancelOrderCommand& command)
+{
+    event_time_ = std::chrono::system_clock::now();
+    OrderBook* orderBook = findOrderBook(command.getSymbol());
+    if (!orderBook) 
+    {
+        // Símbolo sem livro: o nome ainda entra na tabela para o reject levar o Symbol que o cliente mandou
+        publishEvent(CancelRejectedEvent(command.getClientId(), command.getClientOrderId(), command.getOrigClientOrderId(), SymbolTable::intern(command.getSymbol()),
+                                         CancelRejectedEvent::ResponseTo::Cancel, "Unknown symbol", event_time_));
+        return false;
+    }
+
+    // Um probe no índice do livro resolve OrigClOrdID -> ordem; o unlink é O(1) e o agregado do nível
+    // é decrementado pela quantidade restante, sem recalcular o livro
+    std::shared_ptr<Order> canceled_order = orderBook->removeOrder(command.getClientId(), command.getOrigClientOrderId());
+    if (!canceled_order) 
+    {
+        // Uma ordem stop ainda não disparada não está no livro visível, então o cancel não gera market data
+        canceled_order = orderBook->getTriggerBook().removeOrder(command.getClientId(), command.getOrigClientOrderId());
+        if (canceled_order) 
         {
-            // Atualiza a ordem agressiva com as novas quantidades
-            uint32_t filled_qty = std::min<uint32_t>(aggressive_order->getRemainingQuantity(), passive_order->getRemainingQuantity());
+            canceled_order->cancel();
+            releaseOrder(*canceled_order);
+            publishEvent(OrderCanceledEvent(*canceled_order, command.getClientOrderId(), orderBook->getSymbolId(), event_time_));
+            return true;
+        }
 
-            aggressive_order->applyFill(filled_qty, passive_order->getPrice());
-            passive_order->applyFill(filled_qty, passive_order->getPrice());
 
-            // Update aggregated quantity in the OrderBook
-            orderBook.updateAggregatedQuantity(passive_order->getSide(), passive_order->getPrice(), filled_qty);
+        publishEvent(CancelRejectedEvent(command.getClientId(), command.getClientOrderId(), command.getOrigClientOrderId(), orderBook->getSymbolId(),
+                                         CancelRejectedEvent::ResponseTo::Cancel, "Unknown order", event_time_));
+        return false;
+    }
 
-            std::shared_ptr<Trade> trade = std::make_shared<Trade>(
-                Trade::getNextTradeId(), aggressive_order->getOrderId(), passive_order->getOrderId(),
-                orderBook.getSymbol(), passive_order->getPrice(), filled_qty, std::chrono::system_clock::now()
-            );
-            
-            std::cout << "#TRADE <" << trade->getTradeId() << "> executed <" << trade->getSymbol() << "> - Qty: " << trade->getQuantity() << " @ Price: " << trade->getPrice()
-                    << " | Aggressive ID: <" << trade->getAggressiveOrderId() << ">, Passive ID: <" << trade->getPassiveOrderId() << ">" << " | Aggressive Remaining: " << aggressive_order->getRemainingQuantity()
-                    << ", Passive Remaining: " << passive_order->getRemainingQuantity() << ", Filled Qty: " << filled_qty << "\n";
+    canceled_order->cancel();
+    releaseOrder(*canceled_order);
+    publishEvent(OrderCanceledEvent(*canceled_order, command.getClientOrderId(), orderBook->getSymbolId(), event_time_));
 
-            std::shared_ptr<TradeExecutedEvent> trade_event = std::make_shared<TradeExecutedEvent>(*trade, *aggressive_order, *passive_order);
-            publishEvent(trade_event);
+    // Cancelamentos fora dos níveis publicados não mudam o snapshot, então não geram market data
+    publishBookUpdate(*orderBook, orderBook->affectsTopLevels(canceled_order->getSide(), canceled_order->getPrice(), kSnapshotDepth));
 
-            if (passive_order->isFilled()) 
-            {
-                std::cout << "Order with ID: " << passive_order->getOrderId() << " is fully filled with average price: " << passive_order->getAveragePrice() << "\n";
-                orderBook.removeOrder(passive_order->getOrderId());
-            }
+    if (verbose_) std::cout << "Order with ID: " << canceled_order->getOrderId() << " canceled, remaining quantity: " << canceled_order->getRemainingQuantity() << "\n";
+    return true;
+}
+
+bool Engine::processAmendOrderCommand(const AmendOrderCommand& command)
+{
+    event_time_ = std::chrono::system_clock::now();
+    OrderBook* orderBook = findOrderBook(command.getSymbol());
+    if (!orderBook) 
+    {
+        publishEvent(CancelRejectedEvent(command.getClientId(), command.getClientOrderId(), command.getOrigClientOrderId(), SymbolTable::intern(command.getSymbol()),
+                                         CancelRejectedEvent::ResponseTo::Amend, "Unknown symbol", event_time_));
+        return false;
+    }
+
+    // O livro só confere as próprias chaves: um novo ClOrdID que pertence a um stop vivo também é recusado
+    if (command.getClientOrderId() != command.getOrigClientOrderId() &&
+        orderBook->getTriggerBook().contains(command.getClientId(), command.getClientOrderId())) 
+    {
+        publishEvent(CancelRejectedEvent(command.getClientId(), command.getClientOrderId(), command.getOrigClientOrderId(), orderBook->getSymbolId(),
+                                         CancelRejectedEvent::ResponseTo::Amend, "Duplicate ClOrdID", event_time_));
+        return false;
+    }
+
+    AmendOutcome outcome = orderBook->amendOrder(command.getClientId(), command.getOrigClientOrderId(), command.getClientOrderId(),
+                                                 command.getNewQuantity(), command.getNewPrice());
+    if (outcome.result != AmendOutcome::Result::Amended) 
+    {
+        const char* reason = outcome.result == AmendOutcome::Result::UnknownOrder ? "Unknown order" :
+                             outcome.result == AmendOutcome::Result::InvalidQuantity ? "New quantity not above filled quantity" :
+                                                                                       "Duplicate ClOrdID";
+        publishEvent(CancelRejectedEvent(command.getClientId(), command.getClientOrderId(), command.getOrigClientOrderId(), orderBook->getSymbolId(),
+                                         CancelRejectedEvent::ResponseTo::Amend, reason, event_time_));
+        return false;
+    }
 
-            std::shared_ptr<BookSnapshotEvent> book_snapshot_event = std::make_shared<BookSnapshotEvent>(orderBook);
-            publishEvent(book_snapshot_event);
+    std::shared_ptr<Order>& order = outcome.order;
+    publishEvent(OrderAmendedEvent(*order, command.getOrigClientOrderId(), outcome.kept_priority, orderBook->getSymbolId(), event_time_));
 
-            passive_order = is_buy_side ? orderBook.getTopAsk() : orderBook.getTopBid();
-            is_aggresive = (is_buy_side && passive_order && aggressive_order->getPrice() >= passive_order->getPrice()) ||
-                           (!is_buy_side && passive_order && aggressive_order->getPrice() <= passive_order->getPrice());
+    // Se o novo preço cruza o lado oposto, a ordem deixa de ser passiva: sai do livro, é casada como
+    // agressora e o restante (se houver) volta para o fim da fila do seu preço
+    if (!orderBook->inAuction() && orderBook->isMarketable(*order)) 
+    {
+        orderBook->removeOrder(order->getClientId(), order->getClientOrderId());
+        tryMatchOrderWithTopOfBook(order, *orderBook);
+        if (!order->isFilled() && !orderBook->addOrder(order)) 
+        {
+            // Mesmo caso de executeOrder: a chave foi ocupada durante a varredura (um stop disparado com o mesmo
+            // ClOrdID), então o restante é cancelado em vez de sumir do livro sem estado terminal nem liberar o risco
+            std::cerr << "Amended order " << order->getClientOrderId() << " could not rest: duplicate ClOrdID for client " << order->getClientId() << ", remainder canceled.\n";
+            order->cancel();
+            releaseOrder(*order);
+            publishEvent(OrderCanceledEvent(*order, order->getClientOrderId(), orderBook->getSymbolId(), event_time_));
         }
+        processTriggeredStops(*orderBook);
+        publishBookUpdate(*orderBook, true);
+        return true;
+    }
 
-        std::cout << "Order with ID: " << aggressive_order->getOrderId() << " is " << (aggressive_order->getRemainingQuantity() == 0 ? "fully" : "partially") << " filled with average price: " 
-                  << aggressive_order->getAveragePrice() << ", remaining quantity: " << aggressive_order->getRemainingQuantity() << (aggressive_order->getRemainingQuantity() == 0 ? " and will not be added to the book\n" : " and will be added to the book\n");
-    } 
+    publishBookUpdate(*orderBook, orderBook->affectsTopLevels(order->getSide(), outcome.previous_price, kSnapshotDepth) ||
+                                  orderBook->affectsTopLevels(order->getSide(), order->getPrice(), kSnapshotDepth));
+
+    return true;
+}
+
+bool Engine::tryMatchOrderWithTopOfBook(std::shared_ptr<Order> aggressive_order, OrderBook& orderBook) 
+{
+    fills_.clear();
+    orderBook.sweep(*aggressive_order, fills_);
+
+    if (fills_.empty()) return false;
+
+    // Todos os fills de um mesmo sweep compartilham o timestamp do comando (event_time_)
+    // Um sweep percorre os preços em ordem, então a faixa negociada é dada pelo primeiro e pelo último fill
+    recordTradePrice(fills_.front().price);
+    recordTradePrice(fills_.back().price);
+    if (pre_trade_risk_) pre_trade_risk_->updateReferencePrice(orderBook.getSymbol(), fills_.back().price);
+
+    for (const Fill& fill : fills_) 
+    {
+        const Order& passive_order = *fill.passive_order;
+        Trade trade(Trade::getNextTradeId(), aggressive_order->getOrderId(), passive_order.getOrderId(),
+                    orderBook.getSymbol(), fill.price, fill.quantity, event_time_);
+
+        if (verbose_) std::cout << "#TRADE <" << trade.getTradeId() << "> executed <" << trade.getSymbol() << "> - Qty: " << trade.getQuantity() << " @ Price: " << trade.getPrice()
+                << " | Aggressive ID: <" << trade.getAggressiveOrderId() << ">, Passive ID: <" << trade.getPassiveOrderId() << ">" << " | Aggressive Remaining: " << fill.aggressive_remaining
+                << ", Passive Remaining: " << fill.passive_remaining << ", Filled Qty: " << fill.quantity << "\n";
+
+        publishEvent(TradeExecutedEvent(trade, orderBook.getSymbolId(), *aggressive_order, passive_order,
+                                        fill.aggressive_status, fill.aggressive_remaining, fill.passive_status, fill.passive_remaining));
+        if (fill.passive_remaining == 0) releaseOrder(passive_order);
+    }
+    if (aggressive_order->isFilled()) releaseOrder(*aggressive_order);
+
+    if (verbose_) std::cout << "Order with ID: " << aggressive_order->getOrderId() << " is " << (aggressive_order->getRemainingQuantity() == 0 ? "fully" : "partially") << " filled with average price: " 
+              << aggressive_order->getAveragePrice() << ", remaining quantity: " << aggressive_order->getRemainingQuantity() << "\n";
+
+    // Solta as referências às passivas que já saíram do livro
+    fills_.clear();
+    return true;
 }
 
 void Engine::printOrderBooks() const 
@@ -1,30 +1,38 @@
 #include "domain/event_bus_dispatcher.hpp"
-#include "messaging/events/order_accepted_event.hpp"
-#include "messaging/events/trade_executed_event.hpp"
-#include "messaging/events/book_snapshot_event.hpp"
-#include <iostream>
 
-EventBusDispatcher::EventBusDispatcher(ThreadSafeQueue<std::shared_ptr<const Event>>& event_queue, MarketDataChannel& market_data_channel)
-    : event_queue_(event_queue), market_data_channel_(market_data_channel)
+EventBusDispatcher::EventBusDispatcher(ThreadSafeQueue<Event>& event_queue, MarketDataChannel& market_data_channel, ThreadSafeQueue<Event>& bbo_queue)
+    : event_queue_(event_queue), market_data_channel_(market_data_channel), bbo_queue_(bbo_queue)
 {
 }
 
-void EventBusDispatcher::publish(std::shared_ptr<const Event> event) {
-    if (!event) {
-        std::cerr << "Attempted to publish a null event." << std::endl;
-        return;
-    }
-
-    if (dynamic_cast<const OrderAcceptedEvent*>(event.get()) || dynamic_cast<const TradeExecutedEvent*>(event.get()))
+void EventBusDispatcher::publish(const Event& event) {
+    if (std::holds_alternative<BboEvent>(event))
     {
-        event_queue_.push(event);
+        if (batching_) pending_bbo_.push_back(event);
+        else bbo_queue_.push(event);
     }
-    else if (dynamic_cast<const BookSnapshotEvent*>(event.get()))
+    else if (const BookSnapshotEvent* snapshot = std::get_if<BookSnapshotEvent>(&event))
     {
-        market_data_channel_.update(event);
+        market_data_channel_.update(snapshot->getSymbolId(), event);
     }
     else
     {
-        std::cerr << "WARNING: Event " << event->getEventName() << " does not have a defined route.\n";
+        // Os demais tipos são transacionais: Auditor e, se houver, os execution reports
+        if (report_queue_)
+        {
+            if (batching_) pending_reports_.push_back(event);
+            else report_queue_->push(event);
+        }
+        if (batching_) pending_events_.push_back(event);
+        else event_queue_.push(event);
     }
 }
+
+void EventBusDispatcher::flushBatch()
+{
+    // O BBO sai primeiro, como na publicação evento a evento
+    bbo_queue_.push_batch(pending_bbo_);
+    event_queue_.push_batch(pending_events_);
+    if (report_queue_) report_queue_->push_batch(pending_reports_);
+    batching_ = false;
+}
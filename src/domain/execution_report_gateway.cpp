@@ -0,0 +1,385 @@
+#include "domain/execution_report_gateway.hpp"
+#include "messaging/events/cancel_rejected_event.hpp"
+#include "messaging/events/order_accepted_event.hpp"
+#include "messaging/events/order_amended_event.hpp"
+#include "messaging/events/order_canceled_event.hpp"
+#include "messaging/events/order_rejected_event.hpp"
+#include "messaging/events/orders_expired_event.hpp"
+#include "messaging/events/stop_triggered_event.hpp"
+#include "messaging/events/trade_executed_event.hpp"
+#include "utils/fix_message_writer.hpp"
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sys/socket.h>
+
+namespace
+{
+
+// OrdStatus (39) e ExecType (150) do FIX 4.2
+char fixOrdStatus(OrderStatus status)
+{
+    switch (status)
+    {
+        case OrderStatus::PartiallyFilled: return '1';
+        case OrderStatus::Filled: return '2';
+        case OrderStatus::Canceled: return '4';
+        case OrderStatus::Rejected: return '8';
+        case OrderStatus::PendingCancel: return '6';
+        case OrderStatus::PendingNew: return 'A';
+        case OrderStatus::Expired: return 'C';
+        default: return '0';
+    }
+}
+
+void addFill(std::vector<ExecutionReport>& out, const TradeExecutedEvent& trade, uint64_t client_id, uint64_t order_id, uint64_t client_order_id,
+             OrderSide side, uint32_t order_qty, uint32_t leaves_qty, OrderStatus status)
+{
+    ExecutionReport report;
+    report.client_id = client_id;
+    report.order_id = order_id;
+    report.client_order_id = client_order_id;
+    report.symbol = trade.getSymbol();
+    report.ord_status = fixOrdStatus(status);
+    report.exec_type = leaves_qty == 0 ? '2' : '1';
+    report.side = side;
+    report.order_qty = order_qty;
+    report.last_qty = trade.getQuantity();
+    report.last_px = trade.getPrice();
+    report.price = trade.getPrice();
+    report.leaves_qty = leaves_qty;
+    report.cum_qty = order_qty > leaves_qty ? order_qty - leaves_qty : 0;
+    out.push_back(report);
+}
+
+} // namespace
+
+ExecutionReportGateway::ExecutionReportGateway(ThreadSafeQueue<Event>& report_queue, const ExecutionReportOptions& options)
+    : report_queue_(report_queue), options_(options)
+{
+}
+
+bool ExecutionReportGateway::initialize()
+{
+    if (options_.drop_copy_path.empty()) return true;
+
+    std::filesystem::path dir_path = std::filesystem::path(options_.drop_copy_path).parent_path();
+    std::error_code error;
+    if (!dir_path.empty()) std::filesystem::create_directories(dir_path, error);
+
+    drop_copy_.open(options_.drop_copy_path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!drop_copy_.is_open())
+    {
+        std::cerr << "Failed to open drop copy file: " << options_.drop_copy_path << '\n';
+        return false;
+    }
+    drop_copy_buffer_ = std::make_unique<char[]>(kMaxReportBytes);
+    return true;
+}
+
+void ExecutionReportGateway::attachSession(uint64_t client_id, int fd)
+{
+    std::unique_ptr<Session> session = std::make_unique<Session>();
+    session->client_id = client_id;
+    session->fd = fd;
+    session->queue = std::make_unique<char[]>(options_.session_queue_bytes);
+
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    sessions_[client_id] = std::move(session);
+}
+
+void ExecutionReportGateway::detachSession(uint64_t client_id)
+{
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    sessions_.erase(client_id);
+}
+
+void ExecutionReportGateway::run()
+{
+    std::cout << "[ExecutionReportGateway] Thread started. Waiting for events..." << std::endl;
+
+    std::vector<Event> batch;
+    while (true)
+    {
+        // Sem nada parado nas sessões a thread dorme até o próximo evento; com bytes parados acorda para reenviar
+        std::chrono::steady_clock::time_point deadline =
+            has_pending_ ? std::chrono::steady_clock::now() + kRetryInterval : std::chrono::steady_clock::time_point::max();
+        if (report_queue_.drain_into(batch, kMaxBatch, deadline) == ThreadSafeQueue<Event>::PopResult::Shutdown)
+        {
+            break;
+        }
+
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        for (const Event& event : batch)
+        {
+            reports_.clear();
+            collectReports(event, reports_);
+            for (const ExecutionReport& report : reports_)
+            {
+                routeReport(report);
+            }
+        }
+        batch.clear();
+
+        // Um send por sessão por volta, com todos os reports que ela acumulou
+        has_pending_ = false;
+        for (std::pair<const uint64_t, std::unique_ptr<Session>>& entry : sessions_)
+        {
+            if (entry.second->head != entry.second->tail && flush(*entry.second)) has_pending_ = true;
+        }
+    }
+
+    if (drop_copy_.is_open()) drop_copy_.close();
+    std::cout << "ExecutionReportGateway has finished consuming." << std::endl;
+}
+
+void ExecutionReportGateway::collectReports(const Event& event, std::vector<ExecutionReport>& out)
+{
+    if (const OrderAcceptedEvent* accepted = std::get_if<OrderAcceptedEvent>(&event))
+    {
+        ExecutionReport report;
+        report.client_id = accepted->getClientId();
+        report.order_id = accepted->getOrderId();
+        report.client_order_id = accepted->getClientOrderId();
+        report.symbol = accepted->getSymbol();
+        report.exec_type = '0';
+        report.ord_status = '0';
+        report.side = accepted->getSide();
+        report.order_qty = accepted->getQuantity();
+        report.leaves_qty = accepted->getQuantity();
+        report.price = accepted->getPrice();
+        out.push_back(report);
+    }
+    else if (const TradeExecutedEvent* trade = std::get_if<TradeExecutedEvent>(&event))
+    {
+        addFill(out, *trade, trade->getAggressiveClientId(), trade->getAggressiveOrderId(), trade->getAggressiveClientOrderId(),
+                trade->getAggressiveSide(), trade->getAggressiveOrderQuantity(), trade->getAggressiveRemainingQuantity(), trade->getAggressiveOrderStatus());
+        addFill(out, *trade, trade->getPassiveClientId(), trade->getPassiveOrderId(), trade->getPassiveClientOrderId(),
+                trade->getPassiveSide(), trade->getPassiveOrderQuantity(), trade->getPassiveRemainingQuantity(), trade->getPassiveOrderStatus());
+    }
+    else if (const OrderCanceledEvent* canceled = std::get_if<OrderCanceledEvent>(&event))
+    {
+        ExecutionReport report;
+        report.client_id = canceled->getClientId();
+        report.order_id = canceled->getOrderId();
+        report.client_order_id = canceled->getClientOrderId();
+        report.orig_client_order_id = canceled->getOrigClientOrderId();
+        report.symbol = canceled->getSymbol();
+        report.exec_type = '4';
+        report.ord_status = '4';
+        report.side = canceled->getSide();
+        report.order_qty = canceled->getCanceledQuantity() + canceled->getFilledQuantity();
+        report.cum_qty = canceled->getFilledQuantity();
+        report.price = canceled->getPrice();
+        out.push_back(report);
+    }
+    else if (const OrderAmendedEvent* amended = std::get_if<OrderAmendedEvent>(&event))
+    {
+        ExecutionReport report;
+        report.client_id = amended->getClientId();
+        report.order_id = amended->getOrderId();
+        report.client_order_id = amended->getClientOrderId();
+        report.orig_client_order_id = amended->getOrigClientOrderId();
+        report.symbol = amended->getSymbol();
+        report.exec_type = '5';
+        report.side = amended->getSide();
+        report.order_qty = amended->getQuantity();
+        report.leaves_qty = amended->getRemainingQuantity();
+        report.cum_qty = amended->getQuantity() > amended->getRemainingQuantity() ? amended->getQuantity() - amended->getRemainingQuantity() : 0;
+        report.ord_status = report.cum_qty > 0 ? '1' : '0';
+        report.price = amended->getPrice();
+        out.push_back(report);
+    }
+    else if (const CancelRejectedEvent* rejected = std::get_if<CancelRejectedEvent>(&event))
+    {
+        ExecutionReport report;
+        report.msg_type = '9';
+        report.client_id = rejected->getClientId();
+        report.client_order_id = rejected->getClientOrderId();
+        report.orig_client_order_id = rejected->getOrigClientOrderId();
+        report.symbol = rejected->getSymbol();
+        report.ord_status = '8';
+        report.cxl_rej_response_to = static_cast<int>(rejected->getResponseTo());
+        report.text = rejected->getReason();
+        out.push_back(report);
+    }
+    else if (const OrderRejectedEvent* order_rejected = std::get_if<OrderRejectedEvent>(&event))
+    {
+        ExecutionReport report;
+        report.client_id = order_rejected->getClientId();
+        report.order_id = order_rejected->getOrderId();
+        report.client_order_id = order_rejected->getClientOrderId();
+        report.symbol = order_rejected->getSymbol();
+        report.exec_type = '8';
+        report.ord_status = '8';
+        report.side = order_rejected->getSide();
+        report.order_qty = order_rejected->getQuantity();
+        report.price = order_rejected->getPrice();
+        report.text = order_rejected->getReason();
+        out.push_back(report);
+    }
+    else if (const StopTriggeredEvent* triggered = std::get_if<StopTriggeredEvent>(&event))
+    {
+        // ExecType L (Triggered or Activated by System), emprestado do FIX 4.4
+        ExecutionReport report;
+        report.client_id = triggered->getClientId();
+        report.order_id = triggered->getOrderId();
+        report.client_order_id = triggered->getClientOrderId();
+        report.symbol = triggered->getSymbol();
+        report.exec_type = 'L';
+        report.ord_status = '0';
+        report.side = triggered->getSide();
+        report.order_qty = triggered->getQuantity();
+        report.leaves_qty = triggered->getQuantity();
+        report.price = triggered->getPrice();
+        out.push_back(report);
+    }
+    else if (const OrdersExpiredEvent* expired = std::get_if<OrdersExpiredEvent>(&event))
+    {
+        for (const ExpiredOrder& order : expired->getOrders())
+        {
+            ExecutionReport report;
+            report.client_id = order.client_id;
+            report.order_id = order.order_id;
+            report.client_order_id = order.client_order_id;
+            report.symbol = expired->getSymbol();
+            report.exec_type = 'C';
+            report.ord_status = 'C';
+            report.side = order.side;
+            report.order_qty = order.expired_quantity + order.filled_quantity;
+            report.cum_qty = order.filled_quantity;
+            report.price = order.price;
+            out.push_back(report);
+        }
+    }
+}
+
+void ExecutionReportGateway::routeReport(const ExecutionReport& report)
+{
+    std::unordered_map<uint64_t, std::unique_ptr<Session>>::iterator it = sessions_.find(report.client_id);
+    bool routed = it != sessions_.end() && !it->second->disconnected;
+    // A cópia da sessão e a do drop copy levam o mesmo ExecID
+    uint64_t exec_id = next_exec_id_++;
+    if (routed) enqueue(*it->second, report, exec_id);
+
+    if (drop_copy_.is_open())
+    {
+        std::string_view message = renderReport(report, exec_id, drop_copy_sequence_++, drop_copy_buffer_.get(), kMaxReportBytes);
+        drop_copy_.write(message.data(), static_cast<std::streamsize>(message.size()));
+        drop_copy_.put('\n');
+    }
+    else if (!routed)
+    {
+        unrouted_reports_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ExecutionReportGateway::enqueue(Session& session, const ExecutionReport& report, uint64_t exec_id)
+{
+    const size_t capacity = options_.session_queue_bytes;
+    if (capacity - session.tail < kMaxReportBytes && session.head > 0)
+    {
+        // Compacta: o que ainda não foi enviado volta para o início da fila
+        std::memmove(session.queue.get(), session.queue.get() + session.head, session.tail - session.head);
+        session.tail -= session.head;
+        session.head = 0;
+    }
+    if (capacity - session.tail < kMaxReportBytes)
+    {
+        slow_consumer_disconnects_.fetch_add(1, std::memory_order_relaxed);
+        disconnect(session, "send queue full");
+        return;
+    }
+
+    std::string_view message = renderReport(report, exec_id, session.next_sequence, session.queue.get() + session.tail, kMaxReportBytes);
+    if (message.empty()) return;
+
+    // O writer reserva espaço para o cabeçalho antes do corpo; a mensagem é deslocada para encostar no fim da fila
+    char* destination = session.queue.get() + session.tail;
+    if (message.data() != destination) std::memmove(destination, message.data(), message.size());
+    session.tail += message.size();
+    ++session.next_sequence;
+}
+
+std::string_view ExecutionReportGateway::renderReport(const ExecutionReport& report, uint64_t exec_id, uint64_t sequence, char* buffer, size_t capacity)
+{
+    FixMessageWriter writer(buffer, capacity);
+    writer.field<35>(report.msg_type);
+    writer.field<49>(options_.sender_comp_id);
+    writer.field<56>(report.client_id);
+    writer.field<34>(sequence);
+    if (report.order_id != 0) writer.field<37>(report.order_id);
+    else writer.field<37>("NONE");
+    writer.field<11>(report.client_order_id);
+    if (report.orig_client_order_id != 0) writer.field<41>(report.orig_client_order_id);
+    writer.field<39>(report.ord_status);
+
+    if (report.msg_type == '9')
+    {
+        writer.field<434>(static_cast<uint64_t>(report.cxl_rej_response_to));
+        if (report.text) writer.field<58>(report.text);
+    }
+    else
+    {
+        writer.field<17>(exec_id);
+        writer.field<150>(report.exec_type);
+        writer.field<55>(report.symbol);
+        writer.field<54>(static_cast<char>('0' + static_cast<int>(report.side)));
+        writer.field<38>(report.order_qty);
+        if (report.price > 0.0) writer.field<44>(report.price);
+        if (report.last_qty > 0)
+        {
+            writer.field<32>(report.last_qty);
+            writer.field<31>(report.last_px);
+        }
+        writer.field<151>(report.leaves_qty);
+        writer.field<14>(report.cum_qty);
+        if (report.text) writer.field<58>(report.text);
+    }
+
+    std::string_view message = writer.finish();
+    if (message.empty())
+    {
+        std::cerr << "ExecutionReportGateway: report for client " << report.client_id << " does not fit " << capacity << " bytes\n";
+    }
+    else
+    {
+        reports_rendered_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return message;
+}
+
+bool ExecutionReportGateway::flush(Session& session)
+{
+    if (session.disconnected) return false;
+
+    while (session.head < session.tail)
+    {
+        ssize_t sent = send(session.fd, session.queue.get() + session.head, session.tail - session.head, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (sent > 0)
+        {
+            session.head += static_cast<size_t>(sent);
+            bytes_sent_.fetch_add(static_cast<uint64_t>(sent), std::memory_order_relaxed);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+
+        disconnect(session, std::strerror(errno));
+        return false;
+    }
+    session.head = 0;
+    session.tail = 0;
+    return false;
+}
+
+void ExecutionReportGateway::disconnect(Session& session, const char* reason)
+{
+    // O acceptor vê o shutdown como hangup, fecha o socket e chama detachSession
+    std::cerr << "ExecutionReportGateway: disconnecting client " << session.client_id << ": " << reason << '\n';
+    shutdown(session.fd, SHUT_RDWR);
+    session.disconnected = true;
+    session.head = 0;
+    session.tail = 0;
+}
@@ -0,0 +1,428 @@
+#include "domain/fix_tcp_acceptor.hpp"
+#include "utils/thread_utils.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+
+constexpr int kMaxEvents = 64;
+
+bool isDelimiter(char c)
+{
+    return c == '|' || c == '\x01';
+}
+
+// Valor da tag no início de 'message' ou logo depois de um delimitador (ex: "34=" não casa com "134=")
+std::string_view findTag(std::string_view message, std::string_view tag)
+{
+    size_t pos = 0;
+    while ((pos = message.find(tag, pos)) != std::string_view::npos)
+    {
+        if (pos == 0 || isDelimiter(message[pos - 1]))
+        {
+            size_t value = pos + tag.size();
+            size_t end = message.find_first_of("|\x01", value);
+            return message.substr(value, end == std::string_view::npos ? std::string_view::npos : end - value);
+        }
+        pos += tag.size();
+    }
+    return {};
+}
+
+} // namespace
+
+FixTcpAcceptor::FixTcpAcceptor(InboundGateway& gateway, const FixAcceptorOptions& options)
+    : gateway_(gateway), options_(options)
+{
+}
+
+FixTcpAcceptor::~FixTcpAcceptor()
+{
+    stop();
+}
+
+bool FixTcpAcceptor::start()
+{
+    listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0)
+    {
+        std::cerr << "FIX acceptor: socket() failed: " << std::strerror(errno) << '\n';
+        return false;
+    }
+
+    int one = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(options_.port);
+    if (inet_pton(AF_INET, options_.bind_address.c_str(), &address.sin_addr) != 1)
+    {
+        std::cerr << "FIX acceptor: invalid bind address " << options_.bind_address << '\n';
+        stop();
+        return false;
+    }
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listen_fd_, SOMAXCONN) != 0)
+    {
+        std::cerr << "FIX acceptor: cannot listen on " << options_.bind_address << ':' << options_.port << ": " << std::strerror(errno) << '\n';
+        stop();
+        return false;
+    }
+
+    socklen_t length = sizeof(address);
+    getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address), &length);
+    port_ = ntohs(address.sin_port);
+
+    int thread_count = options_.io_threads < 1 ? 1 : options_.io_threads;
+    for (int i = 0; i < thread_count; ++i)
+    {
+        std::unique_ptr<IoThread> io = std::make_unique<IoThread>();
+        io->index = i;
+        io->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        io->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        io_threads_.push_back(std::move(io));
+
+        IoThread& created = *io_threads_.back();
+        if (created.epoll_fd < 0 || created.wake_fd < 0)
+        {
+            std::cerr << "FIX acceptor: cannot create epoll/eventfd: " << std::strerror(errno) << '\n';
+            stop();
+            return false;
+        }
+
+        // O ponteiro do evento identifica a origem: a própria IoThread é o eventfd de parada, nullptr é o socket de escuta
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.ptr = &created;
+        epoll_ctl(created.epoll_fd, EPOLL_CTL_ADD, created.wake_fd, &event);
+    }
+
+    epoll_event listen_event{};
+    listen_event.events = EPOLLIN | EPOLLET;
+    listen_event.data.ptr = nullptr;
+    if (epoll_ctl(io_threads_.front()->epoll_fd, EPOLL_CTL_ADD, listen_fd_, &listen_event) != 0)
+    {
+        std::cerr << "FIX acceptor: cannot watch listening socket: " << std::strerror(errno) << '\n';
+        stop();
+        return false;
+    }
+
+    next_client_id_ = options_.first_client_id;
+    running_.store(true);
+    for (std::unique_ptr<IoThread>& io : io_threads_)
+    {
+        IoThread* raw = io.get();
+        io->thread = std::thread([this, raw]() { ioLoop(*raw); });
+    }
+
+    std::cout << "FIX acceptor listening on " << options_.bind_address << ':' << port_ << " with " << thread_count << " I/O thread(s)\n";
+    return true;
+}
+
+void FixTcpAcceptor::stop()
+{
+    running_.store(false);
+    for (std::unique_ptr<IoThread>& io : io_threads_)
+    {
+        if (io->thread.joinable())
+        {
+            uint64_t wake = 1;
+            if (write(io->wake_fd, &wake, sizeof(wake)) < 0)
+            {
+                std::cerr << "FIX acceptor: failed to wake I/O thread " << io->index << '\n';
+            }
+            io->thread.join();
+        }
+    }
+
+    for (std::unique_ptr<IoThread>& io : io_threads_)
+    {
+        for (std::pair<const int, std::unique_ptr<Session>>& entry : io->sessions)
+        {
+            if (on_session_close_) on_session_close_(entry.second->client_id);
+            close(entry.first);
+        }
+        io->sessions.clear();
+        if (io->epoll_fd >= 0) close(io->epoll_fd);
+        if (io->wake_fd >= 0) close(io->wake_fd);
+    }
+    io_threads_.clear();
+
+    if (listen_fd_ >= 0)
+    {
+        close(listen_fd_);
+        listen_fd_ = -1;
+    }
+}
+
+void FixTcpAcceptor::ioLoop(IoThread& io)
+{
+    thread_utils::applyThreadRole("fix-io-" + std::to_string(io.index), options_.cpus);
+
+    epoll_event events[kMaxEvents];
+    while (running_.load(std::memory_order_relaxed))
+    {
+        int count = epoll_wait(io.epoll_fd, events, kMaxEvents, -1);
+        if (count < 0)
+        {
+            if (errno == EINTR) continue;
+            std::cerr << "FIX acceptor: epoll_wait failed: " << std::strerror(errno) << '\n';
+            break;
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            void* source = events[i].data.ptr;
+            if (source == nullptr)
+            {
+                acceptConnections();
+            }
+            else if (source == &io)
+            {
+                uint64_t value = 0;
+                while (read(io.wake_fd, &value, sizeof(value)) > 0) {}
+            }
+            else
+            {
+                // Edge-triggered: a sessão é lida até EAGAIN, senão o resto só seria notificado com mais dados chegando
+                Session& session = *static_cast<Session*>(source);
+                bool keep = readSession(session);
+                if (!keep || (events[i].events & (EPOLLHUP | EPOLLERR)))
+                {
+                    closeSession(io, session);
+                }
+            }
+        }
+    }
+}
+
+void FixTcpAcceptor::acceptConnections()
+{
+    while (true)
+    {
+        int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                std::cerr << "FIX acceptor: accept failed: " << std::strerror(errno) << '\n';
+            }
+            return;
+        }
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        // Sessões distribuídas em round-robin entre as threads de I/O
+        IoThread& io = *io_threads_[next_io_thread_++ % io_threads_.size()];
+        std::unique_ptr<Session> session = std::make_unique<Session>();
+        session->fd = fd;
+        session->client_id = next_client_id_++;
+        session->client_id_text = std::to_string(session->client_id);
+        session->buffer = std::make_unique<char[]>(options_.read_buffer_bytes);
+        Session* raw = session.get();
+        bool inserted = false;
+        {
+            std::lock_guard<std::mutex> lock(io.sessions_mutex);
+            inserted = io.sessions.emplace(fd, std::move(session)).second;
+        }
+        if (!inserted)
+        {
+            // Não deveria acontecer (o fechamento tira a sessão do mapa antes de soltar o fd); se acontecer, a
+            // sessão nova já foi destruída pelo emplace e o fd não tem dono
+            std::cerr << "FIX acceptor: fd " << fd << " already has a session, connection dropped\n";
+            close(fd);
+            continue;
+        }
+
+        // Avisada antes de a sessão ser lida, para o primeiro report já ter para onde ir
+        if (on_session_open_) on_session_open_(raw->client_id, fd);
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+        event.data.ptr = raw;
+        if (epoll_ctl(io.epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0)
+        {
+            std::cerr << "FIX acceptor: cannot watch session socket: " << std::strerror(errno) << '\n';
+            if (on_session_close_) on_session_close_(raw->client_id);
+            std::lock_guard<std::mutex> lock(io.sessions_mutex);
+            io.sessions.erase(fd);
+            close(fd);
+            continue;
+        }
+        sessions_accepted_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool FixTcpAcceptor::readSession(Session& session)
+{
+    const size_t capacity = options_.read_buffer_bytes;
+    while (true)
+    {
+        if (session.end == capacity)
+        {
+            // Buffer cheio: move a mensagem incompleta para o início; se ela já começa no início, não cabe no buffer
+            if (session.begin == 0)
+            {
+                std::cerr << "FIX acceptor: message from client " << session.client_id << " exceeds the read buffer, closing session\n";
+                framing_errors_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            std::memmove(session.buffer.get(), session.buffer.get() + session.begin, session.end - session.begin);
+            session.end -= session.begin;
+            session.begin = 0;
+        }
+
+        ssize_t received = recv(session.fd, session.buffer.get() + session.end, capacity - session.end, 0);
+        if (received > 0)
+        {
+            session.end += static_cast<size_t>(received);
+            processBuffer(session);
+            continue;
+        }
+        if (received == 0) return false; // cliente fechou a conexão
+        if (errno == EINTR) continue;
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+}
+
+void FixTcpAcceptor::processBuffer(Session& session)
+{
+    // O relógio é lido uma vez por leitura do socket: todas as mensagens do mesmo recv chegaram juntas
+    const std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+
+    while (session.begin < session.end)
+    {
+        size_t skipped = 0;
+        size_t length = frameMessage(std::string_view(session.buffer.get() + session.begin, session.end - session.begin), skipped);
+        if (skipped != 0)
+        {
+            framing_errors_.fetch_add(1, std::memory_order_relaxed);
+            session.begin += skipped;
+        }
+        if (length == 0) break;
+
+        std::string_view message(session.buffer.get() + session.begin, length);
+        session.begin += length;
+        messages_received_.fetch_add(1, std::memory_order_relaxed);
+
+        if (!validChecksum(message))
+        {
+            std::cerr << "FIX acceptor: bad checksum from client " << session.client_id << ", message dropped\n";
+            framing_errors_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (!checkSequence(session, message)) continue;
+
+        std::unique_ptr<Command> command = gateway_.parseAndCreateCommand(message, session.client_id_text, now);
+        if (command && gateway_.pushToQueue(std::move(command)))
+        {
+            commands_queued_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Tudo consumido: a próxima leitura volta a usar o buffer desde o início
+    if (session.begin == session.end)
+    {
+        session.begin = 0;
+        session.end = 0;
+    }
+}
+
+bool FixTcpAcceptor::checkSequence(Session& session, std::string_view message)
+{
+    std::string_view text = findTag(message, "34=");
+    uint64_t sequence = 0;
+    if (text.empty() || std::from_chars(text.data(), text.data() + text.size(), sequence).ec != std::errc())
+    {
+        std::cerr << "FIX acceptor: message without MsgSeqNum from client " << session.client_id << ", dropped\n";
+        return false;
+    }
+
+    if (sequence < session.expected_seq)
+    {
+        duplicates_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (sequence > session.expected_seq)
+    {
+        std::cerr << "FIX acceptor: sequence gap from client " << session.client_id << ": expected " << session.expected_seq << ", got " << sequence << '\n';
+        sequence_gaps_.fetch_add(1, std::memory_order_relaxed);
+    }
+    session.expected_seq = sequence + 1;
+    return true;
+}
+
+void FixTcpAcceptor::closeSession(IoThread& io, Session& session)
+{
+    int fd = session.fd;
+    if (on_session_close_) on_session_close_(session.client_id);
+
+    // A sessão sai do mapa antes do close: depois dele o accept4 pode devolver o mesmo número de fd, e a nova
+    // sessão precisa encontrar a chave livre. 'owned' mantém a sessão viva até o fd estar fechado.
+    std::unique_ptr<Session> owned;
+    std::lock_guard<std::mutex> lock(io.sessions_mutex);
+    std::unordered_map<int, std::unique_ptr<Session>>::iterator it = io.sessions.find(fd);
+    if (it != io.sessions.end())
+    {
+        owned = std::move(it->second);
+        io.sessions.erase(it);
+    }
+    epoll_ctl(io.epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+}
+
+size_t FixTcpAcceptor::frameMessage(std::string_view data, size_t& skipped)
+{
+    skipped = 0;
+    size_t start = data.find("8=");
+    if (start == std::string_view::npos)
+    {
+        // Sem início de mensagem: descarta tudo menos o último byte, que pode ser o '8' de um 8= ainda chegando
+        skipped = data.size() > 1 ? data.size() - 1 : 0;
+        return 0;
+    }
+    skipped = start;
+    data = data.substr(start);
+
+    // O trailer é o 10= precedido por delimitador; a mensagem termina no delimitador depois do checksum
+    size_t search = 0;
+    size_t trailer = 0;
+    while ((trailer = data.find("10=", search)) != std::string_view::npos)
+    {
+        if (trailer > 0 && isDelimiter(data[trailer - 1]))
+        {
+            size_t end = data.find_first_of("|\x01", trailer + 3);
+            return end == std::string_view::npos ? 0 : end + 1;
+        }
+        search = trailer + 1;
+    }
+    return 0;
+}
+
+bool FixTcpAcceptor::validChecksum(std::string_view message)
+{
+    // frameMessage garante que a mensagem termina em <delimitador>10=NNN<delimitador>
+    size_t trailer = message.rfind("10=");
+    unsigned int expected = 0;
+    std::string_view text = message.substr(trailer + 3, message.size() - trailer - 4);
+    if (std::from_chars(text.data(), text.data() + text.size(), expected).ec != std::errc()) return false;
+
+    unsigned int sum = 0;
+    for (size_t i = 0; i < trailer; ++i)
+    {
+        sum += static_cast<unsigned char>(message[i]);
+    }
+    return sum % 256 == expected;
+}
@@ -1,10 +1,16 @@
 #include "domain/inbound_gateway.hpp"
 #include "messaging/commands/new_order_command.hpp"
+#include "messaging/commands/cancel_order_command.hpp"
+#include "messaging/commands/amend_order_command.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <map>
 #include <filesystem> 
+#include <iomanip>
+#include <ctime>
+#include <cstdio>
+#include <algorithm>
 
 
 InboundGateway::InboundGateway(ThreadSafeQueue<std::unique_ptr<Command>>& queue, const std::string& wal_file_path)
@@ -45,8 +51,9 @@ InboundGateway::InboundGateway(ThreadSafeQueue<std::unique_ptr<Command>>& queue,
     }
 }
 
-void InboundGateway::writeAheadLog(const std::string& log_message) 
+void InboundGateway::writeAheadLog(std::string_view log_message) 
 {   
+    std::lock_guard<std::mutex> lock(wal_mutex_);
     if (wal_file_.is_open()) 
     {
         wal_file_ << log_message << '\n';
@@ -71,27 +78,29 @@ bool InboundGateway::pushToQueue(std::unique_ptr<Command> commandPtr)
     }
 }
 
-std::unique_ptr<Command> InboundGateway::parseAndCreateCommand(const std::string& line, const std::string& clientId, const std::chrono::system_clock::time_point& timestamp) 
+std::unique_ptr<Command> InboundGateway::parseAndCreateCommand(std::string_view line, const std::string& clientId, const std::chrono::system_clock::time_point& timestamp) 
 {
     if (line.empty()) return nullptr;
 
     writeAheadLog(line);
 
-    std::stringstream oss(line);
-    std::string tag;
-
     std::map<std::string, std::string> fix_fields;
     fix_fields["1"] = clientId; 
 
-    while (std::getline(oss, tag, '|')) 
+    // Percorre os pares tag=valor direto na mensagem; só chave e valor são copiados para o mapa
+    std::size_t begin = 0;
+    while (begin < line.size()) 
     {
+        std::size_t end = line.find_first_of("|\x01", begin);
+        if (end == std::string_view::npos) end = line.size();
+
+        std::string_view tag = line.substr(begin, end - begin);
         std::size_t pos = tag.find('=');
-        if (pos != std::string::npos) 
+        if (pos != std::string_view::npos) 
         {
-            std::string key = tag.substr(0, pos);
-            std::string value = tag.substr(pos + 1);
-            fix_fields[key] = value;
+            fix_fields[std::string(tag.substr(0, pos))] = std::string(tag.substr(pos + 1));
         }
+        begin = end + 1;
     }
 
     if(fix_fields.size() < 2) 
@@ -104,6 +113,170 @@ std::unique_ptr<Command> InboundGateway::parseAndCreateCommand(const std::string
 }
 
 std::unique_ptr<Command> InboundGateway::createCommandFromFields(const std::map<std::string, std::string>& fields, const std::chrono::system_clock::time_point& timestamp) 
+{
+    // Tag 35 (MsgType): D = New Order Single, F = Order Cancel Request, G = Order Cancel/Replace Request
+    std::map<std::string, std::string>::const_iterator msg_type = fields.find("35");
+    if (msg_type == fields.end() || msg_type->second == "D") 
+    {
+        return createNewOrderCommand(fields, timestamp);
+    }
+    if (msg_type->second == "F") 
+    {
+        return createCancelOrderCommand(fields, timestamp);
+    }
+    if (msg_type->second == "G") 
+    {
+        return createAmendOrderCommand(fields, timestamp);
+    }
+
+    std::cerr << "Unsupported FIX MsgType: " << msg_type->second << "\n";
+    return nullptr;
+}
+
+std::unique_ptr<Command> InboundGateway::createCommandFromBinary(const ShmOrderMessage& message, uint64_t client_id, const std::chrono::system_clock::time_point& timestamp) 
+{
+    // O símbolo ocupa os 8 bytes inteiros ou termina no primeiro '\0'
+    size_t symbol_length = 0;
+    while (symbol_length < sizeof(message.symbol) && message.symbol[symbol_length] != '\0') ++symbol_length;
+    const std::string symbol(message.symbol, symbol_length);
+    const OrderSide side = static_cast<OrderSide>(message.side);
+
+    // O WAL guarda uma linha por mensagem também neste transporte, no mesmo formato tag=valor
+    char wal_line[256];
+    int wal_length = std::snprintf(wal_line, sizeof(wal_line), "SHM|1=%llu|34=%u|35=%c|11=%llu|41=%llu|55=%s|54=%u|38=%u|44=%.4f|99=%.4f|40=%u|59=%u|47=%c|",
+                                   static_cast<unsigned long long>(client_id), message.sequence, static_cast<char>(message.type),
+                                   static_cast<unsigned long long>(message.client_order_id), static_cast<unsigned long long>(message.orig_client_order_id),
+                                   symbol.c_str(), message.side, message.quantity, message.price, message.stop_price, message.order_type,
+                                   message.time_in_force, message.capacity ? message.capacity : '-');
+    writeAheadLog(std::string_view(wal_line, wal_length > 0 ? std::min<size_t>(static_cast<size_t>(wal_length), sizeof(wal_line) - 1) : 0));
+
+    std::unique_ptr<Command> command;
+    if (message.type == ShmOrderMessage::NewOrder) 
+    {
+        const OrderType type = static_cast<OrderType>(message.order_type);
+        const OrderTimeInForce tif = static_cast<OrderTimeInForce>(message.time_in_force);
+        // TrailingStop e GoodTillDate precisam de campos que a mensagem binária não carrega (211 e 126)
+        if (message.order_type < static_cast<uint8_t>(OrderType::Market) || message.order_type > static_cast<uint8_t>(OrderType::StopLimit) ||
+            message.time_in_force < static_cast<uint8_t>(OrderTimeInForce::Day) || message.time_in_force > static_cast<uint8_t>(OrderTimeInForce::FillOrKill) ||
+            (message.capacity != static_cast<char>(OrderCapacity::Agency) && message.capacity != static_cast<char>(OrderCapacity::Principal))) 
+        {
+            std::cerr << "Unsupported binary order " << message.client_order_id << " from client " << client_id << ": type/TIF/capacity\n";
+            publishReject(OrderRejectedEvent(0, client_id, message.client_order_id, SymbolTable::intern(symbol), side, message.quantity, message.price,
+                                             "Unsupported order type, time in force or capacity", timestamp));
+            return nullptr;
+        }
+        if (pre_trade_risk_ && !passesOrderRisk(pre_trade_risk_->checkNewOrder(client_id, symbol, side, type, message.quantity, message.price, message.stop_price, timestamp),
+                                                client_id, message.client_order_id, symbol, side, message.quantity, message.price, timestamp)) 
+        {
+            return nullptr;
+        }
+
+        std::unique_ptr<NewOrderCommand> new_order = std::make_unique<NewOrderCommand>(
+            message.client_order_id, client_id, symbol, side, type, message.quantity, message.price, tif,
+            static_cast<OrderCapacity>(message.capacity), timestamp
+        );
+        new_order->setStopParameters(message.stop_price, 0.0);
+        command = std::move(new_order);
+    } 
+    else if (message.type == ShmOrderMessage::Cancel) 
+    {
+        if (pre_trade_risk_ && !passesCancelRisk(pre_trade_risk_->checkCancel(client_id, symbol, side, timestamp), CancelRejectedEvent::ResponseTo::Cancel,
+                                                 client_id, message.client_order_id, message.orig_client_order_id, symbol, timestamp)) 
+        {
+            return nullptr;
+        }
+        command = std::make_unique<CancelOrderCommand>(client_id, message.client_order_id, message.orig_client_order_id, symbol, side, timestamp);
+    } 
+    else if (message.type == ShmOrderMessage::Amend) 
+    {
+        if (pre_trade_risk_ && !passesCancelRisk(pre_trade_risk_->checkAmend(client_id, symbol, side, message.quantity, message.price, timestamp), CancelRejectedEvent::ResponseTo::Amend,
+                                                 client_id, message.client_order_id, message.orig_client_order_id, symbol, timestamp)) 
+        {
+            return nullptr;
+        }
+        command = std::make_unique<AmendOrderCommand>(client_id, message.client_order_id, message.orig_client_order_id, symbol, side,
+                                                      message.quantity, message.price, timestamp);
+    } 
+    else 
+    {
+        std::cerr << "Unsupported binary MsgType " << static_cast<int>(message.type) << " from client " << client_id << "\n";
+        return nullptr;
+    }
+
+    if (message.send_timestamp_ns != 0) 
+    {
+        command->setIntendedTimestamp(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(message.send_timestamp_ns)));
+    }
+    return command;
+}
+
+std::unique_ptr<Command> InboundGateway::createCancelOrderCommand(const std::map<std::string, std::string>& fields, const std::chrono::system_clock::time_point& timestamp) 
+{
+    uint64_t client_id = 0;
+    uint64_t client_order_id = 0;
+    uint64_t orig_client_order_id = 0;
+    std::string symbol;
+    OrderSide side;
+
+    try 
+    {
+        client_id = std::stoull(fields.at("1"));
+        client_order_id = std::stoull(fields.at("11"));
+        orig_client_order_id = std::stoull(fields.at("41"));
+        symbol = fields.at("55");
+        side = static_cast<OrderSide>(std::stoi(fields.at("54")));
+    } 
+    catch (const std::exception& e) 
+    {
+        std::cerr << "Erro ao converter campos do FIX (cancel): " << e.what() << "\n";
+        return nullptr;
+    }
+
+    if (pre_trade_risk_ && !passesCancelRisk(pre_trade_risk_->checkCancel(client_id, symbol, side, timestamp), CancelRejectedEvent::ResponseTo::Cancel,
+                                             client_id, client_order_id, orig_client_order_id, symbol, timestamp)) 
+    {
+        return nullptr;
+    }
+
+    return std::make_unique<CancelOrderCommand>(client_id, client_order_id, orig_client_order_id, symbol, side, timestamp);
+}
+
+std::unique_ptr<Command> InboundGateway::createAmendOrderCommand(const std::map<std::string, std::string>& fields, const std::chrono::system_clock::time_point& timestamp) 
+{
+    uint64_t client_id = 0;
+    uint64_t client_order_id = 0;
+    uint64_t orig_client_order_id = 0;
+    std::string symbol;
+    OrderSide side;
+    uint32_t new_quantity = 0;
+    double new_price = 0.0;
+
+    try 
+    {
+        client_id = std::stoull(fields.at("1"));
+        client_order_id = std::stoull(fields.at("11"));
+        orig_client_order_id = std::stoull(fields.at("41"));
+        symbol = fields.at("55");
+        side = static_cast<OrderSide>(std::stoi(fields.at("54")));
+        new_quantity = static_cast<uint32_t>(std::stoul(fields.at("38")));
+        new_price = std::stod(fields.at("44"));
+    } 
+    catch (const std::exception& e) 
+    {
+        std::cerr << "Erro ao converter campos do FIX (amend): " << e.what() << "\n";
+        return nullptr;
+    }
+
+    if (pre_trade_risk_ && !passesCancelRisk(pre_trade_risk_->checkAmend(client_id, symbol, side, new_quantity, new_price, timestamp), CancelRejectedEvent::ResponseTo::Amend,
+                                             client_id, client_order_id, orig_client_order_id, symbol, timestamp)) 
+    {
+        return nullptr;
+    }
+
+    return std::make_unique<AmendOrderCommand>(client_id, client_order_id, orig_client_order_id, symbol, side, new_quantity, new_price, timestamp);
+}
+
+std::unique_ptr<Command> InboundGateway::createNewOrderCommand(const std::map<std::string, std::string>& fields, const std::chrono::system_clock::time_point& timestamp) 
 {
     uint64_t client_order_id = 0;
     uint64_t client_id = 0;
@@ -112,6 +285,9 @@ std::unique_ptr<Command> InboundGateway::createCommandFromFields(const std::map<
     OrderType type;
     uint32_t quantity = 0;
     double price = 0.0;
+    double stop_price = 0.0;
+    double trailing_offset = 0.0;
+    std::chrono::system_clock::time_point expire_time{};
     std::string ordType;
     std::string timeInForce;
     std::string orderCapacity;
@@ -124,10 +300,23 @@ std::unique_ptr<Command> InboundGateway::createCommandFromFields(const std::map<
         side = static_cast<OrderSide>(std::stoi(fields.at("54")));
         type = static_cast<OrderType>(std::stoi(fields.at("40")));
         quantity = std::stoul(fields.at("38"));
-        price = std::stod(fields.at("44"));
+        // Ordens que executam a mercado (40=1, 40=3 e trailing stop 40=5) não têm preço limite, então a tag 44 é opcional nelas
+        bool has_limit_price = type == OrderType::Limit || type == OrderType::StopLimit;
+        std::map<std::string, std::string>::const_iterator price_field = fields.find("44");
+        if (has_limit_price || price_field != fields.end()) price = std::stod(fields.at("44"));
+        // StopPx (99) é obrigatório para stop e stop-limit; o trailing stop exige a distância (211) e aceita 99 como stop inicial
+        if (type == OrderType::Stop || type == OrderType::StopLimit) stop_price = std::stod(fields.at("99"));
+        if (type == OrderType::TrailingStop) 
+        {
+            trailing_offset = std::stod(fields.at("211"));
+            std::map<std::string, std::string>::const_iterator stop_field = fields.find("99");
+            if (stop_field != fields.end()) stop_price = std::stod(stop_field->second);
+        }
         ordType = fields.at("40");          
         timeInForce = fields.at("59");     
         orderCapacity = fields.at("47");   
+        // GoodTillDate (59=6) exige o prazo em ExpireTime (126)
+        if (static_cast<OrderTimeInForce>(std::stoi(timeInForce)) == OrderTimeInForce::GoodTillDate) expire_time = parseUtcTimestamp(fields.at("126"));
     } 
     catch (const std::exception& e) 
     {
@@ -135,9 +324,77 @@ std::unique_ptr<Command> InboundGateway::createCommandFromFields(const std::map<
         return nullptr;
     }
 
-    return std::make_unique<NewOrderCommand>(
+    // Ordens que não passam no risco nem chegam a virar comando: não ocupam a fila nem ciclos da engine
+    if (pre_trade_risk_ && !passesOrderRisk(pre_trade_risk_->checkNewOrder(client_id, symbol, side, type, quantity, price, stop_price, timestamp),
+                                            client_id, client_order_id, symbol, side, quantity, price, timestamp)) 
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<NewOrderCommand> command = std::make_unique<NewOrderCommand>(
         client_order_id, client_id, symbol, side, type, quantity, price, 
         static_cast<OrderTimeInForce>(std::stoi(timeInForce)), static_cast<OrderCapacity>(orderCapacity[0]),
         timestamp 
     );
-}
\ No newline at end of file
+    command->setStopParameters(stop_price, trailing_offset);
+    command->setExpireTime(expire_time);
+    return command;
+}
+
+bool InboundGateway::passesRisk(RiskRejectReason reason, const char* message, uint64_t client_id, uint64_t client_order_id) const
+{
+    if (reason == RiskRejectReason::None) return true;
+
+    std::cerr << "Pre-trade risk rejected " << message << " " << client_order_id << " from client " << client_id << ": " << PreTradeRisk::reasonName(reason) << "\n";
+    return false;
+}
+
+bool InboundGateway::passesOrderRisk(RiskRejectReason reason, uint64_t client_id, uint64_t client_order_id, const std::string& symbol, OrderSide side,
+                                     uint32_t quantity, double price, const std::chrono::system_clock::time_point& timestamp)
+{
+    if (passesRisk(reason, "order", client_id, client_order_id)) return true;
+
+    // A ordem nunca chegou à engine: sem OrderID (37=NONE no report)
+    publishReject(OrderRejectedEvent(0, client_id, client_order_id, SymbolTable::intern(symbol), side, quantity, price,
+                                     PreTradeRisk::reasonName(reason), timestamp));
+    return false;
+}
+
+bool InboundGateway::passesCancelRisk(RiskRejectReason reason, CancelRejectedEvent::ResponseTo response_to, uint64_t client_id, uint64_t client_order_id,
+                                      uint64_t orig_client_order_id, const std::string& symbol, const std::chrono::system_clock::time_point& timestamp)
+{
+    if (passesRisk(reason, response_to == CancelRejectedEvent::ResponseTo::Cancel ? "cancel" : "amend", client_id, client_order_id)) return true;
+
+    publishReject(CancelRejectedEvent(client_id, client_order_id, orig_client_order_id, SymbolTable::intern(symbol), response_to,
+                                      PreTradeRisk::reasonName(reason), timestamp));
+    return false;
+}
+
+void InboundGateway::publishReject(const Event& event)
+{
+    if (reject_event_queue_) reject_event_queue_->push(event);
+    if (reject_report_queue_) reject_report_queue_->push(event);
+}
+
+std::chrono::system_clock::time_point InboundGateway::parseUtcTimestamp(const std::string& value)
+{
+    std::tm tm{};
+    std::istringstream stream(value);
+    stream >> std::get_time(&tm, "%Y%m%d-%H:%M:%S");
+    if (stream.fail()) 
+    {
+        throw std::invalid_argument("invalid UTCTimestamp: " + value);
+    }
+
+    std::chrono::system_clock::time_point time_point = std::chrono::system_clock::from_time_t(timegm(&tm));
+
+    // Milissegundos opcionais depois do ponto
+    if (stream.peek() == '.') 
+    {
+        stream.get();
+        int milliseconds = 0;
+        stream >> milliseconds;
+        time_point += std::chrono::milliseconds(milliseconds);
+    }
+    return time_point;
+}
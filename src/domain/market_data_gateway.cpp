@@ -7,7 +7,6 @@
 #include <filesystem>
 #include <chrono>
 #include <iomanip>
-#include <typeinfo>
 #include <fstream>
 
 MarketDataGateway::MarketDataGateway(MarketDataChannel& channel, const std::string& output_file_path) 
@@ -56,20 +55,37 @@ void MarketDataGateway::run() {
 
     std::cout << "[MarketDataGateway] Thread started. Waiting for market data..." << std::endl;
 
+    std::vector<Event> updates;
     while (true) {
-        std::shared_ptr<const Event> event = channel_.wait_for_update();
-        
-        if (!event) {
+        // Com o feed multicast a espera acorda também na hora do próximo ciclo de snapshot
+        std::chrono::steady_clock::time_point deadline = publisher_ ? publisher_->nextSnapshotTime() : std::chrono::steady_clock::time_point::max();
+        if (!channel_.wait_for_updates(updates, deadline)) {
             break;
         }
-        
-        std::string json_output = formatSnapshotToJSON(*event);
-        
-        if (output_file_.is_open()) {
-            output_file_ << json_output << "\n";
-        } else {
-            std::cerr << "[MarketDataGateway] Cannot write market data: output file is not open" << std::endl;
+
+        // O feed sai primeiro: a linha JSON é bem mais cara e não deve atrasar os assinantes
+        if (publisher_) {
+            for (const Event& event : updates) {
+                if (const BookSnapshotEvent* snapshot = std::get_if<BookSnapshotEvent>(&event)) {
+                    publisher_->publish(*snapshot);
+                }
+            }
+            publisher_->flush();
+            if (std::chrono::steady_clock::now() >= publisher_->nextSnapshotTime()) {
+                publisher_->publishSnapshots();
+            }
+        }
+
+        for (const Event& event : updates) {
+            std::string json_output = formatSnapshotToJSON(event);
+
+            if (output_file_.is_open()) {
+                output_file_ << json_output << "\n";
+            } else {
+                std::cerr << "[MarketDataGateway] Cannot write market data: output file is not open" << std::endl;
+            }
         }
+        updates.clear();
     }
 
     if (output_file_.is_open()) {
@@ -81,7 +97,7 @@ void MarketDataGateway::run() {
 
 std::string MarketDataGateway::formatSnapshotToJSON(const Event& event) {
 
-    const auto* snapshot = dynamic_cast<const BookSnapshotEvent*>(&event);
+    const auto* snapshot = std::get_if<BookSnapshotEvent>(&event);
     if (!snapshot) {
         return "{ \"error\": \"Unknown market data event type\" }";
     }
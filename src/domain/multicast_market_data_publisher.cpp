@@ -0,0 +1,223 @@
+#include "domain/multicast_market_data_publisher.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace market_data_feed;
+
+namespace
+{
+
+int64_t wallClockNanos()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+const BookSnapshotEvent::PriceLevel* findLevel(const BookSnapshotEvent::Levels& levels, double price)
+{
+    for (const BookSnapshotEvent::PriceLevel& level : levels)
+    {
+        if (level.price == price) return &level;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+MulticastMarketDataPublisher::MulticastMarketDataPublisher(const MulticastFeedOptions& options)
+    : options_(options)
+{
+}
+
+MulticastMarketDataPublisher::~MulticastMarketDataPublisher()
+{
+    close();
+}
+
+bool MulticastMarketDataPublisher::open()
+{
+    incremental_fd_ = openSocket(options_, options_.group, options_.port);
+    snapshot_fd_ = openSocket(options_, options_.snapshot_group, options_.snapshot_port);
+    if (incremental_fd_ < 0 || snapshot_fd_ < 0)
+    {
+        close();
+        return false;
+    }
+
+    next_snapshot_time_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(options_.snapshot_interval_ms);
+    std::cout << "Multicast market data: incremental " << options_.group << ':' << options_.port << ", snapshot "
+              << options_.snapshot_group << ':' << options_.snapshot_port << " every " << options_.snapshot_interval_ms
+              << " ms via " << options_.interface_address << '\n';
+    return true;
+}
+
+void MulticastMarketDataPublisher::close()
+{
+    if (incremental_fd_ >= 0) ::close(incremental_fd_);
+    if (snapshot_fd_ >= 0) ::close(snapshot_fd_);
+    incremental_fd_ = -1;
+    snapshot_fd_ = -1;
+}
+
+int MulticastMarketDataPublisher::openSocket(const MulticastFeedOptions& options, const std::string& group, uint16_t port)
+{
+    sockaddr_in destination{};
+    destination.sin_family = AF_INET;
+    destination.sin_port = htons(port);
+    in_addr interface_address{};
+    if (inet_pton(AF_INET, group.c_str(), &destination.sin_addr) != 1 || inet_pton(AF_INET, options.interface_address.c_str(), &interface_address) != 1)
+    {
+        std::cerr << "Multicast market data: invalid address " << group << " / " << options.interface_address << '\n';
+        return -1;
+    }
+
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        std::cerr << "Multicast market data: socket failed: " << std::strerror(errno) << '\n';
+        return -1;
+    }
+
+    // O loop deixa assinantes no mesmo host (inclusive no loopback) receberem o feed
+    unsigned char ttl = static_cast<unsigned char>(options.ttl);
+    unsigned char loop = 1;
+    if (setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &interface_address, sizeof(interface_address)) != 0 ||
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) != 0 ||
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) != 0 ||
+        connect(fd, reinterpret_cast<sockaddr*>(&destination), sizeof(destination)) != 0)
+    {
+        std::cerr << "Multicast market data: cannot send to " << group << ':' << port << ": " << std::strerror(errno) << '\n';
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void MulticastMarketDataPublisher::publish(const BookSnapshotEvent& snapshot)
+{
+    if (!isOpen()) return;
+
+    PublishedBook& book = books_[snapshot.getSymbol()];
+    diffSide(snapshot.getSymbol(), OrderSide::Buy, book.bids, snapshot.getBids());
+    diffSide(snapshot.getSymbol(), OrderSide::Sell, book.asks, snapshot.getAsks());
+    book.bids = snapshot.getBids();
+    book.asks = snapshot.getAsks();
+}
+
+void MulticastMarketDataPublisher::diffSide(const std::string& symbol, OrderSide side, const Levels& previous, const Levels& current)
+{
+    // Poucos níveis por lado: a busca linear sai mais barata que qualquer índice
+    for (const BookSnapshotEvent::PriceLevel& level : previous)
+    {
+        if (!findLevel(current, level.price)) appendUpdate(symbol, side, level.price, 0);
+    }
+    for (const BookSnapshotEvent::PriceLevel& level : current)
+    {
+        const BookSnapshotEvent::PriceLevel* old_level = findLevel(previous, level.price);
+        if (!old_level || old_level->quantity != level.quantity) appendUpdate(symbol, side, level.price, level.quantity);
+    }
+}
+
+void MulticastMarketDataPublisher::appendUpdate(const std::string& symbol, OrderSide side, double price, uint64_t quantity)
+{
+    if (packet_updates_ == kUpdatesPerPacket) flush();
+
+    FeedLevelUpdate update{};
+    std::memcpy(update.symbol, symbol.data(), std::min(symbol.size(), kSymbolBytes));
+    update.side = static_cast<uint8_t>(side);
+    update.price = price;
+    update.quantity = quantity;
+    std::memcpy(packet_ + sizeof(FeedPacketHeader) + packet_updates_ * sizeof(FeedLevelUpdate), &update, sizeof(update));
+    ++packet_updates_;
+    ++sequence_;
+}
+
+void MulticastMarketDataPublisher::flush()
+{
+    if (packet_updates_ == 0) return;
+
+    // A sequência do pacote é a do primeiro registro; as seguintes são implícitas pela posição
+    FeedPacketHeader header{};
+    header.magic = kMagic;
+    header.kind = Incremental;
+    header.count = static_cast<uint16_t>(packet_updates_);
+    header.sequence = sequence_ - packet_updates_ + 1;
+    header.send_time_ns = wallClockNanos();
+    std::memcpy(packet_, &header, sizeof(header));
+
+    if (sendPacket(incremental_fd_, packet_, sizeof(header) + packet_updates_ * sizeof(FeedLevelUpdate)))
+    {
+        ++packets_sent_;
+        updates_published_ += packet_updates_;
+    }
+    packet_updates_ = 0;
+}
+
+void MulticastMarketDataPublisher::publishSnapshots()
+{
+    next_snapshot_time_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(options_.snapshot_interval_ms);
+    if (!isOpen()) return;
+
+    // O snapshot reflete tudo o que já foi numerado, então o incremental pendente sai antes
+    flush();
+
+    alignas(8) char packet[kMaxDatagramBytes];
+    FeedPacketHeader header{};
+    header.magic = kMagic;
+    header.kind = Snapshot;
+    header.flags = SnapshotBegin;
+    header.sequence = sequence_;
+
+    size_t records = 0;
+    size_t remaining = books_.size();
+    std::unordered_map<std::string, PublishedBook>::const_iterator it = books_.begin();
+    // Um ciclo sem livros ainda manda um pacote vazio, para um assinante novo saber a sequência inicial
+    do
+    {
+        if (it != books_.end())
+        {
+            FeedBookSnapshot record{};
+            std::memcpy(record.symbol, it->first.data(), std::min(it->first.size(), kSymbolBytes));
+            record.index = static_cast<uint16_t>(books_.size() - remaining);
+            record.total = static_cast<uint16_t>(books_.size());
+            record.bid_count = static_cast<uint8_t>(std::min(it->second.bids.size(), kMaxSnapshotDepth));
+            record.ask_count = static_cast<uint8_t>(std::min(it->second.asks.size(), kMaxSnapshotDepth));
+            for (size_t i = 0; i < record.bid_count; ++i) record.bids[i] = {it->second.bids[i].price, it->second.bids[i].quantity};
+            for (size_t i = 0; i < record.ask_count; ++i) record.asks[i] = {it->second.asks[i].price, it->second.asks[i].quantity};
+            std::memcpy(packet + sizeof(header) + records * sizeof(record), &record, sizeof(record));
+            ++records;
+            --remaining;
+            ++it;
+        }
+
+        if (records == kSnapshotsPerPacket || remaining == 0)
+        {
+            if (remaining == 0) header.flags |= SnapshotEnd;
+            header.count = static_cast<uint16_t>(records);
+            header.send_time_ns = wallClockNanos();
+            std::memcpy(packet, &header, sizeof(header));
+            if (sendPacket(snapshot_fd_, packet, sizeof(header) + records * sizeof(FeedBookSnapshot))) ++snapshot_packets_sent_;
+            header.flags = 0;
+            records = 0;
+        }
+    } while (remaining > 0);
+}
+
+bool MulticastMarketDataPublisher::sendPacket(int fd, const char* data, size_t length)
+{
+    // UDP não tem retransmissão: um envio recusado vira um salto de sequência que o assinante recupera pelo snapshot
+    if (send(fd, data, length, 0) != static_cast<ssize_t>(length))
+    {
+        if (send_errors_++ == 0)
+        {
+            std::cerr << "Multicast market data: send failed: " << std::strerror(errno) << '\n';
+        }
+        return false;
+    }
+    return true;
+}
@@ -4,7 +4,13 @@
 #include <string>
 #include <iostream>
 
-uint64_t Order::next_order_id_ = 1; // Initialize static member
+IdBlockAllocator Order::id_allocator_;
+
+uint64_t Order::getNextOrderId()
+{
+    thread_local IdGenerator generator(id_allocator_, IdGenerator::threadShard());
+    return generator.next();
+}
 
 Order::Order(uint64_t order_id, uint64_t client_id, uint64_t client_order_id,
              const std::string& symbol, double price, uint32_t quantity, 
@@ -39,3 +45,50 @@ bool Order::applyFill(uint32_t filled_quantity, double filled_price)
     status_ = (remaining_quantity_ == 0) ? OrderStatus::Filled : OrderStatus::PartiallyFilled;
     return true;
 }
+
+bool Order::cancel()
+{
+    if (status_ == OrderStatus::Filled || status_ == OrderStatus::Canceled)
+    {
+        return false;
+    }
+
+    status_ = OrderStatus::Canceled;
+    return true;
+}
+
+bool Order::expire()
+{
+    if (status_ == OrderStatus::Filled || status_ == OrderStatus::Canceled || status_ == OrderStatus::Expired)
+    {
+        return false;
+    }
+
+    status_ = OrderStatus::Expired;
+    return true;
+}
+
+bool Order::trigger()
+{
+    if (!isStopOrder())
+    {
+        return false;
+    }
+
+    type_ = type_ == OrderType::StopLimit ? OrderType::Limit : OrderType::Market;
+    return true;
+}
+
+bool Order::amend(uint64_t new_client_order_id, uint32_t new_quantity, double new_price)
+{
+    if (new_quantity <= filled_quantity_)
+    {
+        return false;
+    }
+
+    client_order_id_ = new_client_order_id;
+    quantity_ = new_quantity;
+    remaining_quantity_ = new_quantity - filled_quantity_;
+    price_ = new_price;
+    return true;
+}
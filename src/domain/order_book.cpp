@@ -3,234 +3,707 @@
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
+#include <cmath>
 
-OrderBook::OrderBook(const std::string& symbol) 
-    : symbol_(symbol) 
+namespace
 {
+
+// Os dois lados imprimem igual; só o tipo da árvore (e a ordem dos preços) muda
+template<typename Levels>
+void printTopLevel(const Levels& levels, const char* label)
+{
+    if (levels.empty() || levels.begin()->second.orders.empty()) 
+    {
+        return;
+    }
+
+    const std::shared_ptr<Order>& order = levels.begin()->second.orders.front();
+    std::cout << label << ": \nPrice: " << order->getPrice() 
+              << ", Quantity: " << order->getRemainingQuantity() 
+              << "\n";
 }
 
-bool OrderBook::addOrder(std::shared_ptr<Order> order)
+template<typename Levels>
+void printLevels(const Levels& levels, const char* title)
 {
-    double price = order->getPrice();
-    OrderSide side = order->getSide();
+    if (!levels.empty())
+        std::cout << "\n" << title << ":\n";
+
+    constexpr int price_width = 6;
+    constexpr int qty_width = 5;
+    constexpr size_t bar_max = 130;
 
-    if (side == OrderSide::Buy) 
+    for (const auto& [price, level] : levels)
     {
-        bids_[price].push_back(order);
-        order_id_map_[order->getOrderId()] = --bids_[price].end(); 
-        aggregated_bids_[price] += order->getRemainingQuantity();
-    } 
-    else 
+        uint64_t total_qty = level.total_quantity;
+
+        std::cout << "Price: " << std::setw(price_width) << std::fixed << std::setprecision(2) << price
+                  << ", Qty: " << std::setw(qty_width) << total_qty << " ";
+        size_t bar_count = std::min<size_t>(total_qty, bar_max);
+        for (size_t i = 0; i < bar_count; ++i) 
+            std::cout << "|";
+        if (total_qty > bar_max)
+            std::cout << "...";
+        std::cout << "\n";
+    }
+    std::cout << "\n";
+}
+
+} // namespace
+
+OrderBook::OrderBook(const std::string& symbol, MemoryArena* arena) 
+    : symbol_(symbol),
+      symbol_id_(SymbolTable::intern(symbol)),
+      bids_(BidLevels::allocator_type(ArenaAllocator<BidLevels::value_type>(arena))),
+      asks_(AskLevels::allocator_type(ArenaAllocator<AskLevels::value_type>(arena))),
+      order_index_(0, ClientOrderKeyHash(), std::equal_to<ClientOrderKey>(), OrderIndex::allocator_type(arena))
+{
+    bids_.setLevelPoolCapacity(kDefaultLevelPoolCapacity);
+    asks_.setLevelPoolCapacity(kDefaultLevelPoolCapacity);
+}
+
+template<OrderSide Side>
+void BookSide<Side>::setLevelPoolCapacity(size_t levels)
+{
+    level_pool_capacity_ = levels;
+    // Os nós que passaram do novo limite são liberados pelo destrutor do node handle
+    if (free_levels_.size() > levels) free_levels_.resize(levels);
+    free_levels_.reserve(levels);
+}
+
+template<OrderSide Side>
+typename BookSide<Side>::Levels::iterator BookSide<Side>::acquireLevel(double price)
+{
+    // lower_bound serve de busca e de dica: o nível novo entra imediatamente antes dele, sem segunda descida na árvore
+    typename Levels::iterator hint = levels_.lower_bound(price);
+    if (hint != levels_.end() && !Compare{}(price, hint->first)) 
     {
-        asks_[price].push_back(order);
-        order_id_map_[order->getOrderId()] = --asks_[price].end(); 
-        aggregated_asks_[price] += order->getRemainingQuantity();
+        return hint;
     }
-    
-    return true;
+    if (free_levels_.empty()) 
+    {
+        ++level_creations_;
+        return levels_.try_emplace(hint, price);
+    }
+
+    typename Levels::node_type node = std::move(free_levels_.back());
+    free_levels_.pop_back();
+    node.key() = price;
+    ++level_reuses_;
+    return levels_.insert(hint, std::move(node));
 }
 
-bool OrderBook::removeOrder(uint64_t orderId) 
+template<OrderSide Side>
+void BookSide<Side>::releaseLevel(typename Levels::iterator level)
 {
-    // Encontrar a ordem no nosso índice por ID O(1)
-    std::unordered_map<uint64_t, OrderIterator>::iterator it_map = order_id_map_.find(orderId);
-    if (it_map == order_id_map_.end()) 
+    if (free_levels_.size() >= level_pool_capacity_) 
     {
-        std::cerr << "Erro: Ordem " << orderId << " não encontrada para remoção.\n";
-        return false;
+        levels_.erase(level);
+        return;
     }
+    // O sweep não zera o total dos níveis que consome por inteiro; o nó volta limpo para a lista
+    typename Levels::node_type node = levels_.extract(level);
+    node.mapped().total_quantity = 0;
+    free_levels_.push_back(std::move(node));
+}
 
-    // Obter o iterador que aponta para a ordem na lista de preços
-    OrderIterator list_iterator = it_map->second;
-    const std::shared_ptr<Order>& order_ptr = *list_iterator;
+template<OrderSide Side>
+void BookSide<Side>::setDepthPrefixLevels(size_t levels)
+{
+    depth_prefix_levels_ = levels;
+    prefix_ = DepthPrefix{};
+}
 
-    double price = order_ptr->getPrice();
-    OrderSide side = order_ptr->getSide();
+template<OrderSide Side>
+void BookSide<Side>::invalidateDepthPrefix(double price)
+{
+    if (depth_prefix_levels_ == 0 || prefix_.dirty) return;
 
-    // Apagar a ordem do livro de Bids ou Asks
-    if (side == OrderSide::Buy) 
+    // Um prefixo incompleto cobre o lado inteiro; um completo só é afetado até o seu último preço
+    if (prefix_.prices.size() < depth_prefix_levels_ || notWorse(price, prefix_.prices.back())) prefix_.dirty = true;
+}
+
+template<OrderSide Side>
+bool BookSide<Side>::hasLiquidity(double limit, uint64_t needed) const
+{
+    typename Levels::const_iterator level = levels_.begin();
+    uint64_t available = 0;
+
+    if (depth_prefix_levels_ > 0) 
     {
-        std::map<double, std::list<std::shared_ptr<Order>>, std::greater<double>>::iterator priceIt = bids_.find(price);
-        if(priceIt == bids_.end()) 
+        if (prefix_.dirty) 
         {
-            std::cerr << "Erro: Ordem " << orderId << " não encontrada.\n";
-            return false;
+            prefix_.prices.clear();
+            prefix_.cumulative.clear();
+            uint64_t cumulative = 0;
+            for (typename Levels::const_iterator it = levels_.begin(); it != levels_.end() && prefix_.prices.size() < depth_prefix_levels_; ++it) 
+            {
+                cumulative += it->second.total_quantity;
+                prefix_.prices.push_back(it->first);
+                prefix_.cumulative.push_back(cumulative);
+            }
+            prefix_.dirty = false;
         }
 
-        std::list<std::shared_ptr<Order>>& price_level_list = priceIt->second;
-        if (price_level_list.empty()) 
-        {
-            std::cerr << "Erro: Lista de preços vazia para a ordem " << orderId << ".\n";
-            return false;
-        }
+        // Os níveis que cruzam são sempre um prefixo do lado (melhor preço primeiro), então basta uma busca binária
+        size_t crossing = std::partition_point(prefix_.prices.begin(), prefix_.prices.end(),
+                                               [limit](double price) { return notWorse(price, limit); }) - prefix_.prices.begin();
+        if (crossing > 0) available = prefix_.cumulative[crossing - 1];
 
-        price_level_list.erase(list_iterator); // O(1)
-        
-        // Se a lista para este nível de preço ficou vazia, removemos o nível de preço do mapa
-        if (price_level_list.empty()) 
+        // Só precisa continuar no mapa se todos os N níveis cobertos cruzam, não bastam e existem níveis além deles
+        if (available >= needed || crossing < prefix_.prices.size() || levels_.size() == prefix_.prices.size()) 
         {
-            bids_.erase(priceIt); // O(logn)
+            return available >= needed;
         }
+        // O primeiro nível fora do prefixo sai da árvore em O(log n); std::next andaria os N níveis um a um
+        level = levels_.upper_bound(prefix_.prices.back());
+    }
+
+    for (; level != levels_.end() && notWorse(level->first, limit); ++level) 
+    {
+        available += level->second.total_quantity;
+        if (available >= needed) return true;
+    }
+    return false;
+}
+
+template<OrderSide Side>
+bool BookSide<Side>::affectsTopLevels(double price, size_t depth) const
+{
+    if (levels_.size() < depth) return true;
+    return notWorse(price, std::next(levels_.begin(), depth - 1)->first);
+}
+
+template<OrderSide Side>
+void BookSide<Side>::refreshTop(TopOfBook& top) const
+{
+    const double price = levels_.empty() ? 0.0 : levels_.begin()->first;
+    const uint64_t quantity = levels_.empty() ? 0 : levels_.begin()->second.total_quantity;
+    const uint32_t orders = levels_.empty() ? 0 : static_cast<uint32_t>(levels_.begin()->second.orderCount());
+    if constexpr (Side == OrderSide::Buy) 
+    {
+        top.bid_price = price;
+        top.bid_quantity = quantity;
+        top.bid_orders = orders;
     } 
     else 
-    { 
-        std::map<double, std::list<std::shared_ptr<Order>>>::iterator priceIt = asks_.find(price);
-        if(priceIt == asks_.end()) 
-        {
-            std::cerr << "Erro: Ordem " << orderId << " não encontrada.\n";
-            return false;
-        }
+    {
+        top.ask_price = price;
+        top.ask_quantity = quantity;
+        top.ask_orders = orders;
+    }
+}
 
-        std::list<std::shared_ptr<Order>>& price_level_list = priceIt->second;
-        if (price_level_list.empty()) 
-        {
-            std::cerr << "Erro: Lista de preços vazia para a ordem " << orderId << ".\n";
-            return false;
-        }
+template<OrderSide Side>
+uint32_t BookSide<Side>::copyTopLevels(BookDepthView::Level* out, size_t depth) const
+{
+    uint32_t count = 0;
+    for (typename Levels::const_iterator it = levels_.begin(); it != levels_.end() && count < depth; ++it, ++count)
+    {
+        out[count] = {it->first, it->second.total_quantity, static_cast<uint32_t>(it->second.orderCount()), 0};
+    }
+    return count;
+}
 
-        price_level_list.erase(list_iterator); // O(1)
+template class BookSide<OrderSide::Buy>;
+template class BookSide<OrderSide::Sell>;
 
-        // Se a lista para este nível de preço ficou vazia, removemos o nível de preço do mapa O(logn)
-        if (price_level_list.empty()) 
-        {
-            asks_.erase(priceIt);
-        }
-    }
+void OrderBook::setLevelPoolCapacity(size_t levels)
+{
+    bids_.setLevelPoolCapacity(levels);
+    asks_.setLevelPoolCapacity(levels);
+}
 
-    // Apagar a ordem do nosso índice
-    order_id_map_.erase(it_map);
-    std::cout << "Ordem de compra com ID: " << orderId << " e preço: " << price << " foi removida com sucesso\n";
+bool OrderBook::addOrder(std::shared_ptr<Order> order)
+{
+    // Reserva a entrada no índice primeiro: um ClOrdID repetido do mesmo cliente é rejeitado sem tocar no livro
+    std::pair<OrderIndex::iterator, bool> index_entry =
+        order_index_.try_emplace(ClientOrderKey{order->getClientId(), order->getClientOrderId()});
+    if (!index_entry.second) 
+    {
+        return false;
+    }
 
+    OrderLocation& location = index_entry.first->second;
+    if (order->getSide() == OrderSide::Buy) addToSide(bids_, location, std::move(order));
+    else addToSide(asks_, location, std::move(order));
     return true;
 }
 
-void OrderBook::updateAggregatedQuantity(OrderSide side, double price, uint32_t quantity_delta) 
+template<OrderSide Side>
+void OrderBook::addToSide(BookSide<Side>& book_side, OrderLocation& location, std::shared_ptr<Order> order)
 {
-    if (side == OrderSide::Buy) 
+    // Uma única busca na árvore: a FIFO e a quantidade total estão no mesmo nível
+    const double price = order->getPrice();
+    const uint32_t remaining = order->getRemainingQuantity();
+    typename BookSide<Side>::Levels::iterator& level_it = location.level<Side>();
+    level_it = book_side.acquireLevel(price);
+    BookLevel& level = level_it->second;
+    level.orders.push_back(std::move(order));
+    location.order = std::prev(level.orders.end());
+    level.total_quantity += remaining;
+
+    book_side.invalidateDepthPrefix(price);
+    book_side.refreshTop(top_of_book_);
+}
+
+void OrderBook::publishDepthView(size_t depth)
+{
+    // Montada na pilha e publicada de uma vez: a janela em que os leitores repetem é só a cópia para o seqlock
+    BookDepthView view;
+    view.version = ++depth_view_version_;
+    view.last_trade_price = has_traded_ ? last_trade_price_ : 0.0;
+    depth = std::min(depth, BookDepthView::kMaxLevels);
+
+    view.bid_count = bids_.copyTopLevels(view.bids, depth);
+    view.ask_count = asks_.copyTopLevels(view.asks, depth);
+    depth_view_.store(view);
+}
+
+std::shared_ptr<Order> OrderBook::removeOrder(uint64_t client_id, uint64_t client_order_id) 
+{
+    // Encontrar a ordem no nosso índice pela chave do cliente O(1) - é o único probe de hash do cancel
+    OrderIndex::iterator it_index = order_index_.find(ClientOrderKey{client_id, client_order_id});
+    if (it_index == order_index_.end()) 
     {
-        auto it = aggregated_bids_.find(price);
-        if (it != aggregated_bids_.end()) 
-        {
-            it->second -= quantity_delta; 
-            if (it->second <= 0) aggregated_bids_.erase(it); 
-        } 
-        else if (quantity_delta > 0) 
+        return nullptr;
+    }
+
+    const OrderLocation& location = it_index->second;
+    std::shared_ptr<Order> order_ptr = std::move(*location.order);
+    if (order_ptr->getSide() == OrderSide::Buy) removeFromSide(bids_, location, *order_ptr);
+    else removeFromSide(asks_, location, *order_ptr);
+
+    // Apagar a ordem do nosso índice pelo iterador, sem recalcular o hash
+    order_index_.erase(it_index);
+    return order_ptr;
+}
+
+template<OrderSide Side>
+void OrderBook::removeFromSide(BookSide<Side>& book_side, const OrderLocation& location, const Order& order)
+{
+    // O nível de preço já vem na localização, então não há find() na árvore: unlink O(1), ajuste do total no
+    // mesmo nó e, se o nível esvaziou, ele sai pelo iterador (O(1) amortizado) para a free list do lado
+    book_side.invalidateDepthPrefix(order.getPrice());
+    typename BookSide<Side>::Levels::iterator level_it = location.level<Side>();
+    BookLevel& level = level_it->second;
+    level.orders.erase(location.order);
+    level.total_quantity -= order.getRemainingQuantity();
+    if (level.orders.empty()) 
+    {
+        book_side.releaseLevel(level_it);
+    }
+    book_side.refreshTop(top_of_book_);
+}
+
+AmendOutcome OrderBook::amendOrder(uint64_t client_id, uint64_t orig_client_order_id, uint64_t new_client_order_id,
+                                   uint32_t new_quantity, double new_price)
+{
+    AmendOutcome outcome{AmendOutcome::Result::Amended, nullptr};
+
+    OrderIndex::iterator it_index = order_index_.find(ClientOrderKey{client_id, orig_client_order_id});
+    if (it_index == order_index_.end()) 
+    {
+        outcome.result = AmendOutcome::Result::UnknownOrder;
+        return outcome;
+    }
+
+    OrderLocation location = it_index->second;
+    std::shared_ptr<Order> order_ptr = *location.order;
+    if (new_quantity <= order_ptr->getFilledQuantity()) 
+    {
+        outcome.result = AmendOutcome::Result::InvalidQuantity;
+        return outcome;
+    }
+
+    // Troca a chave do índice reaproveitando o mesmo nó do unordered_map (extract/insert não alocam)
+    if (new_client_order_id != orig_client_order_id) 
+    {
+        OrderIndex::node_type node = order_index_.extract(it_index);
+        node.key() = ClientOrderKey{client_id, new_client_order_id};
+        OrderIndex::insert_return_type inserted = order_index_.insert(std::move(node));
+        if (!inserted.inserted) 
         {
-            aggregated_bids_[price] = quantity_delta;
-        } 
-        else {
-            std::cerr << "AVISO: Tentativa de subtrair quantidade de um nível de preço agregado inexistente para Bids @ " << price << std::endl;
+            inserted.node.key() = ClientOrderKey{client_id, orig_client_order_id};
+            order_index_.insert(std::move(inserted.node));
+            outcome.result = AmendOutcome::Result::DuplicateClientOrderId;
+            return outcome;
         }
+        it_index = inserted.position;
+    }
+
+    double old_price = order_ptr->getPrice();
+    uint32_t old_remaining = order_ptr->getRemainingQuantity();
+    outcome.previous_price = old_price;
+    outcome.order = order_ptr;
+
+    order_ptr->amend(new_client_order_id, new_quantity, new_price);
+    uint32_t new_remaining = order_ptr->getRemainingQuantity();
+
+    if (order_ptr->getSide() == OrderSide::Buy) 
+    {
+        outcome.kept_priority = amendOnSide(bids_, it_index->second, location, old_price, old_remaining, new_price, new_remaining);
     } 
     else 
-    { 
-        auto it = aggregated_asks_.find(price);
-        if (it != aggregated_asks_.end()) 
-        {
-            it->second -= quantity_delta;
-            if (it->second <= 0) aggregated_asks_.erase(it);
-        } 
-        else if (quantity_delta > 0) 
+    {
+        outcome.kept_priority = amendOnSide(asks_, it_index->second, location, old_price, old_remaining, new_price, new_remaining);
+    }
+    return outcome;
+}
+
+template<OrderSide Side>
+bool OrderBook::amendOnSide(BookSide<Side>& book_side, OrderLocation& indexed, const OrderLocation& previous, double old_price,
+                            uint32_t old_remaining, double new_price, uint32_t new_remaining)
+{
+    typename BookSide<Side>::Levels::iterator source_it = previous.level<Side>();
+    BookLevel& source = source_it->second;
+
+    // Redução de quantidade no mesmo preço: mantém a posição na fila e só ajusta o total do nível
+    book_side.invalidateDepthPrefix(old_price);
+    if (new_price == old_price && new_remaining <= old_remaining) 
+    {
+        source.total_quantity -= old_remaining - new_remaining;
+        book_side.refreshTop(top_of_book_);
+        return true;
+    }
+
+    // Mudança de preço ou aumento de quantidade: perde a prioridade. O nó da lista é movido com splice
+    // para o fim do nível de destino, então não há free/malloc da ordem nem novo probe no índice
+    typename BookSide<Side>::Levels::iterator target = book_side.acquireLevel(new_price);
+    target->second.orders.splice(target->second.orders.end(), source.orders, previous.order);
+    target->second.total_quantity += new_remaining;
+    source.total_quantity -= old_remaining;
+    if (source.orders.empty()) book_side.releaseLevel(source_it);
+    indexed.level<Side>() = target;
+
+    book_side.invalidateDepthPrefix(new_price);
+    book_side.refreshTop(top_of_book_);
+    return false;
+}
+
+void OrderBook::sweep(Order& aggressive_order, std::vector<Fill>& fills)
+{
+    // O lado é decidido uma vez por ordem; o laço de matching é a instância do lado passivo
+    if (aggressive_order.getSide() == OrderSide::Buy) sweepSide(aggressive_order, asks_, fills);
+    else sweepSide(aggressive_order, bids_, fills);
+
+    if (!fills.empty()) 
+    {
+        last_trade_price_ = fills.back().price;
+        has_traded_ = true;
+    }
+}
+
+template<OrderSide Side>
+void OrderBook::sweepSide(Order& aggressive_order, BookSide<Side>& passive_side, std::vector<Fill>& fills)
+{
+    // Uma ordem a mercado recebe um limite que alcança qualquer nível, e o laço não precisa testar o tipo
+    const double limit = aggressive_order.getType() == OrderType::Market ? BookSide<Side>::kUnlimited : aggressive_order.getPrice();
+    const size_t first_fill = fills.size();
+
+    typename BookSide<Side>::Levels& levels = passive_side.levels();
+    typename BookSide<Side>::Levels::iterator level = levels.begin();
+    while (level != levels.end() && aggressive_order.getRemainingQuantity() > 0 && BookSide<Side>::notWorse(level->first, limit)) 
+    {
+        const double price = level->first;
+        LevelOrders& fifo = level->second.orders;
+        uint64_t level_filled = 0;
+
+        // Percorre a fila do nível em ordem de chegada (prioridade de tempo)
+        OrderIterator it = fifo.begin();
+        while (it != fifo.end() && aggressive_order.getRemainingQuantity() > 0) 
         {
-             aggregated_asks_[price] = quantity_delta;
-        } 
-        else 
+            Order& passive_order = **it;
+            uint32_t filled_qty = std::min(aggressive_order.getRemainingQuantity(), passive_order.getRemainingQuantity());
+
+            aggressive_order.applyFill(filled_qty, price);
+            passive_order.applyFill(filled_qty, price);
+            level_filled += filled_qty;
+
+            fills.push_back(Fill{*it, price, filled_qty, passive_order.getRemainingQuantity(), passive_order.getStatus(),
+                                 aggressive_order.getRemainingQuantity(), aggressive_order.getStatus()});
+
+            if (!passive_order.isFilled()) break;
+
+            order_index_.erase(ClientOrderKey{passive_order.getClientId(), passive_order.getClientOrderId()});
+            it = fifo.erase(it);
+        }
+
+        if (!fifo.empty()) 
         {
-            std::cerr << "AVISO: Tentativa de subtrair quantidade de um nível de preço agregado inexistente para Asks @ " << price << std::endl;
+            // Nível parcialmente consumido: o total é ajustado no próprio nó, sem outra busca
+            level->second.total_quantity -= level_filled;
+            break;
         }
+        ++level;
+    }
+
+    // Todos os níveis antes de 'level' foram esvaziados: saem da frente da árvore, um a um para a free list
+    while (levels.begin() != level) 
+    {
+        passive_side.releaseLevel(levels.begin());
+    }
+
+    if (fills.size() != first_fill) 
+    {
+        passive_side.markDepthPrefixDirty();
+        passive_side.refreshTop(top_of_book_);
     }
 }
 
-void OrderBook::printTopAsk() const
+AuctionResult OrderBook::computeAuctionPrice() const
 {
-    if (asks_.empty()) 
+    AuctionResult result;
+    const BidLevels& bids = bids_.levels();
+    const AskLevels& asks = asks_.levels();
+    if (bids.empty() || asks.empty()) return result;
+
+    const double best_bid = bids.begin()->first;
+    const double best_ask = asks.begin()->first;
+    if (best_bid < best_ask) return result;
+
+    // Só os níveis dentro de [melhor venda, melhor compra] entram na grade: fora dela um lado não encontra o outro.
+    // Os dois lados são intercalados em ordem crescente (a árvore de compra é decrescente, então é lida de trás
+    // para frente) e um preço presente nos dois lados ocupa uma única posição.
+    AuctionGrid& grid = auction_grid_;
+    grid.prices.clear();
+    grid.bid_quantity.clear();
+    grid.ask_quantity.clear();
+
+    AskLevels::const_iterator ask = asks.begin();
+    const AskLevels::const_iterator ask_end = asks.upper_bound(best_bid);
+    BidLevels::const_reverse_iterator bid(bids.upper_bound(best_ask));
+    const BidLevels::const_reverse_iterator bid_end = bids.rend();
+    while (ask != ask_end || bid != bid_end) 
     {
-        return;
+        const bool take_ask = bid == bid_end || (ask != ask_end && ask->first <= bid->first);
+        const bool take_bid = ask == ask_end || (bid != bid_end && bid->first <= ask->first);
+        grid.prices.push_back(take_ask ? ask->first : bid->first);
+        grid.ask_quantity.push_back(take_ask ? ask->second.total_quantity : 0);
+        grid.bid_quantity.push_back(take_bid ? bid->second.total_quantity : 0);
+        if (take_ask) ++ask;
+        if (take_bid) ++bid;
     }
 
-    auto it = asks_.begin();
-    if (it->second.empty()) 
+    const size_t count = grid.prices.size();
+    grid.demand.resize(count);
+    grid.supply.resize(count);
+    grid.executable.resize(count);
+    const uint64_t* bid_quantity = grid.bid_quantity.data();
+    const uint64_t* ask_quantity = grid.ask_quantity.data();
+    uint64_t* demand = grid.demand.data();
+    uint64_t* supply = grid.supply.data();
+    uint64_t* executable = grid.executable.data();
+
+    // Oferta acumulada de baixo para cima e demanda acumulada de cima para baixo
+    uint64_t running = 0;
+    for (size_t i = 0; i < count; ++i) 
     {
-        return;
+        running += ask_quantity[i];
+        supply[i] = running;
+    }
+    running = 0;
+    for (size_t i = count; i > 0; --i) 
+    {
+        running += bid_quantity[i - 1];
+        demand[i - 1] = running;
     }
 
-    const auto& order = it->second.front();
-    std::cout << "Top Ask: \nPrice: " << order->getPrice() 
-              << ", Quantity: " << order->getRemainingQuantity() 
-              << "\n";
+    // Sem dependência entre posições: o mínimo e a redução do máximo são vetorizados pelo compilador
+    for (size_t i = 0; i < count; ++i) 
+    {
+        executable[i] = std::min(demand[i], supply[i]);
+    }
+    uint64_t best_volume = 0;
+    for (size_t i = 0; i < count; ++i) 
+    {
+        best_volume = std::max(best_volume, executable[i]);
+    }
+    if (best_volume == 0) return result;
+
+    // Desempate entre os preços de volume máximo: menor desequilíbrio, depois o mais próximo da referência
+    const double reference = has_traded_ ? last_trade_price_ : (best_bid + best_ask) / 2.0;
+    size_t best = count;
+    uint64_t best_imbalance = 0;
+    double best_distance = 0.0;
+    for (size_t i = 0; i < count; ++i) 
+    {
+        if (executable[i] != best_volume) continue;
+
+        const uint64_t imbalance = demand[i] > supply[i] ? demand[i] - supply[i] : supply[i] - demand[i];
+        const double distance = std::abs(grid.prices[i] - reference);
+        if (best == count || imbalance < best_imbalance || (imbalance == best_imbalance && distance < best_distance)) 
+        {
+            best = i;
+            best_imbalance = imbalance;
+            best_distance = distance;
+        }
+    }
+
+    result.crossed = true;
+    result.price = grid.prices[best];
+    result.volume = best_volume;
+    result.imbalance = static_cast<int64_t>(demand[best]) - static_cast<int64_t>(supply[best]);
+    return result;
 }
 
-void OrderBook::printTopBid() const
+AuctionResult OrderBook::uncross(std::vector<AuctionFill>& fills)
 {
-    if (bids_.empty()) 
+    AuctionResult result = computeAuctionPrice();
+    if (!result.crossed) return result;
+
+    const double price = result.price;
+    const size_t first_fill = fills.size();
+    BidLevels& bids = bids_.levels();
+    AskLevels& asks = asks_.levels();
+
+    // Uma única reserva: toda execução menos a última termina ao menos uma ordem, então as ordens dos níveis
+    // elegíveis (mais um) limitam o número de execuções
+    size_t eligible_orders = 1;
+    for (BidLevels::const_iterator it = bids.begin(); it != bids.end() && BookSide<OrderSide::Buy>::notWorse(it->first, price); ++it) eligible_orders += it->second.orderCount();
+    for (AskLevels::const_iterator it = asks.begin(); it != asks.end() && BookSide<OrderSide::Sell>::notWorse(it->first, price); ++it) eligible_orders += it->second.orderCount();
+    fills.reserve(first_fill + eligible_orders);
+
+    // Duas frentes andando juntas, cada uma em prioridade de preço e tempo do seu lado. Como o volume é o mínimo
+    // entre demanda e oferta ao preço, as primeiras 'volume' unidades de cada lado estão todas do lado certo dele.
+    BidLevels::iterator bid_level = bids.begin();
+    AskLevels::iterator ask_level = asks.begin();
+    OrderIterator bid_it = bid_level->second.orders.begin();
+    OrderIterator ask_it = ask_level->second.orders.begin();
+    uint64_t bid_level_filled = 0;
+    uint64_t ask_level_filled = 0;
+    uint64_t remaining = result.volume;
+
+    while (remaining > 0 && bid_level != bids.end() && ask_level != asks.end()) 
     {
-        return;
+        Order& buy = **bid_it;
+        Order& sell = **ask_it;
+        const uint32_t quantity = static_cast<uint32_t>(std::min<uint64_t>(remaining, std::min(buy.getRemainingQuantity(), sell.getRemainingQuantity())));
+
+        buy.applyFill(quantity, price);
+        sell.applyFill(quantity, price);
+        fills.push_back(AuctionFill{*bid_it, *ask_it, quantity, buy.getRemainingQuantity(), buy.getStatus(),
+                                    sell.getRemainingQuantity(), sell.getStatus()});
+        remaining -= quantity;
+        bid_level_filled += quantity;
+        ask_level_filled += quantity;
+
+        // Um nível esgotado fica na árvore até o fim do laço e sai junto com os outros da frente
+        if (buy.isFilled()) 
+        {
+            order_index_.erase(ClientOrderKey{buy.getClientId(), buy.getClientOrderId()});
+            bid_it = bid_level->second.orders.erase(bid_it);
+            if (bid_it == bid_level->second.orders.end()) 
+            {
+                bid_level_filled = 0;
+                if (++bid_level != bids.end()) bid_it = bid_level->second.orders.begin();
+            }
+        }
+        if (sell.isFilled()) 
+        {
+            order_index_.erase(ClientOrderKey{sell.getClientId(), sell.getClientOrderId()});
+            ask_it = ask_level->second.orders.erase(ask_it);
+            if (ask_it == ask_level->second.orders.end()) 
+            {
+                ask_level_filled = 0;
+                if (++ask_level != asks.end()) ask_it = ask_level->second.orders.begin();
+            }
+        }
     }
 
-    auto it = bids_.begin();
-    if (it->second.empty()) 
+    // Os níveis parcialmente consumidos têm o total ajustado no próprio nó; os esgotados saem para a free list
+    if (bid_level != bids.end()) bid_level->second.total_quantity -= bid_level_filled;
+    if (ask_level != asks.end()) ask_level->second.total_quantity -= ask_level_filled;
+    while (bids.begin() != bid_level) 
     {
-        return;
+        bids_.releaseLevel(bids.begin());
+    }
+    while (asks.begin() != ask_level) 
+    {
+        asks_.releaseLevel(asks.begin());
     }
 
-    const auto& order = it->second.front();
-    std::cout << "Top Bid: \nPrice: " << order->getPrice() 
-              << ", Quantity: " << order->getRemainingQuantity() 
-              << "\n";
+    bids_.markDepthPrefixDirty();
+    asks_.markDepthPrefixDirty();
+    bids_.refreshTop(top_of_book_);
+    asks_.refreshTop(top_of_book_);
+    last_trade_price_ = price;
+    has_traded_ = true;
+
+    result.volume -= remaining;
+    result.trades = fills.size() - first_fill;
+    return result;
 }
 
-void OrderBook::printAsks() const
+bool OrderBook::hasLiquidityFor(const Order& order) const
 {
-    if (!asks_.empty())
-        std::cout << "\nAsks:\n";
+    const bool is_market = order.getType() == OrderType::Market;
+    const uint64_t needed = order.getRemainingQuantity();
 
-    constexpr int price_width = 6;
-    constexpr int qty_width = 5;
-    constexpr size_t bar_max = 130;
-
-    for (const auto& [price, orders] : asks_)
+    if (order.getSide() == OrderSide::Buy) 
     {
-        uint64_t total_qty = 0;
-        for (const auto& order : orders)
-            total_qty += order->getRemainingQuantity();
-
-        std::cout << "Price: " << std::setw(price_width) << std::fixed << std::setprecision(2) << price
-                  << ", Qty: " << std::setw(qty_width) << total_qty << " ";
-        size_t bar_count = std::min<size_t>(total_qty, bar_max);
-        for (size_t i = 0; i < bar_count; ++i) 
-            std::cout << "|";
-        if (total_qty > bar_max)
-            std::cout << "...";
-        std::cout << "\n";
+        return asks_.hasLiquidity(is_market ? BookSide<OrderSide::Sell>::kUnlimited : order.getPrice(), needed);
     }
-    std::cout << "\n";
+    return bids_.hasLiquidity(is_market ? BookSide<OrderSide::Buy>::kUnlimited : order.getPrice(), needed);
 }
 
-void OrderBook::printBids() const
+void OrderBook::setDepthPrefixLevels(size_t levels)
 {
-    if (!bids_.empty())
-        std::cout << "\nBids:\n";
+    bids_.setDepthPrefixLevels(levels);
+    asks_.setDepthPrefixLevels(levels);
+}
 
-    constexpr int price_width = 6;
-    constexpr int qty_width = 5;
-    constexpr size_t bar_max = 130;
+bool OrderBook::takeTopOfBookChange()
+{
+    // Compara com o último BBO entregue, então um topo que mudou e voltou dentro do mesmo comando não gera evento
+    if (top_of_book_ == published_top_) return false;
 
-    for (const auto& [price, orders] : bids_)
-    {
-        uint64_t total_qty = 0;
-        for (const auto& order : orders)
-            total_qty += order->getRemainingQuantity();
+    published_top_ = top_of_book_;
+    ++top_sequence_;
+    return true;
+}
 
-        std::cout << "Price: " << std::setw(price_width) << std::fixed << std::setprecision(2) << price
-                  << ", Qty: " << std::setw(qty_width) << total_qty << " ";
-        size_t bar_count = std::min<size_t>(total_qty, bar_max);
-        for (size_t i = 0; i < bar_count; ++i) 
-            std::cout << "|";
-        if (total_qty > bar_max)
-            std::cout << "...";
-        std::cout << "\n";
-    }
-    std::cout << "\n";
+bool OrderBook::containsOrder(uint64_t client_id, uint64_t client_order_id) const
+{
+    return order_index_.find(ClientOrderKey{client_id, client_order_id}) != order_index_.end();
+}
+
+bool OrderBook::isResting(const Order& order) const
+{
+    OrderIndex::const_iterator it_index =
+        order_index_.find(ClientOrderKey{order.getClientId(), order.getClientOrderId()});
+    return it_index != order_index_.end() && it_index->second.order->get() == &order;
+}
+
+bool OrderBook::isMarketable(const Order& order) const
+{
+    return order.getSide() == OrderSide::Buy ? asks_.crossedBy(order.getPrice()) : bids_.crossedBy(order.getPrice());
+}
+
+bool OrderBook::affectsTopLevels(OrderSide side, double price, size_t depth) const
+{
+    return side == OrderSide::Buy ? bids_.affectsTopLevels(price, depth) : asks_.affectsTopLevels(price, depth);
+}
+
+void OrderBook::printTopAsk() const
+{
+    printTopLevel(asks_.levels(), "Top Ask");
+}
+
+void OrderBook::printTopBid() const
+{
+    printTopLevel(bids_.levels(), "Top Bid");
+}
+
+void OrderBook::printAsks() const
+{
+    printLevels(asks_.levels(), "Asks");
+}
+
+void OrderBook::printBids() const
+{
+    printLevels(bids_.levels(), "Bids");
 }
 
 void OrderBook::printOrders() const
@@ -248,18 +721,18 @@ void OrderBook::printOrders() const
     const int LARGURA_TOTAL = (LARGURA_COLUNA_PRECO + LARGURA_COLUNA_QTY + LARGURA_COLUNA_BARRA) * 2 + 3;
     std::cout << std::string(LARGURA_TOTAL, '-') << "\n";
 
-    auto bid_it = bids_.begin();
-    auto ask_it = asks_.begin();
+    const BidLevels& bids = bids_.levels();
+    const AskLevels& asks = asks_.levels();
+    auto bid_it = bids.begin();
+    auto ask_it = asks.begin();
 
     // Itera enquanto houver ordens em qualquer um dos lados
-    while (bid_it != bids_.end() || ask_it != asks_.end())
+    while (bid_it != bids.end() || ask_it != asks.end())
     {
         // --- Processa a linha do lado BID (Compra) ---
-        if (bid_it != bids_.end())
+        if (bid_it != bids.end())
         {
-            uint64_t total_qty = 0;
-            for (const auto& order : bid_it->second)
-                total_qty += order->getRemainingQuantity();
+            uint64_t total_qty = bid_it->second.total_quantity;
             
             size_t bar_count = std::min<size_t>(total_qty, LARGURA_COLUNA_BARRA);
             std::string bar;
@@ -283,11 +756,9 @@ void OrderBook::printOrders() const
         std::cout << " | ";
 
         // --- Processa a linha do lado ASK (Venda) ---
-        if (ask_it != asks_.end())
+        if (ask_it != asks.end())
         {
-            uint64_t total_qty = 0;
-            for (const auto& order : ask_it->second)
-                total_qty += order->getRemainingQuantity();
+            uint64_t total_qty = ask_it->second.total_quantity;
             
             size_t bar_count = std::min<size_t>(total_qty, LARGURA_COLUNA_BARRA);
             std::string bar;
@@ -308,40 +779,25 @@ void OrderBook::printOrders() const
     std::cout << std::string(LARGURA_TOTAL, '-') << std::endl;
 }
 
-std::shared_ptr<Order> OrderBook::getTopBid() 
+std::shared_ptr<Order> OrderBook::getTopBid() const
 {
-    if (bids_.empty()) 
+    // Lado vazio não é erro: quem só precisa do preço/quantidade deve usar getTopOfBook()
+    if (bids_.levels().empty()) 
     {
-        std::cerr << "No bids available.\n";
-        return nullptr;
-    }
-    
-    std::map<double, std::list<std::shared_ptr<Order>>, std::greater<double>>::const_iterator itBids = bids_.begin();
-    if (itBids->second.empty()) 
-    {
-        std::cerr << "No orders at the top bid price.\n";
         return nullptr;
     }
     
     // Retorna o ponteiro compartilhado pra primeira ordem do nível de preço mais alto
-    return itBids->second.front(); 
+    return bids_.levels().begin()->second.orders.front(); 
 }
 
-std::shared_ptr<Order> OrderBook::getTopAsk() 
+std::shared_ptr<Order> OrderBook::getTopAsk() const
 {
-    if (asks_.empty()) 
-    {
-        std::cerr << "No asks available.\n";
-        return nullptr;
-    }
-    
-    auto itAsks = asks_.begin();
-    if (itAsks->second.empty()) 
+    if (asks_.levels().empty()) 
     {
-        std::cerr << "No orders at the top ask price.\n";
         return nullptr;
     }
 
     // Retorna o ponteiro compartilhado pra primeira ordem do nível de preço mais baixo
-    return itAsks->second.front(); 
+    return asks_.levels().begin()->second.orders.front(); 
 }
\ No newline at end of file
@@ -0,0 +1,251 @@
+#include "domain/pre_trade_risk.hpp"
+#include <cmath>
+
+namespace
+{
+
+size_t clientSlot(uint64_t client_id)
+{
+    // Fibonacci hashing: ids sequenciais se espalham pela tabela
+    return static_cast<size_t>((client_id * 0x9E3779B97F4A7C15ull) >> 52) & (PreTradeRisk::kMaxClients - 1);
+}
+
+bool isValidSide(OrderSide side)
+{
+    return side == OrderSide::Buy || side == OrderSide::Sell;
+}
+
+} // namespace
+
+static_assert((PreTradeRisk::kMaxClients & (PreTradeRisk::kMaxClients - 1)) == 0, "kMaxClients must be a power of two");
+
+PreTradeRisk::PreTradeRisk(const RiskLimits& default_limits)
+    : default_limits_(default_limits),
+      clients_(new ClientState[kMaxClients])
+{
+}
+
+void PreTradeRisk::addSymbol(const std::string& symbol)
+{
+    if (symbols_.find(symbol) == symbols_.end())
+    {
+        symbols_.emplace(symbol, std::make_unique<SymbolState>());
+    }
+}
+
+bool PreTradeRisk::setClientLimits(uint64_t client_id, const RiskLimits& limits)
+{
+    ClientState* client = acquireClient(client_id);
+    if (!client) return false;
+
+    client->limits = limits;
+    client->custom_limits = true;
+    return true;
+}
+
+PreTradeRisk::ClientState* PreTradeRisk::acquireClient(uint64_t client_id)
+{
+    const uint64_t key = client_id + 1;
+    size_t slot = clientSlot(client_id);
+    for (size_t probe = 0; probe < kMaxClients; ++probe, slot = (slot + 1) & (kMaxClients - 1))
+    {
+        ClientState& client = clients_[slot];
+        uint64_t current = client.key.load(std::memory_order_relaxed);
+        if (current == key) return &client;
+        if (current == 0)
+        {
+            // Dois clientes novos podem disputar o mesmo slot livre: quem perde o CAS segue sondando
+            if (client.key.compare_exchange_strong(current, key, std::memory_order_relaxed) || current == key) return &client;
+        }
+    }
+    return nullptr;
+}
+
+const PreTradeRisk::ClientState* PreTradeRisk::findClient(uint64_t client_id) const
+{
+    const uint64_t key = client_id + 1;
+    size_t slot = clientSlot(client_id);
+    for (size_t probe = 0; probe < kMaxClients; ++probe, slot = (slot + 1) & (kMaxClients - 1))
+    {
+        uint64_t current = clients_[slot].key.load(std::memory_order_relaxed);
+        if (current == key) return &clients_[slot];
+        if (current == 0) return nullptr;
+    }
+    return nullptr;
+}
+
+bool PreTradeRisk::withinMessageRate(ClientState& client, const RiskLimits& limits, const std::chrono::system_clock::time_point& timestamp)
+{
+    if (limits.max_messages_per_second == 0) return true;
+
+    // Janela fixa de um segundo pelo timestamp de recebimento, sem ler o relógio de novo
+    const int64_t second = std::chrono::duration_cast<std::chrono::seconds>(timestamp.time_since_epoch()).count();
+    int64_t window = client.window_second.load(std::memory_order_relaxed);
+    if (window != second && client.window_second.compare_exchange_strong(window, second, std::memory_order_relaxed))
+    {
+        client.window_messages.store(0, std::memory_order_relaxed);
+    }
+    return client.window_messages.fetch_add(1, std::memory_order_relaxed) < limits.max_messages_per_second;
+}
+
+RiskRejectReason PreTradeRisk::checkSize(const SymbolState& symbol, const RiskLimits& limits, uint32_t quantity, double price) const
+{
+    if (limits.max_order_quantity != 0 && quantity > limits.max_order_quantity) return RiskRejectReason::MaxOrderQuantity;
+
+    const double reference = symbol.reference_price.load(std::memory_order_relaxed);
+    if (limits.max_order_notional > 0.0)
+    {
+        // Sem preço limite (a mercado) o notional é estimado pelo último trade; sem trade ainda, não há como estimar
+        const double notional_price = price > 0.0 ? price : reference;
+        if (notional_price * quantity > limits.max_order_notional) return RiskRejectReason::MaxOrderNotional;
+    }
+
+    if (limits.price_band_bps != 0 && price > 0.0 && reference > 0.0 &&
+        std::fabs(price - reference) * 10000.0 > reference * limits.price_band_bps)
+    {
+        return RiskRejectReason::PriceBand;
+    }
+    return RiskRejectReason::None;
+}
+
+RiskRejectReason PreTradeRisk::reject(ClientState& client, RiskRejectReason reason)
+{
+    client.rejected.fetch_add(1, std::memory_order_relaxed);
+    return reason;
+}
+
+RiskRejectReason PreTradeRisk::checkNewOrder(uint64_t client_id, const std::string& symbol, OrderSide side, OrderType type,
+                                             uint32_t quantity, double price, double stop_price,
+                                             const std::chrono::system_clock::time_point& timestamp)
+{
+    ClientState* client = acquireClient(client_id);
+    if (!client) return RiskRejectReason::TooManyClients;
+    const RiskLimits& limits = limitsOf(*client);
+
+    // Toda mensagem conta para a taxa, inclusive as que serão rejeitadas por outro motivo
+    if (!withinMessageRate(*client, limits, timestamp)) return reject(*client, RiskRejectReason::MessageRate);
+
+    std::unordered_map<std::string, std::unique_ptr<SymbolState>>::const_iterator it = symbols_.find(symbol);
+    if (it == symbols_.end()) return reject(*client, RiskRejectReason::UnknownSymbol);
+    if (!isValidSide(side)) return reject(*client, RiskRejectReason::InvalidSide);
+    if (quantity == 0) return reject(*client, RiskRejectReason::InvalidQuantity);
+
+    // Preço limite obrigatório em Limit/StopLimit e StopPx obrigatório em Stop/StopLimit; nenhum preço pode ser negativo
+    bool needs_price = type == OrderType::Limit || type == OrderType::StopLimit;
+    bool needs_stop = type == OrderType::Stop || type == OrderType::StopLimit;
+    if (!std::isfinite(price) || !std::isfinite(stop_price) || price < 0.0 || stop_price < 0.0 ||
+        (needs_price && price == 0.0) || (needs_stop && stop_price == 0.0))
+    {
+        return reject(*client, RiskRejectReason::InvalidPrice);
+    }
+
+    RiskRejectReason size_result = checkSize(*it->second, limits, quantity, price);
+    if (size_result != RiskRejectReason::None) return reject(*client, size_result);
+
+    // Por último: uma ordem aprovada reserva sua vaga de ordem aberta, devolvida pela engine quando ela terminar
+    if (limits.max_open_orders != 0)
+    {
+        if (client->open_orders.fetch_add(1, std::memory_order_relaxed) >= limits.max_open_orders)
+        {
+            client->open_orders.fetch_sub(1, std::memory_order_relaxed);
+            return reject(*client, RiskRejectReason::MaxOpenOrders);
+        }
+    }
+    else
+    {
+        client->open_orders.fetch_add(1, std::memory_order_relaxed);
+    }
+    return RiskRejectReason::None;
+}
+
+RiskRejectReason PreTradeRisk::checkAmend(uint64_t client_id, const std::string& symbol, OrderSide side, uint32_t new_quantity,
+                                          double new_price, const std::chrono::system_clock::time_point& timestamp)
+{
+    ClientState* client = acquireClient(client_id);
+    if (!client) return RiskRejectReason::TooManyClients;
+    const RiskLimits& limits = limitsOf(*client);
+
+    if (!withinMessageRate(*client, limits, timestamp)) return reject(*client, RiskRejectReason::MessageRate);
+
+    std::unordered_map<std::string, std::unique_ptr<SymbolState>>::const_iterator it = symbols_.find(symbol);
+    if (it == symbols_.end()) return reject(*client, RiskRejectReason::UnknownSymbol);
+    if (!isValidSide(side)) return reject(*client, RiskRejectReason::InvalidSide);
+    if (new_quantity == 0) return reject(*client, RiskRejectReason::InvalidQuantity);
+    if (!std::isfinite(new_price) || new_price <= 0.0) return reject(*client, RiskRejectReason::InvalidPrice);
+
+    // O cancel/replace não muda o número de ordens abertas, só tamanho e preço
+    RiskRejectReason size_result = checkSize(*it->second, limits, new_quantity, new_price);
+    if (size_result != RiskRejectReason::None) return reject(*client, size_result);
+    return RiskRejectReason::None;
+}
+
+RiskRejectReason PreTradeRisk::checkCancel(uint64_t client_id, const std::string& symbol, OrderSide side,
+                                           const std::chrono::system_clock::time_point& timestamp)
+{
+    ClientState* client = acquireClient(client_id);
+    if (!client) return RiskRejectReason::TooManyClients;
+
+    if (!withinMessageRate(*client, limitsOf(*client), timestamp)) return reject(*client, RiskRejectReason::MessageRate);
+    if (symbols_.find(symbol) == symbols_.end()) return reject(*client, RiskRejectReason::UnknownSymbol);
+    if (!isValidSide(side)) return reject(*client, RiskRejectReason::InvalidSide);
+    return RiskRejectReason::None;
+}
+
+void PreTradeRisk::releaseOpenOrder(uint64_t client_id)
+{
+    ClientState* client = acquireClient(client_id);
+    if (!client) return;
+
+    // Só a engine decrementa, então checar antes de subtrair basta para não dar a volta em ordens que não
+    // passaram pelo gateway (ex: benchmarks que entregam comandos direto na engine)
+    if (client->open_orders.load(std::memory_order_relaxed) > 0)
+    {
+        client->open_orders.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+void PreTradeRisk::updateReferencePrice(const std::string& symbol, double price)
+{
+    std::unordered_map<std::string, std::unique_ptr<SymbolState>>::iterator it = symbols_.find(symbol);
+    if (it != symbols_.end())
+    {
+        it->second->reference_price.store(price, std::memory_order_relaxed);
+    }
+}
+
+uint32_t PreTradeRisk::getOpenOrders(uint64_t client_id) const
+{
+    const ClientState* client = findClient(client_id);
+    return client ? client->open_orders.load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t PreTradeRisk::getRejectedCount(uint64_t client_id) const
+{
+    const ClientState* client = findClient(client_id);
+    return client ? client->rejected.load(std::memory_order_relaxed) : 0;
+}
+
+double PreTradeRisk::getReferencePrice(const std::string& symbol) const
+{
+    std::unordered_map<std::string, std::unique_ptr<SymbolState>>::const_iterator it = symbols_.find(symbol);
+    return it == symbols_.end() ? 0.0 : it->second->reference_price.load(std::memory_order_relaxed);
+}
+
+const char* PreTradeRisk::reasonName(RiskRejectReason reason)
+{
+    switch (reason)
+    {
+        case RiskRejectReason::None: return "None";
+        case RiskRejectReason::UnknownSymbol: return "Unknown symbol";
+        case RiskRejectReason::InvalidSide: return "Invalid side";
+        case RiskRejectReason::InvalidQuantity: return "Invalid quantity";
+        case RiskRejectReason::InvalidPrice: return "Invalid price";
+        case RiskRejectReason::MaxOrderQuantity: return "Order quantity above limit";
+        case RiskRejectReason::MaxOrderNotional: return "Order notional above limit";
+        case RiskRejectReason::PriceBand: return "Price outside band around last trade";
+        case RiskRejectReason::MaxOpenOrders: return "Too many open orders";
+        case RiskRejectReason::MessageRate: return "Message rate above limit";
+        case RiskRejectReason::TooManyClients: return "Client table full";
+    }
+    return "Unknown";
+}
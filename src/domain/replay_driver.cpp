@@ -0,0 +1,84 @@
+#include "domain/replay_driver.hpp"
+#include <iostream>
+#include <limits>
+
+ReplayDriver::ReplayDriver(std::ostream* events_out)
+    : event_bus_(event_queue_, market_data_channel_, bbo_queue_),
+      engine_(command_queue_, event_bus_),
+      digest_(events_out)
+{
+    engine_.setVerbose(false);
+}
+
+bool ReplayDriver::open(const std::string& path)
+{
+    if (!reader_.open(path)) return false;
+
+    // Mesma sequência de configuração do binário: relógio e horários antes de criar os livros
+    const command_log::SessionSchedule& schedule = reader_.getSchedule();
+    const std::chrono::system_clock::time_point unset{};
+    if (schedule.timer_start != unset && !engine_.resetTimerClock(schedule.timer_start)) return false;
+    if (schedule.opening_auction != unset) engine_.setOpeningAuction(schedule.opening_auction);
+    if (schedule.session_close != unset) 
+    {
+        engine_.setSessionClose(schedule.session_close);
+        if (schedule.closing_auction != unset && !engine_.setClosingAuction(schedule.closing_auction)) return false;
+    }
+
+    if (!engine_.initialize()) return false;
+    for (const std::string& symbol : reader_.getSymbols())
+    {
+        if (engine_.getOrderBooks().find(symbol) == engine_.getOrderBooks().end() && !engine_.initializeOrderBooks(symbol))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+ReplayReport ReplayDriver::run()
+{
+    ReplayReport report;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::duration engine_time{};
+    std::chrono::system_clock::time_point timer_now;
+
+    while (reader_.nextBatch(batch_, timer_now))
+    {
+        std::chrono::steady_clock::time_point before = std::chrono::steady_clock::now();
+        engine_.processBatch(batch_, timer_now);
+        std::chrono::steady_clock::time_point after = std::chrono::steady_clock::now();
+
+        engine_time += after - before;
+        const uint64_t elapsed_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(after - before).count());
+        for (size_t i = 0; i < batch_.size(); ++i) latency_.record(elapsed_ns);
+
+        report.commands += batch_.size();
+        ++report.batches;
+        collectOutput();
+    }
+
+    report.complete = !reader_.truncated();
+    report.events = digest_.eventCount();
+    report.checksum = digest_.checksum();
+    report.engine_seconds = std::chrono::duration<double>(engine_time).count();
+    report.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+void ReplayDriver::collectOutput()
+{
+    // Prazo já vencido: só retira o que estiver pendente, sem esperar
+    const std::chrono::steady_clock::time_point no_wait{};
+
+    output_.clear();
+    if (!event_queue_.empty()) event_queue_.drain_into(output_, std::numeric_limits<size_t>::max(), no_wait);
+    if (!bbo_queue_.empty()) bbo_queue_.drain_into(output_, std::numeric_limits<size_t>::max(), no_wait);
+    market_data_channel_.wait_for_updates(output_, no_wait);
+
+    for (const Event& event : output_)
+    {
+        digest_.add(event);
+    }
+    output_.clear();
+}
@@ -0,0 +1,108 @@
+#include "domain/shm_ingress_gateway.hpp"
+#include <iostream>
+#include <thread>
+
+ShmIngressGateway::ShmIngressGateway(InboundGateway& gateway)
+    : gateway_(gateway)
+{
+}
+
+bool ShmIngressGateway::addClient(uint64_t client_id, uint32_t capacity)
+{
+    std::unique_ptr<ClientRing> client = std::make_unique<ClientRing>();
+    client->client_id = client_id;
+    if (!client->ring.create(shmIngressSegmentName(client_id), capacity, client_id))
+    {
+        return false;
+    }
+
+    std::cout << "Shared memory ingress ready for client " << client_id << ": " << shmIngressSegmentName(client_id)
+              << " (" << client->ring.capacity() << " slots)\n";
+    clients_.push_back(std::move(client));
+    return true;
+}
+
+void ShmIngressGateway::run()
+{
+    std::cout << "[ShmIngress] Polling " << clients_.size() << " client ring(s)..." << std::endl;
+
+    uint64_t idle_rounds = 0;
+    while (!stop_flag_.load(std::memory_order_relaxed))
+    {
+        size_t received = 0;
+        for (std::unique_ptr<ClientRing>& client : clients_)
+        {
+            received += pollClient(*client);
+        }
+
+        if (!batch_.empty())
+        {
+            commands_queued_.fetch_add(batch_.size(), std::memory_order_relaxed);
+            gateway_.pushBatchToQueue(batch_);
+        }
+
+        if (received == 0) idle(idle_rounds++);
+        else idle_rounds = 0;
+    }
+
+    // Uma última volta: o que os clientes publicaram antes do stop ainda vai para a engine
+    for (std::unique_ptr<ClientRing>& client : clients_)
+    {
+        while (pollClient(*client) != 0) {}
+    }
+    commands_queued_.fetch_add(batch_.size(), std::memory_order_relaxed);
+    gateway_.pushBatchToQueue(batch_);
+    std::cout << "Shared memory ingress has finished polling." << std::endl;
+}
+
+size_t ShmIngressGateway::pollClient(ClientRing& client)
+{
+    size_t count = client.ring.peek(kMaxBatch);
+    if (count == 0) return 0;
+
+    // Todas as mensagens de uma volta compartilham o timestamp de recebimento
+    const std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const ShmOrderMessage& message = client.ring.at(i);
+        if (message.sequence < client.expected_sequence)
+        {
+            duplicates_dropped_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (message.sequence > client.expected_sequence)
+        {
+            std::cerr << "Shared memory ingress: sequence gap from client " << client.client_id << ": expected "
+                      << client.expected_sequence << ", got " << message.sequence << '\n';
+            sequence_gaps_.fetch_add(1, std::memory_order_relaxed);
+        }
+        client.expected_sequence = message.sequence + 1;
+
+        // O comando é montado direto do slot; o slot só volta ao cliente no release abaixo
+        std::unique_ptr<Command> command = gateway_.createCommandFromBinary(message, client.client_id, now);
+        if (command) batch_.push_back(std::move(command));
+    }
+    client.ring.release(count);
+    messages_received_.fetch_add(count, std::memory_order_relaxed);
+    return count;
+}
+
+void ShmIngressGateway::idle(uint64_t idle_rounds) const
+{
+    switch (wait_strategy_.kind)
+    {
+        case WaitStrategy::Kind::BusySpin:
+            WaitStrategy::cpuRelax();
+            break;
+        case WaitStrategy::Kind::Yield:
+            std::this_thread::yield();
+            break;
+        case WaitStrategy::Kind::SpinThenPark:
+            if (idle_rounds < wait_strategy_.spin_iterations) WaitStrategy::cpuRelax();
+            else std::this_thread::sleep_for(kIdleSleep);
+            break;
+        default:
+            std::this_thread::sleep_for(kIdleSleep);
+            break;
+    }
+}
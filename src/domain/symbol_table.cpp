@@ -0,0 +1,32 @@
+#include "domain/symbol_table.hpp"
+#include <iostream>
+
+std::array<std::string, SymbolTable::kMaxSymbols> SymbolTable::names_;
+std::unordered_map<std::string, SymbolId> SymbolTable::ids_;
+std::atomic<size_t> SymbolTable::count_{1};
+std::mutex SymbolTable::mutex_;
+
+SymbolId SymbolTable::intern(const std::string& symbol)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unordered_map<std::string, SymbolId>::iterator it = ids_.find(symbol);
+    if (it != ids_.end()) return it->second;
+
+    const size_t count = count_.load(std::memory_order_relaxed);
+    if (count == kMaxSymbols)
+    {
+        std::cerr << "Symbol table full (" << kMaxSymbols << " symbols): " << symbol << " has no id.\n";
+        return kUnknownSymbol;
+    }
+
+    const SymbolId id = static_cast<SymbolId>(count);
+    names_[id] = symbol;
+    ids_.emplace(symbol, id);
+    count_.store(count + 1, std::memory_order_release);
+    return id;
+}
+
+const std::string& SymbolTable::name(SymbolId id)
+{
+    return id < count_.load(std::memory_order_acquire) ? names_[id] : names_[kUnknownSymbol];
+}
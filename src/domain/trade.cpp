@@ -1,6 +1,12 @@
 #include "domain/trade.hpp"
 
-uint64_t Trade::next_trade_id_ = 1; // Initialize static member
+IdBlockAllocator Trade::id_allocator_;
+
+uint64_t Trade::getNextTradeId()
+{
+    thread_local IdGenerator generator(id_allocator_, IdGenerator::threadShard());
+    return generator.next();
+}
 
 Trade::Trade(uint64_t trade_id, uint64_t agressive_order_id, uint64_t passive_order_id, 
              const std::string& symbol, double price, uint32_t quantity, 
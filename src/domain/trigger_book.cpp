@@ -0,0 +1,212 @@
+#include "domain/trigger_book.hpp"
+#include <algorithm>
+
+bool TriggerBook::addOrder(std::shared_ptr<Order> order, double reference_price)
+{
+    std::pair<std::unordered_map<ClientOrderKey, TriggerLocation, ClientOrderKeyHash>::iterator, bool> index_entry =
+        index_.try_emplace(ClientOrderKey{order->getClientId(), order->getClientOrderId()});
+    if (!index_entry.second) 
+    {
+        return false;
+    }
+
+    TriggerLocation& location = index_entry.first->second;
+    location.order = order;
+    bool is_buy = order->getSide() == OrderSide::Buy;
+
+    if (order->getType() == OrderType::TrailingStop) 
+    {
+        location.kind = Kind::Trailing;
+        if (is_buy) buy_trailing_[order->getTrailingOffset()][reference_price].push_back(order);
+        else sell_trailing_[order->getTrailingOffset()][reference_price].push_back(order);
+        ++live_trailing_;
+    } 
+    else if (is_buy) 
+    {
+        location.kind = Kind::BuyStop;
+        location.buy_stop = buy_stops_.emplace(order->getStopPrice(), order);
+    } 
+    else 
+    {
+        location.kind = Kind::SellStop;
+        location.sell_stop = sell_stops_.emplace(order->getStopPrice(), order);
+    }
+
+    return true;
+}
+
+std::shared_ptr<Order> TriggerBook::removeOrder(uint64_t client_id, uint64_t client_order_id)
+{
+    std::unordered_map<ClientOrderKey, TriggerLocation, ClientOrderKeyHash>::iterator it_index = index_.find(ClientOrderKey{client_id, client_order_id});
+    if (it_index == index_.end()) 
+    {
+        return nullptr;
+    }
+
+    const TriggerLocation& location = it_index->second;
+    std::shared_ptr<Order> order_ptr = location.order;
+    if (location.kind == Kind::BuyStop) 
+    {
+        buy_stops_.erase(location.buy_stop);
+    } 
+    else if (location.kind == Kind::SellStop) 
+    {
+        sell_stops_.erase(location.sell_stop);
+    } 
+    else 
+    {
+        // O nó continua no grupo até disparar ou até a próxima compactação; sem a entrada no índice ele é ignorado
+        --live_trailing_;
+        ++dead_trailing_;
+    }
+
+    index_.erase(it_index);
+    if (dead_trailing_ > live_trailing_) compactTrailing();
+    return order_ptr;
+}
+
+bool TriggerBook::contains(const Order& order) const
+{
+    std::unordered_map<ClientOrderKey, TriggerLocation, ClientOrderKeyHash>::const_iterator it_index =
+        index_.find(ClientOrderKey{order.getClientId(), order.getClientOrderId()});
+    return it_index != index_.end() && it_index->second.order.get() == &order;
+}
+
+bool TriggerBook::contains(uint64_t client_id, uint64_t client_order_id) const
+{
+    return index_.find(ClientOrderKey{client_id, client_order_id}) != index_.end();
+}
+
+void TriggerBook::collectTriggered(double low, double high, double last, std::vector<std::shared_ptr<Order>>& triggered)
+{
+    size_t first = triggered.size();
+
+    // Stops de compra disparam quando o mercado sobe até o StopPx; os de venda quando cai até ele
+    BuyStops::iterator buy_end = buy_stops_.upper_bound(high);
+    for (BuyStops::iterator it = buy_stops_.begin(); it != buy_end; ++it) 
+    {
+        index_.erase(ClientOrderKey{it->second->getClientId(), it->second->getClientOrderId()});
+        triggered.push_back(std::move(it->second));
+    }
+    buy_stops_.erase(buy_stops_.begin(), buy_end);
+
+    SellStops::iterator sell_end = sell_stops_.upper_bound(low);
+    for (SellStops::iterator it = sell_stops_.begin(); it != sell_end; ++it) 
+    {
+        index_.erase(ClientOrderKey{it->second->getClientId(), it->second->getClientOrderId()});
+        triggered.push_back(std::move(it->second));
+    }
+    sell_stops_.erase(sell_stops_.begin(), sell_end);
+
+    // Trailing de venda: todo grupo com máximo abaixo de 'high' passa a ter 'high' como máximo (um splice por
+    // grupo). Depois disparam os grupos com máximo - distância >= last, que estão no início do mapa.
+    for (std::map<double, SellTrailing>::iterator entry = sell_trailing_.begin(); entry != sell_trailing_.end(); ) 
+    {
+        const double offset = entry->first;
+        SellTrailing& groups = entry->second;
+
+        dragGroups(groups, high);
+
+        SellTrailing::iterator fired_end = groups.begin();
+        while (fired_end != groups.end() && fired_end->first - offset >= last) ++fired_end;
+        for (SellTrailing::iterator it = groups.begin(); it != fired_end; ++it) 
+        {
+            for (std::shared_ptr<Order>& order : it->second) 
+            {
+                if (releaseTrailing(order)) triggered.push_back(std::move(order));
+            }
+        }
+        groups.erase(groups.begin(), fired_end);
+        entry = groups.empty() ? sell_trailing_.erase(entry) : std::next(entry);
+    }
+
+    // Trailing de compra: o espelho, com o mínimo negociado e disparo quando mínimo + distância <= last
+    for (std::map<double, BuyTrailing>::iterator entry = buy_trailing_.begin(); entry != buy_trailing_.end(); ) 
+    {
+        const double offset = entry->first;
+        BuyTrailing& groups = entry->second;
+
+        dragGroups(groups, low);
+
+        BuyTrailing::iterator fired_end = groups.begin();
+        while (fired_end != groups.end() && fired_end->first + offset <= last) ++fired_end;
+        for (BuyTrailing::iterator it = groups.begin(); it != fired_end; ++it) 
+        {
+            for (std::shared_ptr<Order>& order : it->second) 
+            {
+                if (releaseTrailing(order)) triggered.push_back(std::move(order));
+            }
+        }
+        groups.erase(groups.begin(), fired_end);
+        entry = groups.empty() ? buy_trailing_.erase(entry) : std::next(entry);
+    }
+
+    // Ordem de reentrada determinística: por chegada, independente do tipo e do lado do stop
+    std::sort(triggered.begin() + first, triggered.end(),
+              [](const std::shared_ptr<Order>& a, const std::shared_ptr<Order>& b) { return a->getOrderId() < b->getOrderId(); });
+}
+
+template<typename Groups>
+void TriggerBook::dragGroups(Groups& groups, double extreme)
+{
+    // Grupos que ficaram para trás do novo extremo estão no fim do mapa
+    typename Groups::iterator behind = groups.upper_bound(extreme);
+    if (behind == groups.end()) return;
+
+    typename Groups::iterator target = groups.end();
+    if (behind != groups.begin() && std::prev(behind)->first == extreme) 
+    {
+        target = std::prev(behind);
+    } 
+    else 
+    {
+        // Reaproveita o nó do primeiro grupo ultrapassado como o grupo do novo extremo, sem alocar
+        typename Groups::node_type node = groups.extract(behind++);
+        node.key() = extreme;
+        target = groups.insert(std::move(node)).position;
+    }
+
+    for (typename Groups::iterator it = behind; it != groups.end(); ++it) target->second.splice(target->second.end(), it->second);
+    groups.erase(behind, groups.end());
+}
+
+bool TriggerBook::releaseTrailing(const std::shared_ptr<Order>& order)
+{
+    std::unordered_map<ClientOrderKey, TriggerLocation, ClientOrderKeyHash>::iterator it_index =
+        index_.find(ClientOrderKey{order->getClientId(), order->getClientOrderId()});
+    if (it_index == index_.end() || it_index->second.order != order) 
+    {
+        --dead_trailing_;
+        return false;
+    }
+
+    index_.erase(it_index);
+    --live_trailing_;
+    return true;
+}
+
+template<typename Groups>
+void TriggerBook::compactGroups(std::map<double, Groups>& by_offset)
+{
+    for (typename std::map<double, Groups>::iterator entry = by_offset.begin(); entry != by_offset.end(); ) 
+    {
+        Groups& groups = entry->second;
+        for (typename Groups::iterator group = groups.begin(); group != groups.end(); ) 
+        {
+            group->second.remove_if([this](const std::shared_ptr<Order>& order) {
+                std::unordered_map<ClientOrderKey, TriggerLocation, ClientOrderKeyHash>::const_iterator it_index =
+                    index_.find(ClientOrderKey{order->getClientId(), order->getClientOrderId()});
+                return it_index == index_.end() || it_index->second.order != order;
+            });
+            group = group->second.empty() ? groups.erase(group) : std::next(group);
+        }
+        entry = groups.empty() ? by_offset.erase(entry) : std::next(entry);
+    }
+}
+
+void TriggerBook::compactTrailing()
+{
+    compactGroups(sell_trailing_);
+    compactGroups(buy_trailing_);
+    dead_trailing_ = 0;
+}
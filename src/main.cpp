@@ -5,6 +5,7 @@
 #include "utils/thread_safe_queue.hpp" 
 #include "domain/inbound_gateway.hpp"
 #include "domain/market_data_gateway.hpp"
+#include "domain/bbo_gateway.hpp"
 #include "domain/auditor.hpp"
 #include "utils/fix_generator.hpp"
 #include "utils/timestamp_formatter.hpp"
@@ -14,103 +15,458 @@
 #include "domain/event_bus_dispatcher.hpp"
 #include <iomanip>
 #include "domain/order.hpp"
+#include "domain/trade.hpp"
 #include <vector>
 #include <random>
 #include <fstream>
 #include <sstream>
+#include <string>
+#include "utils/load_generator.hpp"
+#include "utils/latency_histogram.hpp"
+#include "utils/runtime_config.hpp"
+#include "utils/thread_utils.hpp"
+#include "utils/memory_arena.hpp"
+#include "domain/pre_trade_risk.hpp"
+#include "domain/fix_tcp_acceptor.hpp"
+#include "domain/shm_ingress_gateway.hpp"
+#include "domain/multicast_market_data_publisher.hpp"
+#include "domain/execution_report_gateway.hpp"
+#include "domain/replay_driver.hpp"
+#include "messaging/command_log.hpp"
+#include "client/market_data_subscriber.hpp"
 
-// Função que cada thread vai executar
-void fix_producer(InboundGateway& gateway, int thread_id, ThreadSafeQueue<std::unique_ptr<Command>>& queue) 
+void printLoadReport(const LoadGeneratorReport& report, const LatencyHistogram& latency, double drain_seconds)
 {
-    static thread_local std::random_device rd;
-    static thread_local std::mt19937 gen(rd());
-    static thread_local std::uniform_real_distribution<float> dis(0.1, 1.0);
-    static thread_local int counter = 0;
-
-    try 
-    {
-        while (counter < 5) 
-        {   
-            auto [fixMessage, receivedFixTime] = FixGenerator::generateFIXMessageForThread();
-            std::unique_ptr<Command> commandPtr = gateway.parseAndCreateCommand(fixMessage, std::to_string(thread_id), receivedFixTime);
-
-            if (!commandPtr) 
-            {
-                std::cerr << "Failed to create command from FIX message in thread " << thread_id << ".\n";
-                continue;
-            }
-
-            counter++;
-            gateway.pushToQueue(std::move(commandPtr));
-            double sleep_time = dis(gen);
-            std::this_thread::sleep_for(std::chrono::duration<double>(sleep_time));
-        }
+    double sent_rate = report.messages_sent / report.elapsed_seconds;
+    double processed_rate = latency.count() / drain_seconds;
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "\n===== Load generator report =====\n"
+              << "Messages sent:        " << report.messages_sent << " (new: " << report.new_orders << ", cancel: " << report.cancels
+              << ", amend: " << report.amends << ", rejected at gateway: " << report.messages_rejected << ")\n"
+              << "Send window:          " << report.elapsed_seconds << " s, achieved " << sent_rate << " msg/s\n"
+              << "Engine drained after: " << drain_seconds << " s, processed " << processed_rate << " cmd/s\n"
+              << "Max send lag:         " << report.max_send_lag_ns / 1000.0 << " us\n"
+              << "Latency (intended send -> engine done, coordinated-omission corrected):\n"
+              << "  p50 " << latency.percentile(50) / 1000.0 << " us | p90 " << latency.percentile(90) / 1000.0
+              << " us | p99 " << latency.percentile(99) / 1000.0 << " us | p99.9 " << latency.percentile(99.9) / 1000.0
+              << " us | max " << latency.max() / 1000.0 << " us\n";
+}
+
+// Lê os limites de risco '<prefix>.*'; chaves ausentes ficam com o valor de 'fallback'
+RiskLimits loadRiskLimits(const RuntimeConfig& config, const std::string& prefix, const RiskLimits& fallback)
+{
+    RiskLimits limits;
+    limits.max_order_quantity = static_cast<uint32_t>(config.getInt(prefix + ".max_order_qty", fallback.max_order_quantity));
+    limits.max_order_notional = static_cast<double>(config.getInt(prefix + ".max_order_notional", static_cast<int64_t>(fallback.max_order_notional)));
+    limits.max_open_orders = static_cast<uint32_t>(config.getInt(prefix + ".max_open_orders", fallback.max_open_orders));
+    limits.max_messages_per_second = static_cast<uint32_t>(config.getInt(prefix + ".max_msgs_per_sec", fallback.max_messages_per_second));
+    limits.price_band_bps = static_cast<uint32_t>(config.getInt(prefix + ".price_band_bps", fallback.price_band_bps));
+    return limits;
+}
+
+// Endereços do feed multicast em 'market_data.*'; os mesmos valores servem ao publicador e ao assinante
+MulticastFeedOptions loadFeedOptions(const RuntimeConfig& config)
+{
+    MulticastFeedOptions options;
+    options.group = config.getString("market_data.group", options.group);
+    options.port = static_cast<uint16_t>(config.getInt("market_data.port", options.port));
+    options.snapshot_group = config.getString("market_data.snapshot_group", options.group);
+    options.snapshot_port = static_cast<uint16_t>(config.getInt("market_data.snapshot_port", options.snapshot_port));
+    options.interface_address = config.getString("market_data.interface", options.interface_address);
+    options.ttl = static_cast<int>(config.getInt("market_data.ttl", options.ttl));
+    options.snapshot_interval_ms = static_cast<uint32_t>(config.getInt("market_data.snapshot_interval_ms", options.snapshot_interval_ms));
+    return options;
+}
+
+// Assinante de referência (--md-subscribe): acompanha o feed de outro processo por --duration segundos e imprime
+// sincronização, saltos e a latência publicação -> recebimento
+int runMarketDataSubscriber(int argc, char** argv, const RuntimeConfig& config)
+{
+    double duration_seconds = 10.0;
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--duration=", 0) == 0) duration_seconds = std::stod(arg.substr(11));
     }
-    catch (const std::exception& ex) 
+
+    MarketDataSubscriber subscriber(loadFeedOptions(config));
+    if (!subscriber.open())
     {
-        std::cerr << "Exception in thread " << thread_id << ": " << ex.what() << '\n';
+        return 1;
+    }
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(duration_seconds));
+    while (std::chrono::steady_clock::now() < end)
+    {
+        if (subscriber.poll(100) < 0) return 1;
+    }
+
+    const LatencyHistogram& latency = subscriber.getLatency();
+    std::cout << std::fixed << std::setprecision(1)
+              << "\n===== Market data subscriber report =====\n"
+              << "Packets received:     " << subscriber.packetsReceived() << " (duplicates: " << subscriber.duplicatePackets()
+              << ", malformed: " << subscriber.malformedPackets() << ")\n"
+              << "Updates applied:      " << subscriber.updatesApplied() << ", next sequence " << subscriber.getExpectedSequence() << '\n'
+              << "Gaps detected:        " << subscriber.gapsDetected() << ", snapshot recoveries " << subscriber.recoveries()
+              << (subscriber.isSynchronized() ? " (in sync)" : " (out of sync)") << '\n'
+              << "Latency (publish -> receive):\n"
+              << "  p50 " << latency.percentile(50) / 1000.0 << " us | p99 " << latency.percentile(99) / 1000.0
+              << " us | max " << latency.max() / 1000.0 << " us\n";
+    return 0;
+}
+
+// Reexecução de um registro de comandos (--replay=FILE, gravado com engine.record): roda o registro numa engine
+// própria o mais rápido possível e imprime vazão, latência por comando e o checksum da saída. Com
+// --events-out=FILE grava também a codificação canônica dos eventos, para comparar duas execuções com cmp.
+int runReplay(int argc, char** argv)
+{
+    std::string replayPath;
+    std::string eventsPath;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--replay=", 0) == 0) replayPath = arg.substr(9);
+        else if (arg.rfind("--events-out=", 0) == 0) eventsPath = arg.substr(13);
+    }
+    if (replayPath.empty())
+    {
+        std::cerr << "Usage: orderbook --replay=FILE [--events-out=FILE]\n";
+        return 1;
+    }
+
+    std::ofstream eventsOut;
+    if (!eventsPath.empty())
+    {
+        eventsOut.open(eventsPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!eventsOut.is_open())
+        {
+            std::cerr << "Failed to open events output file: " << eventsPath << "\n";
+            return 1;
+        }
     }
-    catch (...) 
+
+    ReplayDriver driver(eventsOut.is_open() ? &eventsOut : nullptr);
+    if (!driver.open(replayPath))
     {
-        std::cerr << "Unknown exception in thread " << thread_id << ".\n";
+        return 1;
     }
+    ReplayReport report = driver.run();
+
+    const LatencyHistogram& latency = driver.getLatency();
+    std::cout << std::fixed << std::setprecision(1)
+              << "\n===== Replay report =====\n"
+              << "Commands replayed:    " << report.commands << " in " << report.batches << " batches"
+              << (report.complete ? "" : " (log truncated, stopped at the last complete batch)") << '\n'
+              << "Engine time:          " << std::setprecision(3) << report.engine_seconds << " s, " << std::setprecision(1) << (report.engine_seconds > 0 ? report.commands / report.engine_seconds : 0.0)
+              << " cmd/s (wall " << std::setprecision(3) << report.wall_seconds << std::setprecision(1) << " s with log reading and digest)\n"
+              << "Latency (batch start -> batch published, per command):\n"
+              << "  p50 " << latency.percentile(50) / 1000.0 << " us | p90 " << latency.percentile(90) / 1000.0
+              << " us | p99 " << latency.percentile(99) / 1000.0 << " us | p99.9 " << latency.percentile(99.9) / 1000.0
+              << " us | max " << latency.max() / 1000.0 << " us\n"
+              << "Events:               " << report.events << ", checksum " << std::hex << std::setw(16) << std::setfill('0')
+              << report.checksum << std::dec << std::setfill(' ') << '\n';
+    return report.complete ? 0 : 1;
 }
 
-int main() {
+int main(int argc, char** argv) {
 
-    ThreadSafeQueue<std::unique_ptr<Command>> commandQueue;
-    ThreadSafeQueue<std::shared_ptr<const Event>> eventQueue;
+    // Sem argumentos roda a simulação de demonstração: 2 clientes, ~5 ordens cada, com logs detalhados.
+    // Com --load roda o gerador de carga open-loop configurável e imprime throughput/latência no final.
+    // Com --md-subscribe só assina o feed multicast de market data publicado por outra instância.
+    bool load_mode = argc > 1 && std::string(argv[1]) == "--load";
+    LoadGeneratorConfig loadConfig;
+    if (load_mode)
+    {
+        if (!LoadGeneratorConfig::fromArgs(argc, argv, loadConfig))
+        {
+            LoadGeneratorConfig::printUsage();
+            return 1;
+        }
+    }
+    else
+    {
+        loadConfig.threads = 2;
+        loadConfig.target_rate = 4.0;
+        loadConfig.duration_seconds = 2.5;
+        loadConfig.symbols = {"GOOG"};
+        loadConfig.price_distribution = LoadGeneratorConfig::PriceDistribution::Uniform;
+        loadConfig.price_mid = 10.025;
+        loadConfig.price_width = 0.025;
+    }
+
+    // Afinidade, estratégias de espera e knobs da engine vêm do arquivo de runtime (--config=FILE ou ORDERBOOK_CONFIG)
+    RuntimeConfig runtimeConfig;
+    std::string configPath = RuntimeConfig::resolvePath(argc, argv);
+    if (!configPath.empty() && !runtimeConfig.loadFile(configPath))
+    {
+        return 1;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--md-subscribe")
+    {
+        return runMarketDataSubscriber(argc, argv, runtimeConfig);
+    }
+    // Antes dos checkpoints de id: a reexecução numera ordens e trades a partir de 1, sempre do mesmo jeito
+    if (argc > 1 && std::string(argv[1]).rfind("--replay=", 0) == 0)
+    {
+        return runReplay(argc, argv);
+    }
+
+    // Os contadores de id sobrevivem a restarts: cada bloco de ids reservado é persistido antes de ser usado
+    if (!Order::getIdAllocator().setCheckpointFile("src/logs/order_ids.checkpoint") ||
+        !Trade::getIdAllocator().setCheckpointFile("src/logs/trade_ids.checkpoint"))
+    {
+        return 1;
+    }
+
+    std::vector<int> engineCpus = runtimeConfig.getCpuList("engine.cpus");
+    std::vector<int> auditorCpus = runtimeConfig.getCpuList("auditor.cpus");
+
+    // Arenas reservadas e pré-carregadas antes de qualquer thread começar: livros e fila de comandos ficam no nó
+    // NUMA da engine, fila de eventos e journal no nó do auditor. Declaradas antes dos donos para viverem mais.
+    MemoryArena bookArena(runtimeConfig.getArenaOptions("book", 64 * 1024, engineCpus));
+    MemoryArena commandQueueArena(runtimeConfig.getArenaOptions("command_queue", 8 * 1024, engineCpus));
+    MemoryArena eventQueueArena(runtimeConfig.getArenaOptions("event_queue", 8 * 1024, auditorCpus));
+    MemoryArena journalArena(runtimeConfig.getArenaOptions("journal", 1024, auditorCpus));
+
+    ThreadSafeQueue<std::unique_ptr<Command>> commandQueue(commandQueueArena.isMapped() ? &commandQueueArena : nullptr);
+    ThreadSafeQueue<Event> eventQueue(eventQueueArena.isMapped() ? &eventQueueArena : nullptr);
+    commandQueue.setWaitStrategy(runtimeConfig.getWaitStrategy("command_queue"));
+    eventQueue.setWaitStrategy(runtimeConfig.getWaitStrategy("event_queue"));
+
+    // Risco pré-trade nas threads dos clientes: limites padrão em 'risk.*' e, para os clientes listados em
+    // risk.clients, sobrescritas em 'risk.client.<id>.*'. Os símbolos são registrados pela engine ao criar os livros.
+    PreTradeRisk preTradeRisk(loadRiskLimits(runtimeConfig, "risk", RiskLimits{}));
+    for (uint64_t riskClient : runtimeConfig.getIdList("risk.clients"))
+    {
+        preTradeRisk.setClientLimits(riskClient, loadRiskLimits(runtimeConfig, "risk.client." + std::to_string(riskClient), preTradeRisk.getDefaultLimits()));
+    }
 
     InboundGateway inboundGateway(commandQueue);
+    inboundGateway.setPreTradeRisk(&preTradeRisk);
 
     Auditor auditor(eventQueue);
+    if (journalArena.isMapped())
+    {
+        auditor.setJournalBuffer(static_cast<char*>(journalArena.allocate(journalArena.capacity())), journalArena.capacity());
+    }
     auditor.initialize();
 
     MarketDataChannel marketDataChannel;
-    EventBusDispatcher eventBus(eventQueue, marketDataChannel);
+    marketDataChannel.setWaitStrategy(runtimeConfig.getWaitStrategy("market_data"));
+
+    // O BBO tem fila e thread próprias: um consumidor de profundidade lento não atrasa o topo do livro
+    ThreadSafeQueue<Event> bboQueue;
+    bboQueue.setWaitStrategy(runtimeConfig.getWaitStrategy("bbo_queue"));
+    EventBusDispatcher eventBus(eventQueue, marketDataChannel, bboQueue);
 
     MarketDataGateway marketDataGateway(marketDataChannel);
     marketDataGateway.initialize();
 
+    // Feed binário por UDP multicast (market_data.multicast=true), publicado pela thread de market data
+    MulticastMarketDataPublisher marketDataPublisher(loadFeedOptions(runtimeConfig));
+    if (runtimeConfig.getBool("market_data.multicast", false) && marketDataPublisher.open())
+    {
+        marketDataGateway.setMulticastPublisher(&marketDataPublisher);
+    }
+
+    BboGateway bboGateway(bboQueue);
+    bboGateway.initialize();
+
+    // Execution reports (35=8) para as sessões FIX por TCP e, com exec_reports.drop_copy, para um arquivo com
+    // todos os reports; recebem uma cópia dos eventos transacionais numa fila própria
+    ExecutionReportOptions reportOptions;
+    reportOptions.sender_comp_id = runtimeConfig.getString("exec_reports.sender_comp_id", reportOptions.sender_comp_id);
+    reportOptions.session_queue_bytes = static_cast<size_t>(runtimeConfig.getInt("exec_reports.queue_kb", 256)) * 1024;
+    reportOptions.drop_copy_path = runtimeConfig.getString("exec_reports.drop_copy", "");
+    ThreadSafeQueue<Event> reportQueue;
+    reportQueue.setWaitStrategy(runtimeConfig.getWaitStrategy("exec_reports"));
+    ExecutionReportGateway reportGateway(reportQueue, reportOptions);
+    bool reportsEnabled = runtimeConfig.getInt("fix_acceptor.port", 0) > 0 || !reportOptions.drop_copy_path.empty();
+    if (reportsEnabled && reportGateway.initialize())
+    {
+        eventBus.setExecutionReportQueue(&reportQueue);
+    }
+    else
+    {
+        reportsEnabled = false;
+    }
+    // Rejeições do risco pré-trade respondem ao cliente e ficam no log de auditoria, como as da engine
+    inboundGateway.setRejectQueues(&eventQueue, reportsEnabled ? &reportQueue : nullptr);
+
 	Engine engine(commandQueue, eventBus);
+    engine.setBookArena(bookArena.isMapped() ? &bookArena : nullptr);
+    engine.setDepthPrefixLevels(static_cast<size_t>(runtimeConfig.getInt("engine.depth_prefix_levels", 0)));
+    engine.setLevelPoolCapacity(static_cast<size_t>(runtimeConfig.getInt("engine.level_pool", static_cast<int64_t>(OrderBook::kDefaultLevelPoolCapacity))));
+    if (!engine.setIdShard(static_cast<uint32_t>(runtimeConfig.getInt("engine.id_shard", 0))))
+    {
+        return 1;
+    }
+    engine.setMaxBatchSize(static_cast<size_t>(runtimeConfig.getInt("engine.max_batch", 64)));
+    engine.setPreTradeRisk(&preTradeRisk);
+
+    // Sessão relativa ao início do processo: leilão de abertura até opening_auction_ms, fechamento em
+    // session_close_ms com os últimos closing_auction_ms em leilão
+    std::chrono::system_clock::time_point sessionStart = std::chrono::system_clock::now();
+    int64_t openingAuctionMs = runtimeConfig.getInt("engine.opening_auction_ms", 0);
+    int64_t sessionCloseMs = runtimeConfig.getInt("engine.session_close_ms", 0);
+    int64_t closingAuctionMs = runtimeConfig.getInt("engine.closing_auction_ms", 0);
+    if (openingAuctionMs > 0)
+    {
+        engine.setOpeningAuction(sessionStart + std::chrono::milliseconds(openingAuctionMs));
+    }
+    if (sessionCloseMs > 0)
+    {
+        engine.setSessionClose(sessionStart + std::chrono::milliseconds(sessionCloseMs));
+        if (closingAuctionMs > 0)
+        {
+            engine.setClosingAuction(sessionStart + std::chrono::milliseconds(sessionCloseMs - closingAuctionMs));
+        }
+    }
     engine.initialize();
 
+    // Símbolos pedidos pelo gerador de carga que não fazem parte do universo padrão ganham um livro próprio
+    for (const std::string& symbol : loadConfig.symbols)
+    {
+        if (engine.getOrderBooks().find(symbol) == engine.getOrderBooks().end())
+        {
+            engine.initializeOrderBooks(symbol);
+        }
+    }
+
+    // engine.record=FILE grava o fluxo de comandos consumido pela engine para reexecução com --replay
+    CommandRecorder commandRecorder;
+    std::string recordPath = runtimeConfig.getString("engine.record", "");
+    if (!recordPath.empty())
+    {
+        std::vector<std::string> bookSymbols;
+        for (const std::pair<const std::string, std::unique_ptr<OrderBook>>& entry : engine.getOrderBooks())
+        {
+            bookSymbols.push_back(entry.first);
+        }
+        command_log::SessionSchedule schedule;
+        if (openingAuctionMs > 0) schedule.opening_auction = sessionStart + std::chrono::milliseconds(openingAuctionMs);
+        if (sessionCloseMs > 0) schedule.session_close = sessionStart + std::chrono::milliseconds(sessionCloseMs);
+        if (sessionCloseMs > 0 && closingAuctionMs > 0) schedule.closing_auction = sessionStart + std::chrono::milliseconds(sessionCloseMs - closingAuctionMs);
+        schedule.timer_start = engine.getTimerClock();
+        if (commandRecorder.open(recordPath, bookSymbols, schedule))
+        {
+            engine.setCommandRecorder(&commandRecorder);
+        }
+    }
+
+    LatencyHistogram latencyHistogram;
+    engine.setLatencyHistogram(&latencyHistogram);
+    engine.setVerbose(!load_mode);
+
     // A thread do auditor vai ficar rodando em segundo plano, consumindo os eventos da fila e logando-os
-    std::thread auditorThread(&Auditor::run, &auditor);
+    // Cada thread se nomeia e se fixa nas CPUs do seu papel antes de entrar no loop
+    std::thread auditorThread([&auditor, auditorCpus]() {
+        thread_utils::applyThreadRole("auditor", auditorCpus);
+        auditor.run();
+    });
 
     // A engine vai processar os comandos e executar as ações necessárias e para isso criamos uma thread que chama o método run()
 	// A thread vai ficar rodando em segundo plano, consumindo os comandos da fila e executando-os
-	std::thread engineThread(&Engine::run, &engine);  
+	std::thread engineThread([&engine, engineCpus]() {
+        thread_utils::applyThreadRole("engine", engineCpus);
+        engine.run();
+    });
 
-    std::thread marketDataGatewayThread(&MarketDataGateway::run, &marketDataGateway);
-    
-    int clientNumber = 2;
-    std::vector<std::thread> clients;
-    for (int i = 0; i < clientNumber; ++i) 
-	{
-		std::cout << "Starting Client " << i << "...\n";
+    std::vector<int> marketDataCpus = runtimeConfig.getCpuList("market_data.cpus");
+    std::thread marketDataGatewayThread([&marketDataGateway, marketDataCpus]() {
+        thread_utils::applyThreadRole("market-data", marketDataCpus);
+        marketDataGateway.run();
+    });
 
-		// Pra cada thread, a função fix_producer é passada como callback e tanto a fila quando o id são passados como argumento
-		// É equivalente a, dentro da thread, chamar:
-		// std::thread t(fix_producer, std::ref(inboundGateway), i, std::ref(commandQueue));
-		// fix_producer(inboundGateway, i, std::ref(commandQueue));
+    std::vector<int> bboCpus = runtimeConfig.getCpuList("bbo.cpus");
+    std::thread bboGatewayThread([&bboGateway, bboCpus]() {
+        thread_utils::applyThreadRole("bbo", bboCpus);
+        bboGateway.run();
+    });
 
-		// Depois do emplace_back a thread já começa a rodar, ou seja, a função fix_producer já está sendo executada
-        clients.emplace_back(fix_producer, std::ref(inboundGateway), i, std::ref(commandQueue));
+    std::thread reportGatewayThread;
+    if (reportsEnabled)
+    {
+        std::vector<int> reportCpus = runtimeConfig.getCpuList("exec_reports.cpus");
+        reportGatewayThread = std::thread([&reportGateway, reportCpus]() {
+            thread_utils::applyThreadRole("exec-reports", reportCpus);
+            reportGateway.run();
+        });
+    }
+    
+    // Sessões FIX reais por TCP (fix_acceptor.port > 0) entram pelo mesmo gateway, em paralelo aos clientes simulados,
+    // enquanto o gerador estiver rodando
+    std::unique_ptr<FixTcpAcceptor> fixAcceptor;
+    if (runtimeConfig.getInt("fix_acceptor.port", 0) > 0)
+    {
+        FixAcceptorOptions fixOptions;
+        fixOptions.bind_address = runtimeConfig.getString("fix_acceptor.bind", fixOptions.bind_address);
+        fixOptions.port = static_cast<uint16_t>(runtimeConfig.getInt("fix_acceptor.port", 0));
+        fixOptions.io_threads = static_cast<int>(runtimeConfig.getInt("fix_acceptor.io_threads", fixOptions.io_threads));
+        fixOptions.read_buffer_bytes = static_cast<size_t>(runtimeConfig.getInt("fix_acceptor.read_buffer_kb", 64)) * 1024;
+        fixOptions.cpus = runtimeConfig.getCpuList("fix_acceptor.cpus");
+        fixAcceptor = std::make_unique<FixTcpAcceptor>(inboundGateway, fixOptions);
+        if (reportsEnabled)
+        {
+            fixAcceptor->setSessionHooks([&reportGateway](uint64_t clientId, int fd) { reportGateway.attachSession(clientId, fd); },
+                                         [&reportGateway](uint64_t clientId) { reportGateway.detachSession(clientId); });
+        }
+        if (!fixAcceptor->start())
+        {
+            fixAcceptor.reset();
+        }
     }
 
-    // Serve para que a thread principal (main) aguarde o término de todas as threads de clientes criadas
-	// Isso é importante para evitar que o programa termine antes das threads concluírem suas execuções
-    for (std::thread& t : clients) 
-	{
-        t.join();
+    // Clientes co-located (shm_ingress.clients) escrevem ordens binárias em memória compartilhada; uma thread
+    // faz polling dos rings enquanto o gerador estiver rodando
+    ShmIngressGateway shmIngress(inboundGateway);
+    std::thread shmIngressThread;
+    std::vector<uint64_t> shmClients = runtimeConfig.getIdList("shm_ingress.clients");
+    for (uint64_t shmClient : shmClients)
+    {
+        shmIngress.addClient(shmClient, static_cast<uint32_t>(runtimeConfig.getInt("shm_ingress.capacity", 4096)));
     }
-    
+    if (!shmClients.empty())
+    {
+        shmIngress.setWaitStrategy(runtimeConfig.getWaitStrategy("shm_ingress"));
+        std::vector<int> shmIngressCpus = runtimeConfig.getCpuList("shm_ingress.cpus");
+        shmIngressThread = std::thread([&shmIngress, shmIngressCpus]() {
+            thread_utils::applyThreadRole("shm-ingress", shmIngressCpus);
+            shmIngress.run();
+        });
+    }
+
+    // Cada thread do gerador simula um cliente FIX; o gerador bloqueia até todas terminarem de enviar
+    LoadGenerator loadGenerator(inboundGateway, loadConfig);
+    std::vector<int> gatewayCpus = runtimeConfig.getCpuList("gateway.cpus");
+    loadGenerator.setThreadStartHook([gatewayCpus](int thread_id) {
+        thread_utils::applyThreadRole("client-" + std::to_string(thread_id), gatewayCpus);
+    });
+    std::chrono::steady_clock::time_point loadStart = std::chrono::steady_clock::now();
+    LoadGeneratorReport loadReport = loadGenerator.run();
+
     // Se thread da main chegou aqui, os clientes ja pararam de produzir e ta na hora de desligar a fila
+    if (shmIngressThread.joinable())
+    {
+        shmIngress.stop();
+        shmIngressThread.join();
+        std::cout << "Shared memory ingress: " << shmIngress.messagesReceived() << " messages, " << shmIngress.commandsQueued() << " commands queued, "
+                  << shmIngress.sequenceGaps() << " sequence gaps, " << shmIngress.duplicatesDropped() << " duplicates\n";
+    }
+    if (fixAcceptor)
+    {
+        fixAcceptor->stop();
+        std::cout << "FIX acceptor: " << fixAcceptor->sessionsAccepted() << " sessions, " << fixAcceptor->messagesReceived() << " messages, "
+                  << fixAcceptor->commandsQueued() << " commands queued, " << fixAcceptor->sequenceGaps() << " sequence gaps, "
+                  << fixAcceptor->duplicatesDropped() << " duplicates, " << fixAcceptor->framingErrors() << " framing errors\n";
+    }
     commandQueue.shutdown(); 
 
     // Garante que a main espere a engine terminar de consumir os comandos da queue
     engineThread.join(); 
+    double drainSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - loadStart).count();
 
     // Agora que a engine terminou, podemos desligar a fila de eventos e esperar o auditor terminar
     eventQueue.shutdown();
@@ -118,9 +474,49 @@ int main() {
 
     marketDataChannel.shutdown();
     marketDataGatewayThread.join();
+    if (marketDataPublisher.isOpen())
+    {
+        std::cout << "Multicast market data: " << marketDataPublisher.updatesPublished() << " level updates in " << marketDataPublisher.packetsSent()
+                  << " packets, " << marketDataPublisher.snapshotPacketsSent() << " snapshot packets, " << marketDataPublisher.sendErrors() << " send errors\n";
+    }
+
+    bboQueue.shutdown();
+    bboGatewayThread.join();
+
+    if (reportGatewayThread.joinable())
+    {
+        reportQueue.shutdown();
+        reportGatewayThread.join();
+        std::cout << "Execution reports: " << reportGateway.reportsRendered() << " rendered, " << reportGateway.bytesSent() << " bytes sent, "
+                  << reportGateway.unroutedReports() << " without a session, " << reportGateway.slowConsumerDisconnects() << " slow consumer disconnects\n";
+    }
 
     //engine.printOrderBooks();
 
+    if (commandRecorder.isOpen())
+    {
+        commandRecorder.close();
+        std::cout << "Command log: " << commandRecorder.commandsRecorded() << " commands in " << commandRecorder.batchesRecorded()
+                  << " batches recorded to " << recordPath << "\n";
+    }
+
+    if (load_mode)
+    {
+        uint64_t levelCreations = 0;
+        uint64_t levelReuses = 0;
+        for (const std::pair<const std::string, std::unique_ptr<OrderBook>>& entry : engine.getOrderBooks())
+        {
+            levelCreations += entry.second->getLevelCreations();
+            levelReuses += entry.second->getLevelReuses();
+        }
+        std::cout << "Price levels: " << levelCreations << " created, " << levelReuses << " reused from the free lists\n";
+    }
+
+    if (load_mode)
+    {
+        printLoadReport(loadReport, latencyHistogram, drainSeconds);
+    }
+
     std::cout << "All threads have finished execution.\n";
     return 0;
 }
@@ -0,0 +1,253 @@
+#include "messaging/command_log.hpp"
+#include "messaging/commands/new_order_command.hpp"
+#include "messaging/commands/cancel_order_command.hpp"
+#include "messaging/commands/amend_order_command.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+
+int64_t toNanoseconds(const std::chrono::system_clock::time_point& time_point)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time_point.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point fromNanoseconds(int64_t nanoseconds)
+{
+    return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanoseconds)));
+}
+
+void copySymbol(char (&out)[command_log::kSymbolBytes], const std::string& symbol)
+{
+    std::memset(out, 0, sizeof(out));
+    std::memcpy(out, symbol.data(), std::min(symbol.size(), sizeof(out) - 1));
+}
+
+std::string readSymbol(const char (&in)[command_log::kSymbolBytes])
+{
+    return std::string(in, strnlen(in, sizeof(in)));
+}
+
+} // namespace
+
+CommandRecorder::~CommandRecorder()
+{
+    close();
+}
+
+bool CommandRecorder::open(const std::string& path, const std::vector<std::string>& symbols, const command_log::SessionSchedule& schedule)
+{
+    for (const std::string& symbol : symbols)
+    {
+        if (symbol.size() >= command_log::kSymbolBytes)
+        {
+            std::cerr << "Cannot record symbol " << symbol << ": longer than " << command_log::kSymbolBytes - 1 << " characters.\n";
+            return false;
+        }
+    }
+
+    // O buffer precisa estar no lugar antes do open para o filebuf usá-lo
+    buffer_ = std::make_unique<char[]>(kBufferBytes);
+    file_.rdbuf()->pubsetbuf(buffer_.get(), static_cast<std::streamsize>(kBufferBytes));
+    file_.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file_.is_open())
+    {
+        std::cerr << "Failed to open command log file: " << path << "\n";
+        return false;
+    }
+
+    command_log::FileHeader header{};
+    std::memcpy(header.magic, command_log::kMagic, sizeof(header.magic));
+    header.version = command_log::kVersion;
+    header.symbol_count = static_cast<uint32_t>(symbols.size());
+    header.session_close_ns = toNanoseconds(schedule.session_close);
+    header.opening_auction_ns = toNanoseconds(schedule.opening_auction);
+    header.closing_auction_ns = toNanoseconds(schedule.closing_auction);
+    header.timer_start_ns = toNanoseconds(schedule.timer_start);
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const std::string& symbol : symbols)
+    {
+        char name[command_log::kSymbolBytes];
+        copySymbol(name, symbol);
+        file_.write(name, sizeof(name));
+    }
+    return static_cast<bool>(file_);
+}
+
+void CommandRecorder::recordBatch(const std::vector<std::unique_ptr<Command>>& batch, const std::chrono::system_clock::time_point& timer_now)
+{
+    if (!file_.is_open()) return;
+
+    // Lote sem comandos só importa se os timers andaram nele (expirações e leilões disparados pela espera limitada)
+    if (batch.empty() && timer_now == std::chrono::system_clock::time_point{}) return;
+
+    records_.clear();
+    for (const std::unique_ptr<Command>& command : batch)
+    {
+        command_log::CommandRecord record{};
+        if (const NewOrderCommand* newOrder = dynamic_cast<const NewOrderCommand*>(command.get()))
+        {
+            record.type = command_log::CommandRecord::NewOrder;
+            record.side = static_cast<uint8_t>(newOrder->getSide());
+            record.order_type = static_cast<uint8_t>(newOrder->getType());
+            record.time_in_force = static_cast<uint8_t>(newOrder->getTimeInForce());
+            record.capacity = static_cast<uint8_t>(newOrder->getCapacity());
+            copySymbol(record.symbol, newOrder->getSymbol());
+            record.quantity = newOrder->getQuantity();
+            record.client_id = newOrder->getClientId();
+            record.client_order_id = newOrder->getClientOrderId();
+            record.price = newOrder->getPrice();
+            record.stop_price = newOrder->getStopPrice();
+            record.trailing_offset = newOrder->getTrailingOffset();
+            record.received_ns = toNanoseconds(newOrder->getReceivedTimestamp());
+            record.expire_ns = toNanoseconds(newOrder->getExpireTime());
+        }
+        else if (const CancelOrderCommand* cancel = dynamic_cast<const CancelOrderCommand*>(command.get()))
+        {
+            record.type = command_log::CommandRecord::Cancel;
+            record.side = static_cast<uint8_t>(cancel->getSide());
+            copySymbol(record.symbol, cancel->getSymbol());
+            record.client_id = cancel->getClientId();
+            record.client_order_id = cancel->getClientOrderId();
+            record.orig_client_order_id = cancel->getOrigClientOrderId();
+            record.received_ns = toNanoseconds(cancel->getReceivedTimestamp());
+        }
+        else if (const AmendOrderCommand* amend = dynamic_cast<const AmendOrderCommand*>(command.get()))
+        {
+            record.type = command_log::CommandRecord::Amend;
+            record.side = static_cast<uint8_t>(amend->getSide());
+            copySymbol(record.symbol, amend->getSymbol());
+            record.quantity = amend->getNewQuantity();
+            record.client_id = amend->getClientId();
+            record.client_order_id = amend->getClientOrderId();
+            record.orig_client_order_id = amend->getOrigClientOrderId();
+            record.price = amend->getNewPrice();
+            record.received_ns = toNanoseconds(amend->getReceivedTimestamp());
+        }
+        else
+        {
+            std::cerr << "Command log: unknown command type skipped.\n";
+            continue;
+        }
+        records_.push_back(record);
+    }
+
+    command_log::BatchHeader header{};
+    header.count = static_cast<uint32_t>(records_.size());
+    header.timer_now_ns = toNanoseconds(timer_now);
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file_.write(reinterpret_cast<const char*>(records_.data()), static_cast<std::streamsize>(records_.size() * sizeof(command_log::CommandRecord)));
+
+    commands_recorded_ += records_.size();
+    ++batches_recorded_;
+}
+
+void CommandRecorder::close()
+{
+    if (!file_.is_open()) return;
+    file_.flush();
+    if (!file_) std::cerr << "Command log: write error, the recording is incomplete.\n";
+    file_.close();
+}
+
+bool CommandLogReader::open(const std::string& path)
+{
+    file_.open(path, std::ios::in | std::ios::binary);
+    if (!file_.is_open())
+    {
+        std::cerr << "Failed to open command log file: " << path << "\n";
+        return false;
+    }
+
+    command_log::FileHeader header{};
+    if (!file_.read(reinterpret_cast<char*>(&header), sizeof(header)) || std::memcmp(header.magic, command_log::kMagic, sizeof(header.magic)) != 0)
+    {
+        std::cerr << "Not a command log file: " << path << "\n";
+        return false;
+    }
+    if (header.version != command_log::kVersion)
+    {
+        std::cerr << "Unsupported command log version " << header.version << " in " << path << "\n";
+        return false;
+    }
+
+    symbols_.clear();
+    for (uint32_t i = 0; i < header.symbol_count; ++i)
+    {
+        char name[command_log::kSymbolBytes];
+        if (!file_.read(name, sizeof(name)))
+        {
+            std::cerr << "Truncated command log header: " << path << "\n";
+            return false;
+        }
+        symbols_.push_back(readSymbol(name));
+    }
+
+    schedule_.session_close = fromNanoseconds(header.session_close_ns);
+    schedule_.opening_auction = fromNanoseconds(header.opening_auction_ns);
+    schedule_.closing_auction = fromNanoseconds(header.closing_auction_ns);
+    schedule_.timer_start = fromNanoseconds(header.timer_start_ns);
+    return true;
+}
+
+bool CommandLogReader::nextBatch(std::vector<std::unique_ptr<Command>>& batch, std::chrono::system_clock::time_point& timer_now)
+{
+    batch.clear();
+    if (!file_.is_open() || truncated_) return false;
+
+    command_log::BatchHeader header{};
+    if (!file_.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        // Fim limpo só se nada do cabeçalho do lote foi lido
+        truncated_ = file_.gcount() != 0;
+        return false;
+    }
+
+    records_.resize(header.count);
+    if (!file_.read(reinterpret_cast<char*>(records_.data()), static_cast<std::streamsize>(records_.size() * sizeof(command_log::CommandRecord))))
+    {
+        truncated_ = true;
+        return false;
+    }
+
+    timer_now = fromNanoseconds(header.timer_now_ns);
+    for (const command_log::CommandRecord& record : records_)
+    {
+        const std::string symbol = readSymbol(record.symbol);
+        const OrderSide side = static_cast<OrderSide>(record.side);
+        const std::chrono::system_clock::time_point received = fromNanoseconds(record.received_ns);
+
+        if (record.type == command_log::CommandRecord::NewOrder)
+        {
+            std::unique_ptr<NewOrderCommand> command = std::make_unique<NewOrderCommand>(
+                record.client_order_id, record.client_id, symbol, side, static_cast<OrderType>(record.order_type), record.quantity,
+                record.price, static_cast<OrderTimeInForce>(record.time_in_force), static_cast<OrderCapacity>(record.capacity), received);
+            command->setStopParameters(record.stop_price, record.trailing_offset);
+            command->setExpireTime(fromNanoseconds(record.expire_ns));
+            batch.push_back(std::move(command));
+        }
+        else if (record.type == command_log::CommandRecord::Cancel)
+        {
+            batch.push_back(std::make_unique<CancelOrderCommand>(record.client_id, record.client_order_id, record.orig_client_order_id,
+                                                                 symbol, side, received));
+        }
+        else if (record.type == command_log::CommandRecord::Amend)
+        {
+            batch.push_back(std::make_unique<AmendOrderCommand>(record.client_id, record.client_order_id, record.orig_client_order_id,
+                                                                symbol, side, record.quantity, record.price, received));
+        }
+        else
+        {
+            std::cerr << "Corrupt command log: unknown record type " << static_cast<int>(record.type) << "\n";
+            truncated_ = true;
+            batch.clear();
+            return false;
+        }
+    }
+
+    ++batches_read_;
+    return true;
+}
@@ -1,15 +1,21 @@
 #include "messaging/commands/amend_order_command.hpp"
+#include "domain/engine.hpp"
 
-AmendOrderCommand::AmendOrderCommand(uint64_t order_id, uint32_t new_quantity, double new_price)
-    : order_id_(order_id), 
+AmendOrderCommand::AmendOrderCommand(uint64_t client_id, uint64_t client_order_id, uint64_t orig_client_order_id,
+                                     const std::string& symbol, OrderSide side, uint32_t new_quantity, double new_price,
+                                     const std::chrono::system_clock::time_point& received_timestamp)
+    : client_id_(client_id),
+      client_order_id_(client_order_id),
+      orig_client_order_id_(orig_client_order_id),
+      symbol_(symbol),
+      side_(side),
       new_quantity_(new_quantity), 
-      new_price_(new_price) 
+      new_price_(new_price),
+      received_timestamp_(received_timestamp)
 {
 }
 
 void AmendOrderCommand::execute(Engine& engine) 
 {
-    // Implementation of the execute method, which will interact with the MatchingEngine
-    // to process the amend order command.
-    // This is where the logic for modifying an existing order in the order book would go.
-}
\ No newline at end of file
+    engine.processAmendOrderCommand(*this);
+}
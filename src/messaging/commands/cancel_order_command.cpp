@@ -1,13 +1,18 @@
 #include "messaging/commands/cancel_order_command.hpp"
+#include "domain/engine.hpp"
 
-CancelOrderCommand::CancelOrderCommand(uint64_t order_id) 
-    : order_id_to_cancel_(order_id) 
+CancelOrderCommand::CancelOrderCommand(uint64_t client_id, uint64_t client_order_id, uint64_t orig_client_order_id,
+                                       const std::string& symbol, OrderSide side, const std::chrono::system_clock::time_point& received_timestamp) 
+    : client_id_(client_id),
+      client_order_id_(client_order_id),
+      orig_client_order_id_(orig_client_order_id),
+      symbol_(symbol),
+      side_(side),
+      received_timestamp_(received_timestamp)
 {
 }
 
 void CancelOrderCommand::execute(Engine& engine) 
 {
-    // Implementation of the execute method, which will interact with the MatchingEngine
-    // to process the cancel order command.
-    // This is where the logic for removing an order from the order book would go.
-}
\ No newline at end of file
+    engine.processCancelOrderCommand(*this);
+}
@@ -34,6 +34,9 @@ void NewOrderCommand::execute(Engine& engine)
         Order::getNextOrderId(), client_id_, client_order_id_,
         symbol_, price_, quantity_, side_, type_, tif_, capacity_, received_timestamp_
     );
+    order_ptr->setStopPrice(stop_price_);
+    order_ptr->setTrailingOffset(trailing_offset_);
+    order_ptr->setExpireTime(expire_time_);
 
     engine.processNewOrderCommand(order_ptr);
 }
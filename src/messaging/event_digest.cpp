@@ -0,0 +1,205 @@
+#include "messaging/event_digest.hpp"
+#include "messaging/events/bbo_event.hpp"
+#include "messaging/events/book_snapshot_event.hpp"
+#include "messaging/events/cancel_rejected_event.hpp"
+#include "messaging/events/order_accepted_event.hpp"
+#include "messaging/events/order_amended_event.hpp"
+#include "messaging/events/order_canceled_event.hpp"
+#include "messaging/events/order_rejected_event.hpp"
+#include "messaging/events/orders_expired_event.hpp"
+#include "messaging/events/stop_triggered_event.hpp"
+#include "messaging/events/trade_executed_event.hpp"
+#include <cstring>
+
+void EventDigest::putU32(uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) putByte(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+void EventDigest::putU64(uint64_t value)
+{
+    for (int i = 0; i < 8; ++i) putByte(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+void EventDigest::putDouble(double value)
+{
+    // Preços entram pelo padrão de bits: qualquer diferença de arredondamento aparece no checksum
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putU64(bits);
+}
+
+void EventDigest::putString(const std::string& value)
+{
+    putU32(static_cast<uint32_t>(value.size()));
+    record_.append(value);
+}
+
+void EventDigest::putString(const char* value)
+{
+    const size_t size = value ? std::strlen(value) : 0;
+    putU32(static_cast<uint32_t>(size));
+    record_.append(value ? value : "", size);
+}
+
+void EventDigest::add(const Event& event)
+{
+    record_.clear();
+
+    if (const TradeExecutedEvent* trade = std::get_if<TradeExecutedEvent>(&event))
+    {
+        putByte('T');
+        putU64(trade->getTradeId());
+        putString(trade->getSymbol());
+        putDouble(trade->getPrice());
+        putU32(trade->getQuantity());
+        putU64(trade->getAggressiveOrderId());
+        putU64(trade->getPassiveOrderId());
+        putByte(static_cast<uint8_t>(trade->getAggressiveOrderStatus()));
+        putByte(static_cast<uint8_t>(trade->getPassiveOrderStatus()));
+        putU32(trade->getAggressiveRemainingQuantity());
+        putU32(trade->getPassiveRemainingQuantity());
+        putU64(trade->getAggressiveClientId());
+        putU64(trade->getPassiveClientId());
+        putU64(trade->getAggressiveClientOrderId());
+        putU64(trade->getPassiveClientOrderId());
+        putByte(static_cast<uint8_t>(trade->getAggressiveSide()));
+        putByte(static_cast<uint8_t>(trade->getPassiveSide()));
+        putU32(trade->getAggressiveOrderQuantity());
+        putU32(trade->getPassiveOrderQuantity());
+    }
+    else if (const OrderAcceptedEvent* accepted = std::get_if<OrderAcceptedEvent>(&event))
+    {
+        putByte('A');
+        putU64(accepted->getOrderId());
+        putU64(accepted->getClientId());
+        putU64(accepted->getClientOrderId());
+        putString(accepted->getSymbol());
+        putByte(static_cast<uint8_t>(accepted->getSide()));
+        putU32(accepted->getQuantity());
+        putDouble(accepted->getPrice());
+    }
+    else if (const OrderCanceledEvent* canceled = std::get_if<OrderCanceledEvent>(&event))
+    {
+        putByte('C');
+        putU64(canceled->getOrderId());
+        putU64(canceled->getClientId());
+        putU64(canceled->getClientOrderId());
+        putU64(canceled->getOrigClientOrderId());
+        putString(canceled->getSymbol());
+        putByte(static_cast<uint8_t>(canceled->getSide()));
+        putDouble(canceled->getPrice());
+        putU32(canceled->getCanceledQuantity());
+        putU32(canceled->getFilledQuantity());
+    }
+    else if (const OrderAmendedEvent* amended = std::get_if<OrderAmendedEvent>(&event))
+    {
+        putByte('M');
+        putU64(amended->getOrderId());
+        putU64(amended->getClientId());
+        putU64(amended->getClientOrderId());
+        putU64(amended->getOrigClientOrderId());
+        putString(amended->getSymbol());
+        putByte(static_cast<uint8_t>(amended->getSide()));
+        putDouble(amended->getPrice());
+        putU32(amended->getQuantity());
+        putU32(amended->getRemainingQuantity());
+    }
+    else if (const CancelRejectedEvent* rejected = std::get_if<CancelRejectedEvent>(&event))
+    {
+        putByte('R');
+        putU64(rejected->getClientId());
+        putU64(rejected->getClientOrderId());
+        putU64(rejected->getOrigClientOrderId());
+        putString(rejected->getSymbol());
+        putByte(static_cast<uint8_t>(rejected->getResponseTo()));
+        putString(rejected->getReason());
+    }
+    else if (const OrderRejectedEvent* order_rejected = std::get_if<OrderRejectedEvent>(&event))
+    {
+        putByte('J');
+        putU64(order_rejected->getOrderId());
+        putU64(order_rejected->getClientId());
+        putU64(order_rejected->getClientOrderId());
+        putString(order_rejected->getSymbol());
+        putByte(static_cast<uint8_t>(order_rejected->getSide()));
+        putU32(order_rejected->getQuantity());
+        putDouble(order_rejected->getPrice());
+        putString(order_rejected->getReason());
+    }
+    else if (const StopTriggeredEvent* triggered = std::get_if<StopTriggeredEvent>(&event))
+    {
+        putByte('S');
+        putU64(triggered->getOrderId());
+        putU64(triggered->getClientId());
+        putU64(triggered->getClientOrderId());
+        putString(triggered->getSymbol());
+        putByte(static_cast<uint8_t>(triggered->getSide()));
+        putByte(static_cast<uint8_t>(triggered->getType()));
+        putDouble(triggered->getPrice());
+        putDouble(triggered->getStopPrice());
+        putDouble(triggered->getTriggerPrice());
+        putU32(triggered->getQuantity());
+    }
+    else if (const OrdersExpiredEvent* expired = std::get_if<OrdersExpiredEvent>(&event))
+    {
+        putByte('E');
+        putString(expired->getSymbol());
+        putU32(static_cast<uint32_t>(expired->getOrders().size()));
+        for (const ExpiredOrder& order : expired->getOrders())
+        {
+            putU64(order.order_id);
+            putU64(order.client_id);
+            putU64(order.client_order_id);
+            putByte(static_cast<uint8_t>(order.side));
+            putDouble(order.price);
+            putU32(order.expired_quantity);
+            putU32(order.filled_quantity);
+        }
+    }
+    else if (const BboEvent* bbo = std::get_if<BboEvent>(&event))
+    {
+        const TopOfBook& top = bbo->getTop();
+        putByte('B');
+        putString(bbo->getSymbol());
+        putU64(bbo->getSequence());
+        putDouble(top.bid_price);
+        putU64(top.bid_quantity);
+        putU32(top.bid_orders);
+        putDouble(top.ask_price);
+        putU64(top.ask_quantity);
+        putU32(top.ask_orders);
+    }
+    else if (const BookSnapshotEvent* snapshot = std::get_if<BookSnapshotEvent>(&event))
+    {
+        putByte('D');
+        putString(snapshot->getSymbol());
+        putU32(static_cast<uint32_t>(snapshot->getBids().size()));
+        for (const BookSnapshotEvent::PriceLevel& level : snapshot->getBids())
+        {
+            putDouble(level.price);
+            putU64(level.quantity);
+        }
+        putU32(static_cast<uint32_t>(snapshot->getAsks().size()));
+        for (const BookSnapshotEvent::PriceLevel& level : snapshot->getAsks())
+        {
+            putDouble(level.price);
+            putU64(level.quantity);
+        }
+    }
+    else
+    {
+        // Tipo novo ainda sem codificação: ao menos o nome entra no resumo
+        putByte('?');
+        putString(getEventName(event));
+    }
+
+    for (char byte : record_)
+    {
+        hash_ ^= static_cast<uint8_t>(byte);
+        hash_ *= kFnvPrime;
+    }
+    if (dump_) dump_->write(record_.data(), static_cast<std::streamsize>(record_.size()));
+    bytes_ += record_.size();
+    ++events_;
+}
@@ -8,8 +8,7 @@
 #include <random>
 
 // Static member initialization
-int FixGenerator::seqnum_ = 0;
-std::mutex FixGenerator::seq_mutex_;
+thread_local int FixGenerator::seqnum_ = 0;
 
 std::string FixGenerator::calculateChecksum(const std::string& msg) 
 {
@@ -29,7 +28,6 @@ std::pair<std::string, std::chrono::system_clock::time_point> FixGenerator::gene
     const std::string& symbol, int quantity, double price, int side, const std::string& msgType, 
     const std::string& targetCancelId, const std::string& ordType, const std::string& timeInForce, const std::string& orderCapacity)
 {
-    std::lock_guard<std::mutex> lock(seq_mutex_);
     seqnum_++;
     std::ostringstream oss;
 
@@ -54,6 +52,25 @@ std::pair<std::string, std::chrono::system_clock::time_point> FixGenerator::gene
             << "59=" << timeInForce << "|"
             << "47=" << orderCapacity << "|";
     }
+    else if (msgType == "F") {
+        // Order Cancel Request: 41 (OrigClOrdID) identifica a ordem original do cliente
+        oss << "35=F|"
+            << "11=" << seqnum_ << "|"
+            << "41=" << targetCancelId << "|"
+            << "55=" << symbol << "|"
+            << "54=" << side << "|";
+    }
+    else if (msgType == "G") {
+        // Order Cancel/Replace Request: nova quantidade total (38) e novo preço (44) para a ordem 41
+        oss << "35=G|"
+            << "11=" << seqnum_ << "|"
+            << "41=" << targetCancelId << "|"
+            << "55=" << symbol << "|"
+            << "54=" << side << "|"
+            << "38=" << quantity << "|"
+            << "44=" << std::fixed << std::setprecision(2) << price << "|"
+            << "40=" << ordType << "|";
+    }
 
     std::string body = oss.str();
     body += "10=" + calculateChecksum(body) + "|";
@@ -0,0 +1,255 @@
+#include "utils/load_generator.hpp"
+#include "utils/fix_generator.hpp"
+#include "messaging/commands/command.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+
+// Uma ordem que o cliente simulado ainda considera viva, usada para gerar cancels e amends
+struct LiveOrder
+{
+    int client_order_id;
+    size_t symbol_index;
+    int side;
+    double price;
+    uint32_t quantity;
+};
+
+constexpr size_t kMaxLiveOrders = 4096;
+
+std::vector<std::string> splitList(const std::string& value)
+{
+    std::vector<std::string> items;
+    std::stringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+} // namespace
+
+bool LoadGeneratorConfig::fromArgs(int argc, char** argv, LoadGeneratorConfig& config)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--load" || arg.rfind("--config=", 0) == 0) continue;
+
+        std::size_t eq = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos)
+        {
+            std::cerr << "Invalid load generator argument: " << arg << '\n';
+            return false;
+        }
+
+        std::string key = arg.substr(2, eq - 2);
+        std::string value = arg.substr(eq + 1);
+
+        try
+        {
+            if (key == "rate") config.target_rate = std::stod(value);
+            else if (key == "threads") config.threads = std::stoi(value);
+            else if (key == "duration") config.duration_seconds = std::stod(value);
+            else if (key == "symbols") config.symbols = splitList(value);
+            else if (key == "price-mid") config.price_mid = std::stod(value);
+            else if (key == "price-width") config.price_width = std::stod(value);
+            else if (key == "price-dist")
+            {
+                if (value == "uniform") config.price_distribution = PriceDistribution::Uniform;
+                else if (value == "normal") config.price_distribution = PriceDistribution::Normal;
+                else throw std::invalid_argument("price-dist must be uniform or normal");
+            }
+            else if (key == "size-dist")
+            {
+                if (value == "uniform") config.size_distribution = SizeDistribution::Uniform;
+                else if (value == "geometric") config.size_distribution = SizeDistribution::Geometric;
+                else throw std::invalid_argument("size-dist must be uniform or geometric");
+            }
+            else if (key == "min-qty") config.min_quantity = static_cast<uint32_t>(std::stoul(value));
+            else if (key == "max-qty") config.max_quantity = static_cast<uint32_t>(std::stoul(value));
+            else if (key == "market-ratio") config.market_order_ratio = std::stod(value);
+            else if (key == "cancel-ratio") config.cancel_ratio = std::stod(value);
+            else if (key == "amend-ratio") config.amend_ratio = std::stod(value);
+            else
+            {
+                std::cerr << "Unknown load generator option: --" << key << '\n';
+                return false;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Invalid value for --" << key << ": " << e.what() << '\n';
+            return false;
+        }
+    }
+
+    if (config.target_rate <= 0 || config.threads <= 0 || config.duration_seconds <= 0 || config.symbols.empty() ||
+        config.min_quantity == 0 || config.min_quantity > config.max_quantity ||
+        config.cancel_ratio + config.amend_ratio > 1.0)
+    {
+        std::cerr << "Inconsistent load generator configuration.\n";
+        return false;
+    }
+    return true;
+}
+
+void LoadGeneratorConfig::printUsage()
+{
+    std::cout << "Usage: orderbook --load [--config=FILE] [--rate=N] [--threads=N] [--duration=SECONDS] [--symbols=A,B,...]\n"
+              << "                 [--price-dist=normal|uniform] [--price-mid=P] [--price-width=W]\n"
+              << "                 [--size-dist=uniform|geometric] [--min-qty=N] [--max-qty=N]\n"
+              << "                 [--market-ratio=R] [--cancel-ratio=R] [--amend-ratio=R]\n";
+}
+
+LoadGenerator::LoadGenerator(InboundGateway& gateway, const LoadGeneratorConfig& config)
+    : gateway_(gateway), config_(config)
+{
+}
+
+LoadGeneratorReport LoadGenerator::run()
+{
+    std::vector<LoadGeneratorReport> thread_reports(config_.threads);
+    std::vector<std::thread> producers;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < config_.threads; ++i)
+    {
+        producers.emplace_back(&LoadGenerator::producerLoop, this, i, std::ref(thread_reports[i]));
+    }
+    for (std::thread& t : producers)
+    {
+        t.join();
+    }
+
+    LoadGeneratorReport report;
+    for (const LoadGeneratorReport& r : thread_reports)
+    {
+        report.messages_sent += r.messages_sent;
+        report.messages_rejected += r.messages_rejected;
+        report.new_orders += r.new_orders;
+        report.cancels += r.cancels;
+        report.amends += r.amends;
+        report.max_send_lag_ns = std::max(report.max_send_lag_ns, r.max_send_lag_ns);
+    }
+    report.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+void LoadGenerator::producerLoop(int thread_id, LoadGeneratorReport& report)
+{
+    if (thread_start_hook_) thread_start_hook_(thread_id);
+
+    std::mt19937_64 rng(std::random_device{}() ^ (static_cast<uint64_t>(thread_id) << 32));
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<size_t> symbol_dist(0, config_.symbols.size() - 1);
+    std::uniform_int_distribution<int> side_dist(1, 2);
+    std::normal_distribution<double> normal_price(config_.price_mid, config_.price_width);
+    std::uniform_real_distribution<double> uniform_price(config_.price_mid - config_.price_width, config_.price_mid + config_.price_width);
+    std::uniform_int_distribution<uint32_t> uniform_size(config_.min_quantity, config_.max_quantity);
+    std::geometric_distribution<uint32_t> geometric_size(1.0 / std::max(1.0, (config_.min_quantity + config_.max_quantity) / 2.0));
+
+    auto drawPrice = [&]() {
+        double price = config_.price_distribution == LoadGeneratorConfig::PriceDistribution::Normal ? normal_price(rng) : uniform_price(rng);
+        return std::max(0.01, std::round(price * 100.0) / 100.0);
+    };
+    auto drawSize = [&]() {
+        if (config_.size_distribution == LoadGeneratorConfig::SizeDistribution::Uniform) return uniform_size(rng);
+        return std::min(config_.max_quantity, config_.min_quantity + geometric_size(rng));
+    };
+
+    const std::string client_id = std::to_string(thread_id);
+    const double per_thread_rate = config_.target_rate / config_.threads;
+    const std::chrono::nanoseconds interval(static_cast<int64_t>(1e9 / per_thread_rate));
+    const uint64_t total_messages = static_cast<uint64_t>(config_.duration_seconds * per_thread_rate);
+
+    std::vector<LiveOrder> live_orders;
+    live_orders.reserve(kMaxLiveOrders);
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < total_messages; ++i)
+    {
+        // Pacing open-loop: o instante agendado não depende de quando a mensagem anterior terminou
+        const std::chrono::steady_clock::time_point intended = start + interval * i;
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (intended - now > std::chrono::microseconds(100))
+        {
+            std::this_thread::sleep_until(intended - std::chrono::microseconds(50));
+        }
+        while ((now = std::chrono::steady_clock::now()) < intended)
+        {
+            std::this_thread::yield();
+        }
+        uint64_t lag = std::chrono::duration_cast<std::chrono::nanoseconds>(now - intended).count();
+        report.max_send_lag_ns = std::max(report.max_send_lag_ns, lag);
+
+        double action = unit(rng);
+        std::pair<std::string, std::chrono::system_clock::time_point> message;
+        int client_order_id = FixGenerator::peekNextSeqNum();
+
+        if (!live_orders.empty() && action < config_.cancel_ratio)
+        {
+            std::uniform_int_distribution<size_t> pick(0, live_orders.size() - 1);
+            size_t index = pick(rng);
+            LiveOrder target = live_orders[index];
+            live_orders[index] = live_orders.back();
+            live_orders.pop_back();
+
+            message = FixGenerator::generateFIXMessage(config_.symbols[target.symbol_index], target.quantity, target.price,
+                                                       target.side, "F", std::to_string(target.client_order_id));
+            report.cancels++;
+        }
+        else if (!live_orders.empty() && action < config_.cancel_ratio + config_.amend_ratio)
+        {
+            std::uniform_int_distribution<size_t> pick(0, live_orders.size() - 1);
+            LiveOrder& target = live_orders[pick(rng)];
+            double new_price = drawPrice();
+            uint32_t new_quantity = drawSize();
+
+            message = FixGenerator::generateFIXMessage(config_.symbols[target.symbol_index], new_quantity, new_price,
+                                                       target.side, "G", std::to_string(target.client_order_id), "2");
+            // Depois do replace a ordem passa a ser identificada pelo novo ClOrdID
+            target.client_order_id = client_order_id;
+            target.price = new_price;
+            target.quantity = new_quantity;
+            report.amends++;
+        }
+        else
+        {
+            size_t symbol_index = symbol_dist(rng);
+            int side = side_dist(rng);
+            double price = drawPrice();
+            uint32_t quantity = drawSize();
+            bool is_market = unit(rng) < config_.market_order_ratio;
+
+            message = FixGenerator::generateFIXMessage(config_.symbols[symbol_index], quantity, price, side, "D", "",
+                                                       is_market ? "1" : "2", is_market ? "3" : "2");
+            if (!is_market)
+            {
+                if (live_orders.size() == kMaxLiveOrders) live_orders[i % kMaxLiveOrders] = {client_order_id, symbol_index, side, price, quantity};
+                else live_orders.push_back({client_order_id, symbol_index, side, price, quantity});
+            }
+            report.new_orders++;
+        }
+
+        std::unique_ptr<Command> command = gateway_.parseAndCreateCommand(message.first, client_id, message.second);
+        report.messages_sent++;
+        if (!command)
+        {
+            report.messages_rejected++;
+            continue;
+        }
+
+        command->setIntendedTimestamp(intended);
+        gateway_.pushToQueue(std::move(command));
+    }
+}
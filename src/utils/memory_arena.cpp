@@ -0,0 +1,221 @@
+#include "utils/memory_arena.hpp"
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+
+constexpr int kMpolBind = 2;    // MPOL_BIND de <linux/mempolicy.h>; chamamos mbind direto para não depender da libnuma
+
+size_t roundUp(size_t value, size_t multiple)
+{
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+size_t sizeClassIndex(size_t bytes)
+{
+    return (roundUp(bytes, MemoryArena::kSizeClassGranularity) / MemoryArena::kSizeClassGranularity) - 1;
+}
+
+bool hasMultipleNumaNodes()
+{
+    std::error_code ec;
+    return std::filesystem::exists("/sys/devices/system/node/node1", ec);
+}
+
+} // namespace
+
+MemoryArena::MemoryArena(const ArenaOptions& options)
+{
+    if (options.capacity_bytes == 0)
+    {
+        return;
+    }
+
+    const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    void* region = MAP_FAILED;
+    size_t length = 0;
+
+#ifdef MAP_HUGETLB
+    // Páginas de 2 MB explícitas só existem se o host reservou hugepages (vm.nr_hugepages)
+    if (options.use_hugepages)
+    {
+        length = roundUp(options.capacity_bytes, kHugePageSize);
+        region = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        huge_pages_ = region != MAP_FAILED;
+    }
+#endif
+
+    if (region == MAP_FAILED)
+    {
+        length = roundUp(options.capacity_bytes, options.use_hugepages ? kHugePageSize : page_size);
+        region = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region == MAP_FAILED)
+        {
+            std::cerr << "Failed to map memory arena of " << length << " bytes; falling back to the heap\n";
+            return;
+        }
+#ifdef MADV_HUGEPAGE
+        // Sem hugepages reservadas, pede ao kernel para montar a região com transparent hugepages
+        if (options.use_hugepages) madvise(region, length, MADV_HUGEPAGE);
+#endif
+    }
+
+    base_ = static_cast<char*>(region);
+    capacity_ = length;
+    numa_node_ = options.numa_node >= 0 ? options.numa_node : currentNumaNode();
+
+    // A política NUMA precisa estar definida antes do primeiro toque, que é quando a página física é escolhida
+    bindToNode(length);
+
+    if (options.prefault)
+    {
+        const size_t stride = huge_pages_ ? kHugePageSize : page_size;
+        for (size_t i = 0; i < length; i += stride)
+        {
+            base_[i] = 0;
+        }
+    }
+}
+
+MemoryArena::~MemoryArena()
+{
+    if (base_ != nullptr)
+    {
+        munmap(base_, capacity_);
+    }
+}
+
+void* MemoryArena::allocate(size_t bytes, size_t alignment)
+{
+    if (bytes == 0) bytes = 1;
+
+    if (bytes <= kMaxPooledSize && alignment <= kSizeClassGranularity)
+    {
+        FreeBlock*& head = free_lists_[sizeClassIndex(bytes)];
+        if (head != nullptr)
+        {
+            FreeBlock* block = head;
+            head = block->next;
+            return block;
+        }
+        void* pointer = bump(roundUp(bytes, kSizeClassGranularity), kSizeClassGranularity);
+        return pointer != nullptr ? pointer : heapAllocate(bytes, alignment);
+    }
+
+    // Blocos grandes (buckets de hash, mapas de deque, buffer do journal) são raros: first-fit basta
+    bytes = roundUp(bytes, kSizeClassGranularity);
+    for (FreeBlock** link = &large_free_; *link != nullptr; link = &(*link)->next)
+    {
+        FreeBlock* block = *link;
+        if (block->size >= bytes && reinterpret_cast<uintptr_t>(block) % alignment == 0)
+        {
+            *link = block->next;
+            return block;
+        }
+    }
+
+    void* pointer = bump(bytes, alignment);
+    return pointer != nullptr ? pointer : heapAllocate(bytes, alignment);
+}
+
+void MemoryArena::deallocate(void* pointer, size_t bytes, size_t alignment)
+{
+    if (pointer == nullptr) return;
+
+    if (!owns(pointer))
+    {
+        if (alignment > alignof(std::max_align_t)) ::operator delete(pointer, std::align_val_t(alignment));
+        else ::operator delete(pointer);
+        return;
+    }
+
+    if (bytes == 0) bytes = 1;
+    FreeBlock* block = static_cast<FreeBlock*>(pointer);
+    if (bytes <= kMaxPooledSize && alignment <= kSizeClassGranularity)
+    {
+        FreeBlock*& head = free_lists_[sizeClassIndex(bytes)];
+        block->next = head;
+        head = block;
+        return;
+    }
+
+    // O tamanho fica guardado no próprio bloco para o first-fit do allocate
+    block->size = roundUp(bytes, kSizeClassGranularity);
+    block->next = large_free_;
+    large_free_ = block;
+}
+
+void* MemoryArena::bump(size_t bytes, size_t alignment)
+{
+    if (base_ == nullptr) return nullptr;
+
+    size_t start = roundUp(offset_, alignment);
+    if (start + bytes > capacity_) return nullptr;
+
+    offset_ = start + bytes;
+    return base_ + start;
+}
+
+void* MemoryArena::heapAllocate(size_t bytes, size_t alignment)
+{
+    if (base_ != nullptr && heap_fallbacks_ == 0)
+    {
+        std::cerr << "Memory arena of " << capacity_ << " bytes exhausted; further allocations use the heap\n";
+    }
+    ++heap_fallbacks_;
+
+    if (alignment > alignof(std::max_align_t)) return ::operator new(bytes, std::align_val_t(alignment));
+    return ::operator new(bytes);
+}
+
+void MemoryArena::bindToNode(size_t length)
+{
+#ifdef SYS_mbind
+    // Num host com um único nó não há o que escolher
+    if (!hasMultipleNumaNodes() || numa_node_ < 0 || numa_node_ >= 64) return;
+
+    unsigned long node_mask = 1UL << numa_node_;
+    if (syscall(SYS_mbind, base_, length, kMpolBind, &node_mask, sizeof(node_mask) * 8, 0) != 0)
+    {
+        std::cerr << "Failed to bind memory arena to NUMA node " << numa_node_ << '\n';
+    }
+#else
+    (void)length;
+#endif
+}
+
+int MemoryArena::currentNumaNode()
+{
+#ifdef SYS_getcpu
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+    {
+        return static_cast<int>(node);
+    }
+#endif
+    return 0;
+}
+
+int MemoryArena::numaNodeOfCpu(int cpu)
+{
+    // Cada /sys/devices/system/cpu/cpuN tem um link 'nodeX' para o nó ao qual a CPU pertence
+    std::error_code ec;
+    std::filesystem::directory_iterator it("/sys/devices/system/cpu/cpu" + std::to_string(cpu), ec);
+    if (ec) return -1;
+
+    for (const std::filesystem::directory_entry& entry : it)
+    {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) == 0 && name.size() > 4 && name.find_first_not_of("0123456789", 4) == std::string::npos)
+        {
+            return std::stoi(name.substr(4));
+        }
+    }
+    return -1;
+}
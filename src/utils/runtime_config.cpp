@@ -0,0 +1,184 @@
+#include "utils/runtime_config.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+
+std::string trim(const std::string& text)
+{
+    std::size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return "";
+    std::size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+} // namespace
+
+std::string RuntimeConfig::resolvePath(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--config=", 0) == 0)
+        {
+            return arg.substr(9);
+        }
+    }
+
+    const char* env = std::getenv("ORDERBOOK_CONFIG");
+    return env != nullptr ? std::string(env) : std::string();
+}
+
+bool RuntimeConfig::loadFile(const std::string& path)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        std::cerr << "Could not open runtime config file: " << path << '\n';
+        return false;
+    }
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(in, line))
+    {
+        ++line_number;
+        std::size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        std::size_t eq = line.find('=');
+        if (eq == std::string::npos)
+        {
+            std::cerr << "Invalid runtime config line " << line_number << " in " << path << ": " << line << '\n';
+            return false;
+        }
+        values_[trim(line.substr(0, eq))] = trim(line.substr(eq + 1));
+    }
+    return true;
+}
+
+bool RuntimeConfig::has(const std::string& key) const
+{
+    std::map<std::string, std::string>::const_iterator it = values_.find(key);
+    return it != values_.end() && !it->second.empty();
+}
+
+std::string RuntimeConfig::getString(const std::string& key, const std::string& fallback) const
+{
+    std::map<std::string, std::string>::const_iterator it = values_.find(key);
+    if (it == values_.end() || it->second.empty()) return fallback;
+    return it->second;
+}
+
+int64_t RuntimeConfig::getInt(const std::string& key, int64_t fallback) const
+{
+    if (!has(key)) return fallback;
+
+    try
+    {
+        return std::stoll(values_.at(key));
+    }
+    catch (const std::exception&)
+    {
+        std::cerr << "Invalid integer for runtime config key " << key << ": " << values_.at(key) << '\n';
+        return fallback;
+    }
+}
+
+bool RuntimeConfig::getBool(const std::string& key, bool fallback) const
+{
+    std::string value = getString(key);
+    if (value.empty()) return fallback;
+    if (value == "true" || value == "1" || value == "yes") return true;
+    if (value == "false" || value == "0" || value == "no") return false;
+
+    std::cerr << "Invalid boolean for runtime config key " << key << ": " << value << '\n';
+    return fallback;
+}
+
+std::vector<int> RuntimeConfig::getCpuList(const std::string& key) const
+{
+    std::vector<int> cpus;
+    if (has(key) && !parseCpuList(values_.at(key), cpus))
+    {
+        std::cerr << "Invalid CPU list for runtime config key " << key << ": " << values_.at(key) << '\n';
+        cpus.clear();
+    }
+    return cpus;
+}
+
+std::vector<uint64_t> RuntimeConfig::getIdList(const std::string& key) const
+{
+    std::vector<uint64_t> ids;
+    std::stringstream ss(getString(key));
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        item = trim(item);
+        if (item.empty()) continue;
+        if (item.find_first_not_of("0123456789") != std::string::npos)
+        {
+            std::cerr << "Invalid id list for runtime config key " << key << ": " << values_.at(key) << '\n';
+            return {};
+        }
+        ids.push_back(std::stoull(item));
+    }
+    return ids;
+}
+
+WaitStrategy RuntimeConfig::getWaitStrategy(const std::string& prefix) const
+{
+    WaitStrategy strategy;
+    std::string kind = getString(prefix + ".wait");
+    if (!kind.empty() && !WaitStrategy::parse(kind, strategy.kind))
+    {
+        std::cerr << "Unknown wait strategy for " << prefix << ": " << kind << " (using blocking)\n";
+    }
+    strategy.spin_iterations = static_cast<uint32_t>(getInt(prefix + ".spin_iterations", strategy.spin_iterations));
+    return strategy;
+}
+
+ArenaOptions RuntimeConfig::getArenaOptions(const std::string& name, size_t default_kb, const std::vector<int>& owner_cpus) const
+{
+    ArenaOptions options;
+    int64_t kb = getInt("arena." + name + "_kb", static_cast<int64_t>(default_kb));
+    options.capacity_bytes = kb > 0 ? static_cast<size_t>(kb) * 1024 : 0;
+    options.use_hugepages = getBool("arena.hugepages", true);
+    options.prefault = getBool("arena.prefault", true);
+    options.numa_node = owner_cpus.empty() ? -1 : MemoryArena::numaNodeOfCpu(owner_cpus.front());
+    return options;
+}
+
+bool RuntimeConfig::parseCpuList(const std::string& text, std::vector<int>& cpus)
+{
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        item = trim(item);
+        if (item.empty()) continue;
+
+        try
+        {
+            std::size_t dash = item.find('-');
+            int first = std::stoi(item.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+            if (first < 0 || last < first) return false;
+            for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return true;
+}
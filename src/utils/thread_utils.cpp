@@ -0,0 +1,75 @@
+#include "utils/thread_utils.hpp"
+#include <iostream>
+#include <pthread.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace thread_utils
+{
+
+bool setCurrentThreadName(const std::string& name)
+{
+#ifdef __linux__
+    std::string truncated = name.substr(0, 15);
+    if (pthread_setname_np(pthread_self(), truncated.c_str()) != 0)
+    {
+        std::cerr << "Failed to set thread name " << truncated << '\n';
+        return false;
+    }
+    return true;
+#else
+    (void)name;
+    return false;
+#endif
+}
+
+bool pinCurrentThread(const std::vector<int>& cpus)
+{
+    if (cpus.empty())
+    {
+        return true;
+    }
+
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus)
+    {
+        if (cpu < 0 || cpu >= CPU_SETSIZE)
+        {
+            std::cerr << "Invalid CPU index " << cpu << " in affinity list\n";
+            return false;
+        }
+        CPU_SET(cpu, &set);
+    }
+
+    int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (rc != 0)
+    {
+        // Normalmente EINVAL: nenhuma das CPUs pedidas existe ou está no cpuset do processo
+        std::cerr << "Failed to pin thread to requested CPUs (error " << rc << ")\n";
+        return false;
+    }
+    return true;
+#else
+    std::cerr << "Thread affinity is not supported on this platform\n";
+    return false;
+#endif
+}
+
+void applyThreadRole(const std::string& name, const std::vector<int>& cpus)
+{
+    setCurrentThreadName(name);
+    if (!cpus.empty() && pinCurrentThread(cpus))
+    {
+        std::cout << "[" << name << "] pinned to CPU";
+        for (size_t i = 0; i < cpus.size(); ++i)
+        {
+            std::cout << (i == 0 ? " " : ",") << cpus[i];
+        }
+        std::cout << '\n';
+    }
+}
+
+} // namespace thread_utils